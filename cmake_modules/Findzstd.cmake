@@ -0,0 +1,68 @@
+#
+#  This file is part of openauto project.
+#  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+#
+#  openauto is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation; either version 3 of the License, or
+#  (at your option) any later version.
+
+#  openauto is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+#
+
+if (ZSTD_LIBRARIES AND ZSTD_INCLUDE_DIRS)
+  # in cache already
+  set(ZSTD_FOUND TRUE)
+else (ZSTD_LIBRARIES AND ZSTD_INCLUDE_DIRS)
+  find_path(ZSTD_INCLUDE_DIR
+    NAMES
+      zstd.h
+    PATHS
+      /usr/include
+      /usr/local/include
+      /opt/local/include
+      /sw/include
+  )
+
+  find_library(ZSTD_LIBRARY
+    NAMES
+      zstd libzstd
+    PATHS
+      /usr/lib
+      /usr/local/lib
+      /opt/local/lib
+      /sw/lib
+  )
+
+  set(ZSTD_INCLUDE_DIRS
+    ${ZSTD_INCLUDE_DIR}
+  )
+  set(ZSTD_LIBRARIES
+    ${ZSTD_LIBRARY}
+  )
+
+  if (ZSTD_INCLUDE_DIRS AND ZSTD_LIBRARIES)
+     set(ZSTD_FOUND TRUE)
+  endif (ZSTD_INCLUDE_DIRS AND ZSTD_LIBRARIES)
+
+  if (ZSTD_FOUND)
+    if (NOT zstd_FIND_QUIETLY)
+      message(STATUS "Found zstd:")
+          message(STATUS " - Includes: ${ZSTD_INCLUDE_DIRS}")
+          message(STATUS " - Libraries: ${ZSTD_LIBRARIES}")
+    endif (NOT zstd_FIND_QUIETLY)
+  else (ZSTD_FOUND)
+    if (zstd_FIND_REQUIRED)
+      message(FATAL_ERROR "Could not find zstd")
+    endif (zstd_FIND_REQUIRED)
+  endif (ZSTD_FOUND)
+
+    mark_as_advanced(ZSTD_INCLUDE_DIRS ZSTD_LIBRARIES)
+
+endif (ZSTD_LIBRARIES AND ZSTD_INCLUDE_DIRS)
@@ -20,7 +20,11 @@
 
 #include <boost/property_tree/ini_parser.hpp>
 #include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
+#include <QTimer>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <vector>
 #include <string>
 #include <fstream>
 #include <stdio.h>
@@ -38,10 +42,12 @@ class Configuration: public IConfiguration
 {
 public:
     Configuration();
+    ~Configuration() override;
 
     void load() override;
     void reset() override;
     void save() override;
+    void flush() override;
 
     bool hasTouchScreen() const override;
 
@@ -83,10 +89,16 @@ public:
     void showAutoPlay(bool value) override;
     bool instantPlay() const override;
     void instantPlay(bool value) override;
+    bool openGLRendering() const override;
+    void openGLRendering(bool value) override;
+    bool showFrameTimes() const override;
+    void showFrameTimes(bool value) override;
 
     QString getCSValue(QString searchString) const override;
     QString readFileContent(QString fileName) const override;
     QString getParamFromFile(QString fileName, QString searchString) const override;
+    FileStore::Pointer getFileStore() const override;
+    void addListener(IConfigurationListener::WeakPointer listener) override;
 
     aasdk::proto::enums::VideoFPS::Enum getVideoFPS() const override;
     void setVideoFPS(aasdk::proto::enums::VideoFPS::Enum value) override;
@@ -101,6 +113,22 @@ public:
 
     bool getTouchscreenEnabled() const override;
     void setTouchscreenEnabled(bool value) override;
+    TouchscreenBackendType getTouchscreenBackendType() const override;
+    void setTouchscreenBackendType(TouchscreenBackendType value) override;
+    std::string getTouchscreenDevice() const override;
+    void setTouchscreenDevice(const std::string& value) override;
+    uint32_t getTouchMoveRate() const override;
+    void setTouchMoveRate(uint32_t value) override;
+    std::string getControlDevices() const override;
+    void setControlDevices(const std::string& value) override;
+    std::string getRotaryGpioChip() const override;
+    void setRotaryGpioChip(const std::string& value) override;
+    uint32_t getRotaryGpioLineA() const override;
+    void setRotaryGpioLineA(uint32_t value) override;
+    uint32_t getRotaryGpioLineB() const override;
+    void setRotaryGpioLineB(uint32_t value) override;
+    bool rotaryAccelerationEnabled() const override;
+    void setRotaryAccelerationEnabled(bool value) override;
     bool playerButtonControl() const override;
     void playerButtonControl(bool value) override;
     ButtonCodes getButtonCodes() const override;
@@ -118,10 +146,30 @@ public:
     AudioOutputBackendType getAudioOutputBackendType() const override;
     void setAudioOutputBackendType(AudioOutputBackendType value) override;
 
+    TraceMode getTraceMode() const override;
+    void setTraceMode(TraceMode value) override;
+    std::string getTraceDirectory() const override;
+    void setTraceDirectory(const std::string& value) override;
+    bool traceCompressionEnabled() const override;
+    void setTraceCompressionEnabled(bool value) override;
+    size_t getTraceRingSize() const override;
+    void setTraceRingSize(size_t value) override;
+
 private:
-    void readButtonCodes(boost::property_tree::ptree& iniConfig);
-    void insertButtonCode(boost::property_tree::ptree& iniConfig, const std::string& buttonCodeKey, aasdk::proto::enums::ButtonCode::Enum buttonCode);
+    typedef std::map<std::string, std::string> Snapshot;
+
+    void applyConfig(const boost::property_tree::ptree& iniConfig);
+    void writeConfig(boost::property_tree::ptree& iniConfig);
+    void updateSnapshot(const boost::property_tree::ptree& iniConfig);
+    void onConfigFileChanged();
+    static bool isSessionKey(const std::string& key);
+    void readButtonCodes(const boost::property_tree::ptree& iniConfig);
+    void insertButtonCode(const boost::property_tree::ptree& iniConfig, const std::string& buttonCodeKey, aasdk::proto::enums::ButtonCode::Enum buttonCode);
     void writeButtonCodes(boost::property_tree::ptree& iniConfig);
+    void readConfigFile(boost::property_tree::ptree& iniConfig);
+    void persist();
+    static std::string readSnapshot(const std::string& fileName, boost::property_tree::ptree& iniConfig, bool requireVersion);
+    static bool writeFileAtomically(const std::string& fileName, const std::string& content);
 
     HandednessOfTrafficType handednessOfTrafficType_;
     bool showClock_;
@@ -142,6 +190,8 @@ private:
     bool mp3AutoPlay_;
     bool showAutoPlay_;
     bool instantPlay_;
+    bool openGLRendering_;
+    bool showFrameTimes_;
 
     aasdk::proto::enums::VideoFPS::Enum videoFPS_;
     aasdk::proto::enums::VideoResolution::Enum videoResolution_;
@@ -149,6 +199,14 @@ private:
     int32_t omxLayerIndex_;
     QRect videoMargins_;
     bool enableTouchscreen_;
+    TouchscreenBackendType touchscreenBackendType_;
+    std::string touchscreenDevice_;
+    uint32_t touchMoveRate_;
+    std::string controlDevices_;
+    std::string rotaryGpioChip_;
+    uint32_t rotaryGpioLineA_;
+    uint32_t rotaryGpioLineB_;
+    bool rotaryAccelerationEnabled_;
     bool enablePlayerControl_;
     ButtonCodes buttonCodes_;
     BluetoothAdapterType bluetoothAdapterType_;
@@ -156,8 +214,30 @@ private:
     bool musicAudioChannelEnabled_;
     bool speechAudiochannelEnabled_;
     AudioOutputBackendType audioOutputBackendType_;
+    TraceMode traceMode_;
+    std::string traceDirectory_;
+    bool traceCompressionEnabled_;
+    size_t traceRingSize_;
+
+    FileStore::Pointer fileStore_;
+
+    std::mutex persistMutex_;
+    QTimer saveTimer_;
+    std::string persistedContent_;
+    std::string pendingContent_;
+
+    std::mutex changeMutex_;
+    Snapshot snapshot_;
+    std::vector<IConfigurationListener::WeakPointer> listeners_;
 
     static const std::string cConfigFileName;
+    static const std::string cConfigBackupFileName;
+    static const uint32_t cConfigVersion;
+    static const int cSaveDelayMs;
+
+    static const std::string cMetaVersionKey;
+    static const std::string cCSEnvFileName;
+    static const std::string cCSDefaultEnvFileName;
 
     static const std::string cGeneralShowClockKey;
 
@@ -180,6 +260,8 @@ private:
     static const std::string cGeneralMp3AutoPlayKey;
     static const std::string cGeneralShowAutoPlayKey;
     static const std::string cGeneralInstantPlayKey;
+    static const std::string cGeneralOpenGLRenderingKey;
+    static const std::string cGeneralShowFrameTimesKey;
 
     static const std::string cVideoFPSKey;
     static const std::string cVideoResolutionKey;
@@ -192,10 +274,23 @@ private:
     static const std::string cAudioSpeechAudioChannelEnabled;
     static const std::string cAudioOutputBackendType;
 
+    static const std::string cTraceModeKey;
+    static const std::string cTraceDirectoryKey;
+    static const std::string cTraceCompressionEnabledKey;
+    static const std::string cTraceRingSizeKey;
+
     static const std::string cBluetoothAdapterTypeKey;
     static const std::string cBluetoothRemoteAdapterAddressKey;
 
     static const std::string cInputEnableTouchscreenKey;
+    static const std::string cInputTouchscreenBackendKey;
+    static const std::string cInputTouchscreenDeviceKey;
+    static const std::string cInputTouchMoveRateKey;
+    static const std::string cInputControlDevicesKey;
+    static const std::string cInputRotaryGpioChipKey;
+    static const std::string cInputRotaryGpioLineAKey;
+    static const std::string cInputRotaryGpioLineBKey;
+    static const std::string cInputRotaryAccelerationKey;
     static const std::string cInputEnablePlayerControlKey;
     static const std::string cInputPlayButtonKey;
     static const std::string cInputPauseButtonKey;
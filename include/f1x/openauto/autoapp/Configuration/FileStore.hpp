@@ -0,0 +1,100 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <QObject>
+#include <QString>
+#include <QDateTime>
+#include <QFileSystemWatcher>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace configuration
+{
+
+// In-memory cache of the small system files read by the UI and services (/tmp flags, hostapd.conf, volume...).
+// Files are loaded on first access and re-read only after an inotify notification, so repeated reads are
+// served from memory. Files under /proc and /sys do not deliver inotify events and are always re-read.
+// "key=value" files (crankshaft_env.sh, hostapd.conf, config.txt...) are parsed once per load.
+class FileStore: public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef std::shared_ptr<FileStore> Pointer;
+
+    FileStore(QObject* parent = nullptr);
+
+    bool exists(const QString& fileName);
+    QString readContent(const QString& fileName);
+    bool findParam(const QString& fileName, const std::string& searchString, QString& value);
+
+signals:
+    void fileChanged(const QString& fileName);
+
+private slots:
+    void onFileChanged(const QString& fileName);
+    void onDirectoryChanged(const QString& directory);
+    void watch(const QString& fileName);
+
+private:
+    struct Entry
+    {
+        Entry(const QString& fileName);
+
+        void refresh(bool force);
+        void parse();
+        bool find(const std::string& searchString, QString& value) const;
+
+        std::string fileName;
+        QDateTime lastModified;
+        qint64 size;
+        std::string content;
+        std::vector<std::string> lines;
+        std::unordered_map<std::string, std::string> values;
+        bool exists;
+        bool valid;
+        bool watched;
+        // set by the watcher, the next read re-reads the file whatever its modification time says
+        bool changed;
+    };
+
+    Entry& getEntry(const QString& fileName);
+    void addWatch(const QString& fileName, Entry& entry);
+    static bool isVolatile(const QString& fileName);
+
+    std::mutex mutex_;
+    std::map<QString, Entry> entries_;
+    QFileSystemWatcher watcher_;
+};
+
+}
+}
+}
+}
@@ -26,6 +26,10 @@
 #include <f1x/openauto/autoapp/Configuration/BluetootAdapterType.hpp>
 #include <f1x/openauto/autoapp/Configuration/HandednessOfTrafficType.hpp>
 #include <f1x/openauto/autoapp/Configuration/AudioOutputBackendType.hpp>
+#include <f1x/openauto/autoapp/Configuration/TraceMode.hpp>
+#include <f1x/openauto/autoapp/Configuration/TouchscreenBackendType.hpp>
+#include <f1x/openauto/autoapp/Configuration/FileStore.hpp>
+#include <f1x/openauto/autoapp/Configuration/IConfigurationListener.hpp>
 
 namespace f1x
 {
@@ -47,6 +51,7 @@ public:
     virtual void load() = 0;
     virtual void reset() = 0;
     virtual void save() = 0;
+    virtual void flush() = 0;
 
     virtual bool hasTouchScreen() const = 0;
 
@@ -87,10 +92,16 @@ public:
     virtual void showAutoPlay(bool value) = 0;
     virtual bool instantPlay() const = 0;
     virtual void instantPlay(bool value) = 0;
+    virtual bool openGLRendering() const = 0;
+    virtual void openGLRendering(bool value) = 0;
+    virtual bool showFrameTimes() const = 0;
+    virtual void showFrameTimes(bool value) = 0;
 
     virtual QString getCSValue(QString searchString) const = 0;
     virtual QString readFileContent(QString fileName) const = 0;
     virtual QString getParamFromFile(QString fileName, QString searchString) const = 0;
+    virtual FileStore::Pointer getFileStore() const = 0;
+    virtual void addListener(IConfigurationListener::WeakPointer listener) = 0;
 
     virtual aasdk::proto::enums::VideoFPS::Enum getVideoFPS() const = 0;
     virtual void setVideoFPS(aasdk::proto::enums::VideoFPS::Enum value) = 0;
@@ -105,6 +116,22 @@ public:
 
     virtual bool getTouchscreenEnabled() const = 0;
     virtual void setTouchscreenEnabled(bool value) = 0;
+    virtual TouchscreenBackendType getTouchscreenBackendType() const = 0;
+    virtual void setTouchscreenBackendType(TouchscreenBackendType value) = 0;
+    virtual std::string getTouchscreenDevice() const = 0;
+    virtual void setTouchscreenDevice(const std::string& value) = 0;
+    virtual uint32_t getTouchMoveRate() const = 0;
+    virtual void setTouchMoveRate(uint32_t value) = 0;
+    virtual std::string getControlDevices() const = 0;
+    virtual void setControlDevices(const std::string& value) = 0;
+    virtual std::string getRotaryGpioChip() const = 0;
+    virtual void setRotaryGpioChip(const std::string& value) = 0;
+    virtual uint32_t getRotaryGpioLineA() const = 0;
+    virtual void setRotaryGpioLineA(uint32_t value) = 0;
+    virtual uint32_t getRotaryGpioLineB() const = 0;
+    virtual void setRotaryGpioLineB(uint32_t value) = 0;
+    virtual bool rotaryAccelerationEnabled() const = 0;
+    virtual void setRotaryAccelerationEnabled(bool value) = 0;
     virtual bool playerButtonControl() const = 0;
     virtual void playerButtonControl(bool value) = 0;
     virtual ButtonCodes getButtonCodes() const = 0;
@@ -121,6 +148,15 @@ public:
     virtual void setSpeechAudioChannelEnabled(bool value) = 0;
     virtual AudioOutputBackendType getAudioOutputBackendType() const = 0;
     virtual void setAudioOutputBackendType(AudioOutputBackendType value) = 0;
+
+    virtual TraceMode getTraceMode() const = 0;
+    virtual void setTraceMode(TraceMode value) = 0;
+    virtual std::string getTraceDirectory() const = 0;
+    virtual void setTraceDirectory(const std::string& value) = 0;
+    virtual bool traceCompressionEnabled() const = 0;
+    virtual void setTraceCompressionEnabled(bool value) = 0;
+    virtual size_t getTraceRingSize() const = 0;
+    virtual void setTraceRingSize(size_t value) = 0;
 };
 
 }
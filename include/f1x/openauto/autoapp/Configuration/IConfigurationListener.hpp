@@ -0,0 +1,56 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace configuration
+{
+
+struct ConfigurationChange
+{
+    // keys (e.g. "Input.EnableTouchscreen") which the running session picks up immediately
+    std::set<std::string> liveKeys;
+    // keys read when the session is built, their new values apply on the next session
+    std::set<std::string> sessionKeys;
+};
+
+class IConfigurationListener
+{
+public:
+    typedef std::shared_ptr<IConfigurationListener> Pointer;
+    typedef std::weak_ptr<IConfigurationListener> WeakPointer;
+
+    virtual ~IConfigurationListener() = default;
+
+    virtual void onConfigurationChanged(const ConfigurationChange& change) = 0;
+};
+
+}
+}
+}
+}
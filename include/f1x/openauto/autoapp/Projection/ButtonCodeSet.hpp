@@ -0,0 +1,54 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <bitset>
+#include <f1x/openauto/autoapp/Projection/IInputDevice.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+// Membership test for button codes without searching the configured vector.
+// Codes live in two dense ranges: key codes below 0x100 and the extended codes from 0x10000.
+class ButtonCodeSet
+{
+public:
+    ButtonCodeSet() = default;
+    explicit ButtonCodeSet(const IInputDevice::ButtonCodes& buttonCodes);
+
+    void insert(aasdk::proto::enums::ButtonCode::Enum buttonCode);
+    bool contains(aasdk::proto::enums::ButtonCode::Enum buttonCode) const;
+
+private:
+    static int getIndex(aasdk::proto::enums::ButtonCode::Enum buttonCode);
+
+    static constexpr size_t cRangeSize = 0x100;
+    std::bitset<cRangeSize * 2> bits_;
+};
+
+}
+}
+}
+}
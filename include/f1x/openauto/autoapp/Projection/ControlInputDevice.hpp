@@ -0,0 +1,118 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <linux/input.h>
+#include <boost/asio.hpp>
+#include <boost/noncopyable.hpp>
+#include <f1x/openauto/autoapp/Projection/IInputDevice.hpp>
+#include <f1x/openauto/autoapp/Projection/IInputDeviceEventHandler.hpp>
+#include <f1x/openauto/autoapp/Projection/ButtonCodeSet.hpp>
+#ifdef USE_GPIO_ROTARY
+#include <f1x/openauto/autoapp/Projection/GpioRotaryEncoder.hpp>
+#endif
+#include <f1x/openauto/autoapp/Projection/KeyMap.hpp>
+#include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+// Steering wheel buttons and rotary knobs read on the io_service, next to the buttons and
+// touches of the wrapped device. Keys of the evdev nodes go through the [Evdev] keymap section,
+// REL_DIAL/REL_WHEEL and the GPIO encoder turn the scroll wheel, accelerated on fast spins.
+class ControlInputDevice:
+        public IInputDevice,
+        public IInputDeviceEventHandler,
+        public std::enable_shared_from_this<ControlInputDevice>,
+        boost::noncopyable
+{
+public:
+    ControlInputDevice(boost::asio::io_service& ioService, configuration::IConfiguration::Pointer configuration, KeyMap::Pointer keyMap, IInputDevice::Pointer inputDevice);
+
+    void start(IInputDeviceEventHandler& eventHandler) override;
+    void stop() override;
+    ButtonCodes getSupportedButtonCodes() const override;
+    bool hasTouchscreen() const override;
+    QRect getTouchscreenGeometry() const override;
+
+    void onButtonEvent(const ButtonEvent& event) override;
+    void onTouchEvent(const TouchEvent& event) override;
+
+private:
+    using std::enable_shared_from_this<ControlInputDevice>::shared_from_this;
+
+    struct EvdevSource
+    {
+        explicit EvdevSource(boost::asio::io_service& ioService);
+
+        boost::asio::posix::stream_descriptor descriptor;
+        std::array<input_event, 16> events;
+        // keys reported as down, compared with the device after a drop
+        std::bitset<KEY_CNT> keys;
+        // REL_DIAL/REL_WHEEL movement of the report being read
+        int32_t relativeDelta;
+        bool dropped;
+    };
+
+    void open();
+    void openEvdevSource(const std::string& devicePath);
+    void read(EvdevSource& source);
+    void handleEvents(EvdevSource& source, size_t count);
+    void readKeys(EvdevSource& source, const input_event& report);
+    void handleKey(const input_event& event);
+    void turnWheel(int32_t steps, std::chrono::steady_clock::time_point eventTime);
+    void dispatch(const ButtonEvent& event);
+
+    boost::asio::io_service& ioService_;
+    boost::asio::io_service::strand strand_;
+    configuration::IConfiguration::Pointer configuration_;
+    KeyMap::Pointer keyMap_;
+    IInputDevice::Pointer inputDevice_;
+    ButtonCodeSet buttonCodes_;
+    bool accelerationEnabled_;
+    std::vector<std::unique_ptr<EvdevSource>> evdevSources_;
+#ifdef USE_GPIO_ROTARY
+    GpioRotaryEncoder::Pointer rotaryEncoder_;
+#endif
+
+    std::chrono::steady_clock::time_point lastWheelTime_;
+
+    std::mutex mutex_;
+    IInputDeviceEventHandler* eventHandler_;
+
+    static constexpr std::chrono::milliseconds cAccelerationInterval{50};
+    static constexpr int32_t cMaxAcceleration = 4;
+};
+
+}
+}
+}
+}
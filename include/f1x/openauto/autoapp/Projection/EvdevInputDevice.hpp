@@ -0,0 +1,100 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <vector>
+#include <mutex>
+#include <linux/input.h>
+#include <boost/asio.hpp>
+#include <boost/noncopyable.hpp>
+#include <f1x/openauto/autoapp/Projection/IInputDevice.hpp>
+#include <f1x/openauto/autoapp/Projection/IInputDeviceEventHandler.hpp>
+#include <f1x/openauto/autoapp/Projection/EvdevTouchState.hpp>
+#include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+// Reads the touchscreen straight from its evdev node on the io_service, so touches reach
+// InputService without going through the Qt event loop. Multi-touch panels are read with the
+// slot protocol (B), others as a single pointer. Buttons still come from buttonDevice, touch
+// events synthesized by Qt are dropped.
+class EvdevInputDevice:
+        public IInputDevice,
+        public IInputDeviceEventHandler,
+        public std::enable_shared_from_this<EvdevInputDevice>,
+        boost::noncopyable
+{
+public:
+    EvdevInputDevice(boost::asio::io_service& ioService, configuration::IConfiguration::Pointer configuration, IInputDevice::Pointer buttonDevice,
+                     const QRect& touchscreenGeometry, const QRect& videoGeometry);
+
+    void start(IInputDeviceEventHandler& eventHandler) override;
+    void stop() override;
+    ButtonCodes getSupportedButtonCodes() const override;
+    bool hasTouchscreen() const override;
+    QRect getTouchscreenGeometry() const override;
+
+    void onButtonEvent(const ButtonEvent& event) override;
+    void onTouchEvent(const TouchEvent& event) override;
+
+    static std::string findTouchscreen();
+    static bool useMonotonicClock(int fd);
+    static bool readKeys(int fd, std::bitset<KEY_CNT>& keys);
+    static std::chrono::steady_clock::time_point getEventTime(const input_event& event);
+
+private:
+    using std::enable_shared_from_this<EvdevInputDevice>::shared_from_this;
+
+    bool open(const std::string& devicePath);
+    EvdevTouchState::Axis createAxis(int fd, int code, int size) const;
+    void readState(int fd);
+    void read();
+    void handleEvents(size_t count);
+    void sendTouchEvents(std::vector<TouchEvent> events, std::chrono::steady_clock::time_point eventTime);
+
+    boost::asio::io_service::strand strand_;
+    boost::asio::posix::stream_descriptor descriptor_;
+    configuration::IConfiguration::Pointer configuration_;
+    IInputDevice::Pointer buttonDevice_;
+    QRect touchscreenGeometry_;
+    QRect videoGeometry_;
+
+    std::mutex mutex_;
+    IInputDeviceEventHandler* eventHandler_;
+
+    std::array<input_event, 64> events_;
+    EvdevTouchState touchState_;
+
+    static constexpr size_t cMaxSlots = 10;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,98 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <vector>
+#include <linux/input.h>
+#include <f1x/openauto/autoapp/Projection/InputEvent.hpp>
+#include <f1x/openauto/autoapp/Projection/TouchTracker.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+// Contacts of an evdev touchscreen, read with the slot protocol (B) on multi-touch panels and
+// as a single pointer otherwise. Events are applied as they are read, report() turns the changes
+// since the previous report into touch events. The contacts can also be set from the device state
+// read with ioctls, which is how EvdevInputDevice picks up fingers already down when it opens and
+// catches up after the kernel dropped events.
+class EvdevTouchState
+{
+public:
+    // device units to video coordinates, computed once from the axis ranges
+    struct Axis
+    {
+        float scale;
+        float offset;
+        int32_t limit;
+
+        uint32_t map(int32_t value) const;
+    };
+
+    enum class Result
+    {
+        NONE,
+        // a report is complete, report() returns its touch events
+        REPORT,
+        // the report after SYN_DROPPED, load the device state before calling report()
+        RESYNC
+    };
+
+    EvdevTouchState();
+
+    void reset(bool multitouch, size_t slotCount, const Axis& axisX, const Axis& axisY);
+    bool isMultitouch() const;
+    size_t getSlotCount() const;
+
+    Result handleEvent(const input_event& event);
+    std::vector<TouchEvent> report();
+
+    void setCurrentSlot(size_t slot);
+    void setContact(size_t slot, int32_t trackingId, int32_t x, int32_t y);
+
+private:
+    struct Slot
+    {
+        int32_t trackingId;
+        // tracking id of the contact reported as down
+        int32_t activeId;
+        int32_t x;
+        int32_t y;
+        bool changed;
+        bool down;
+    };
+
+    Axis axisX_;
+    Axis axisY_;
+    bool multitouch_;
+    std::vector<Slot> slots_;
+    size_t slot_;
+    bool dropped_;
+    TouchTracker tracker_;
+};
+
+}
+}
+}
+}
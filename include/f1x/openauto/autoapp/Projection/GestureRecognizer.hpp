@@ -0,0 +1,116 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <boost/noncopyable.hpp>
+#include <f1x/openauto/autoapp/Projection/InputEvent.hpp>
+#include <f1x/openauto/autoapp/Projection/KeyMap.hpp>
+#include <f1x/openauto/autoapp/Projection/TimerWheel.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+// Long presses, double presses and chords of the [Gestures] keymap section, recognized from plain
+// PRESS/RELEASE events. Buttons without gestures pass straight through. The owner feeds events and
+// turns the timer wheel from one strand; nothing is allocated once the recognizer is built.
+class GestureRecognizer: boost::noncopyable
+{
+public:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+    typedef std::function<void(const ButtonEvent&)> EventHandler;
+
+    GestureRecognizer(KeyMap::Pointer keyMap, EventHandler eventHandler);
+
+    void onButtonEvent(const ButtonEvent& event, TimePoint now);
+    void advance(TimePoint now);
+    bool isIdle() const;
+    TimePoint getNextTick() const;
+    void reset();
+
+    static constexpr std::chrono::milliseconds cTick{10};
+
+private:
+    enum class State
+    {
+        IDLE,
+        CHORD_WAIT,
+        PRESSED,
+        LONG_PRESSED,
+        RELEASED,
+        SECOND_PRESSED,
+        PASSED,
+        CHORD_PRESSED,
+        CHORD_RELEASED
+    };
+
+    struct Button
+    {
+        aasdk::proto::enums::ButtonCode::Enum code;
+        aasdk::proto::enums::ButtonCode::Enum longPressCode;
+        aasdk::proto::enums::ButtonCode::Enum doublePressCode;
+        bool chordMember;
+        State state;
+        size_t chord;
+        TimePoint pressTime;
+    };
+
+    struct Chord
+    {
+        size_t first;
+        size_t second;
+        aasdk::proto::enums::ButtonCode::Enum code;
+    };
+
+    static constexpr size_t cMaxChords = 16;
+    static constexpr size_t cInvalidIndex = static_cast<size_t>(-1);
+
+    size_t findButton(aasdk::proto::enums::ButtonCode::Enum code) const;
+    size_t addButton(aasdk::proto::enums::ButtonCode::Enum code);
+    size_t getTicks(uint32_t milliseconds) const;
+    void schedule(size_t index, uint32_t milliseconds, TimePoint now);
+    void handlePress(size_t index, TimePoint eventTime, TimePoint now);
+    void handleRelease(size_t index, TimePoint eventTime, TimePoint now);
+    void beginPress(size_t index, TimePoint eventTime, TimePoint now);
+    void onTimeout(size_t index, TimePoint now);
+    void dispatch(ButtonEventType type, aasdk::proto::enums::ButtonCode::Enum code, TimePoint eventTime, bool longPress = false);
+    void tap(aasdk::proto::enums::ButtonCode::Enum code, TimePoint eventTime);
+
+    KeyMap::Pointer keyMap_;
+    EventHandler eventHandler_;
+    TimerWheel timerWheel_;
+    TimePoint cursorTime_;
+    std::array<Button, TimerWheel::cCapacity> buttons_;
+    size_t buttonCount_;
+    std::array<Chord, cMaxChords> chords_;
+    size_t chordCount_;
+};
+
+}
+}
+}
+}
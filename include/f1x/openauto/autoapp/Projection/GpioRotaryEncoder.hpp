@@ -0,0 +1,72 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <linux/gpio.h>
+#include <boost/asio.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+// Quadrature rotary encoder on two GPIO lines, read through the GPIO character device (v2 uAPI).
+// Both lines are requested together so their edges arrive in order on one descriptor.
+class GpioRotaryEncoder: public std::enable_shared_from_this<GpioRotaryEncoder>, boost::noncopyable
+{
+public:
+    typedef std::shared_ptr<GpioRotaryEncoder> Pointer;
+    // detents turned since the previous call, positive clockwise, and the time of the last edge
+    typedef std::function<void(int32_t, std::chrono::steady_clock::time_point)> StepHandler;
+
+    GpioRotaryEncoder(boost::asio::io_service& ioService, boost::asio::io_service::strand& strand, StepHandler stepHandler);
+
+    bool open(const std::string& chipPath, uint32_t lineA, uint32_t lineB);
+    void close();
+
+private:
+    using std::enable_shared_from_this<GpioRotaryEncoder>::shared_from_this;
+
+    void read();
+    void handleEvent(const gpio_v2_line_event& event);
+
+    boost::asio::io_service::strand& strand_;
+    boost::asio::posix::stream_descriptor descriptor_;
+    StepHandler stepHandler_;
+    std::array<gpio_v2_line_event, 16> events_;
+    uint32_t lineA_;
+    uint32_t lineB_;
+    uint8_t state_;
+    int32_t transitions_;
+
+    static constexpr int32_t cTransitionsPerDetent = 4;
+};
+
+}
+}
+}
+}
@@ -19,8 +19,13 @@
 #pragma once
 
 #include <QObject>
+#include <QPointer>
 #include <QKeyEvent>
+#include <QTouchEvent>
 #include <f1x/openauto/autoapp/Projection/IInputDevice.hpp>
+#include <f1x/openauto/autoapp/Projection/TouchTracker.hpp>
+#include <f1x/openauto/autoapp/Projection/ButtonCodeSet.hpp>
+#include <f1x/openauto/autoapp/Projection/KeyMap.hpp>
 #include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
 
 namespace f1x
@@ -32,12 +37,12 @@ namespace autoapp
 namespace projection
 {
 
-class InputDevice: public QObject, public IInputDevice, boost::noncopyable
+class InputDevice: public QObject, public IInputDevice, public configuration::IConfigurationListener, boost::noncopyable
 {
     Q_OBJECT
 
 public:
-    InputDevice(QObject& parent, configuration::IConfiguration::Pointer configuration, const QRect& touchscreenGeometry, const QRect& videoGeometry);
+    InputDevice(QObject& surface, configuration::IConfiguration::Pointer configuration, KeyMap::Pointer keyMap, const QRect& touchscreenGeometry, const QRect& videoGeometry);
 
     void start(IInputDeviceEventHandler& eventHandler) override;
     void stop() override;
@@ -45,18 +50,28 @@ public:
     bool eventFilter(QObject* obj, QEvent* event) override;
     bool hasTouchscreen() const override;
     QRect getTouchscreenGeometry() const override;
+    void onConfigurationChanged(const configuration::ConfigurationChange& change) override;
+
+protected slots:
+    void attachFilter();
+    void detachFilter();
 
 private:
     void setVideoGeometry();
     bool handleKeyEvent(QEvent* event, QKeyEvent* key);
     void dispatchKeyEvent(ButtonEvent event);
     bool handleTouchEvent(QEvent* event);
+    bool handleMultiTouchEvent(QTouchEvent* touch);
 
-    QObject& parent_;
+    QPointer<QObject> surface_;
     configuration::IConfiguration::Pointer configuration_;
+    KeyMap::Pointer keyMap_;
     QRect touchscreenGeometry_;
     QRect displayGeometry_;
     IInputDeviceEventHandler* eventHandler_;
+    bool touchscreenEnabled_;
+    ButtonCodeSet buttonCodes_;
+    TouchTracker touchTracker_;
     std::mutex mutex_;
 };
 
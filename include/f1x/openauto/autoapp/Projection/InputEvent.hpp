@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <vector>
 #include <aasdk_proto/ButtonCodeEnum.pb.h>
 #include <aasdk_proto/TouchActionEnum.pb.h>
 #include <f1x/aasdk/IO/Promise.hpp>
@@ -50,16 +52,30 @@ struct ButtonEvent
     ButtonEventType type;
     WheelDirection wheelDirection;
     aasdk::proto::enums::ButtonCode::Enum code;
+    // scroll wheel detents in wheelDirection
+    uint32_t wheelSteps = 1;
+    // the button has been held past the long press time
+    bool longPress = false;
+    // when the input happened, on the steady clock; unset when the source cannot tell
+    std::chrono::steady_clock::time_point timestamp{};
 };
 
-struct TouchEvent
+struct TouchPoint
 {
-    aasdk::proto::enums::TouchAction::Enum type;
     uint32_t x;
     uint32_t y;
     uint32_t pointerId;
 };
 
+// pointers holds every pointer that is down, actionIndex the one that went up or down
+struct TouchEvent
+{
+    aasdk::proto::enums::TouchAction::Enum type;
+    std::vector<TouchPoint> pointers;
+    uint32_t actionIndex;
+    std::chrono::steady_clock::time_point timestamp{};
+};
+
 }
 }
 }
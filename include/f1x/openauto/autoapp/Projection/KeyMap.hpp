@@ -0,0 +1,105 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/property_tree/ptree.hpp>
+#include <f1x/openauto/autoapp/Projection/InputEvent.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+struct KeyBinding
+{
+    aasdk::proto::enums::ButtonCode::Enum code;
+    // keys bound to WHEEL_LEFT/WHEEL_RIGHT turn the scroll wheel instead of pressing a button
+    WheelDirection wheelDirection;
+};
+
+enum class GestureType
+{
+    LONG_PRESS,
+    DOUBLE_PRESS,
+    CHORD
+};
+
+// target is sent instead of trigger (together with partner for chords) when the gesture is recognized
+struct Gesture
+{
+    GestureType type;
+    aasdk::proto::enums::ButtonCode::Enum trigger;
+    aasdk::proto::enums::ButtonCode::Enum partner;
+    aasdk::proto::enums::ButtonCode::Enum target;
+};
+
+// Qt keys and evdev key codes resolved to Android Auto buttons through flat tables,
+// built once from the defaults and the [Qt] / [Evdev] sections of the keymap file,
+// plus the button gestures of the [Gestures] section.
+class KeyMap
+{
+public:
+    typedef std::shared_ptr<const KeyMap> Pointer;
+
+    KeyMap();
+
+    void load(const std::string& fileName);
+    const KeyBinding* getQtBinding(int key) const;
+    const KeyBinding* getEvdevBinding(uint16_t code) const;
+    const std::vector<Gesture>& getGestures() const;
+    uint32_t getLongPressTime() const;
+    uint32_t getDoublePressTime() const;
+    uint32_t getChordTime() const;
+
+    static const std::string cFileName;
+
+private:
+    static int getQtIndex(int key);
+    static bool parseBinding(const std::string& value, KeyBinding& binding);
+    static bool parseGesture(const std::string& key, const std::string& value, Gesture& gesture);
+    void bindQtKey(int key, aasdk::proto::enums::ButtonCode::Enum code, WheelDirection wheelDirection = WheelDirection::NONE);
+    void bindEvdevCode(uint16_t code, aasdk::proto::enums::ButtonCode::Enum buttonCode);
+    void readQtBindings(const boost::property_tree::ptree& section);
+    void readEvdevBindings(const boost::property_tree::ptree& section);
+    void readGestures(const boost::property_tree::ptree& section);
+
+    // printable keys, the function and media keys from Qt::Key_Escape, the phone keys from Qt::Key_Context1
+    static constexpr size_t cQtTableSize = 0x80 + 0x200 + 0x100;
+    static constexpr size_t cEvdevTableSize = 0x300;
+
+    std::array<KeyBinding, cQtTableSize> qtBindings_;
+    std::array<KeyBinding, cEvdevTableSize> evdevBindings_;
+    std::vector<Gesture> gestures_;
+    uint32_t longPressTime_;
+    uint32_t doublePressTime_;
+    uint32_t chordTime_;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,107 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+// Hashed timer wheel for a fixed set of timer ids, turned one slot per tick by its owner.
+// Scheduling and cancelling are O(1) and never allocate; every id has at most one pending timer.
+class TimerWheel
+{
+public:
+    static constexpr size_t cCapacity = 32;
+    static constexpr size_t cSlots = 64;
+
+    TimerWheel();
+
+    void schedule(size_t id, size_t ticks);
+    void cancel(size_t id);
+    bool isScheduled(size_t id) const;
+    void clear();
+    bool empty() const;
+
+    // turns the wheel by one tick and calls handler(id) for every timer that expired
+    template<typename Handler>
+    void advance(Handler&& handler)
+    {
+        cursor_ = (cursor_ + 1) % cSlots;
+
+        // handlers may schedule and cancel, so the expired ids are collected first
+        std::array<uint8_t, cCapacity> expired;
+        size_t expiredCount = 0;
+
+        auto id = heads_[cursor_];
+        while(id != cNone)
+        {
+            auto& entry = entries_[id];
+            const auto next = entry.next;
+
+            if(entry.rounds == 0)
+            {
+                this->unlink(id);
+                expired[expiredCount++] = id;
+            }
+            else
+            {
+                --entry.rounds;
+            }
+
+            id = next;
+        }
+
+        for(size_t i = 0; i < expiredCount; ++i)
+        {
+            handler(static_cast<size_t>(expired[i]));
+        }
+    }
+
+private:
+    static constexpr uint8_t cNone = 0xFF;
+
+    struct Entry
+    {
+        uint8_t prev;
+        uint8_t next;
+        uint8_t slot;
+        uint32_t rounds;
+    };
+
+    void unlink(size_t id);
+
+    std::array<uint8_t, cSlots> heads_;
+    std::array<Entry, cCapacity> entries_;
+    size_t cursor_;
+    size_t count_;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,69 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <vector>
+#include <f1x/openauto/autoapp/Projection/InputEvent.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+// Turns per-pointer state changes into the Android touch sequence: PRESS for the first
+// pointer, POINTER_DOWN/POINTER_UP while others stay down, RELEASE for the last one and
+// DRAG for plain movement. Source ids (evdev slots, Qt touch point ids) are mapped to the
+// lowest free pointer id.
+class TouchTracker
+{
+public:
+    void down(int sourceId, uint32_t x, uint32_t y);
+    void move(int sourceId, uint32_t x, uint32_t y);
+    void up(int sourceId);
+    void upAll();
+    void reset();
+
+    // events for the changes since the previous flush, in the order they have to be sent
+    std::vector<TouchEvent> flush();
+
+private:
+    struct Pointer
+    {
+        TouchPoint point;
+        int sourceId;
+    };
+
+    std::vector<Pointer>::iterator find(int sourceId);
+    uint32_t allocatePointerId() const;
+    std::vector<TouchPoint> getPoints() const;
+
+    std::vector<Pointer> active_;
+    std::vector<Pointer> pressed_;
+    std::vector<int> released_;
+    bool moved_ = false;
+};
+
+}
+}
+}
+}
@@ -27,6 +27,7 @@
 #include <f1x/openauto/autoapp/Service/IAndroidAutoEntity.hpp>
 #include <f1x/openauto/autoapp/Service/IService.hpp>
 #include <f1x/openauto/autoapp/Service/IPinger.hpp>
+#include <f1x/openauto/autoapp/Service/MessageArena.hpp>
 
 namespace f1x
 {
@@ -63,6 +64,12 @@ public:
     void onPingResponse(const aasdk::proto::messages::PingResponse& response) override;
     void onChannelError(const aasdk::error::Error& e) override;
 
+    static void fillServiceDiscoveryResponse(const configuration::IConfiguration& configuration, const ServiceList& serviceList,
+                                             aasdk::proto::messages::ServiceDiscoveryResponse& response);
+
+    // large enough for the whole service discovery response
+    static constexpr size_t cArenaSize = 16384;
+
 private:
     using std::enable_shared_from_this<AndroidAutoEntity>::shared_from_this;
     void triggerQuit();
@@ -78,6 +85,7 @@ private:
     ServiceList serviceList_;
     IPinger::Pointer pinger_;
     IAndroidAutoEntityEventHandler* eventHandler_;
+    MessageArena arena_;
 };
 
 }
@@ -22,6 +22,8 @@
 #include <f1x/aasdk/Channel/AV/IAudioServiceChannelEventHandler.hpp>
 #include <f1x/openauto/autoapp/Projection/IAudioOutput.hpp>
 #include <f1x/openauto/autoapp/Service/IService.hpp>
+#include <f1x/openauto/autoapp/Service/MessagePool.hpp>
+#include <f1x/openauto/autoapp/Service/SendPromisePool.hpp>
 
 namespace f1x
 {
@@ -37,7 +39,8 @@ class AudioService: public aasdk::channel::av::IAudioServiceChannelEventHandler,
 public:
     typedef std::shared_ptr<AudioService> Pointer;
 
-    AudioService(boost::asio::io_service& ioService, aasdk::channel::av::IAudioServiceChannel::Pointer channel, projection::IAudioOutput::Pointer audioOutput);
+    AudioService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, aasdk::channel::av::IAudioServiceChannel::Pointer channel,
+                 projection::IAudioOutput::Pointer audioOutput);
 
     void start() override;
     void stop() override;
@@ -54,11 +57,19 @@ public:
 
 protected:
     using std::enable_shared_from_this<AudioService>::shared_from_this;
+    void setSession(int32_t session);
+    void sendAVMediaAckIndication();
 
     boost::asio::io_service::strand strand_;
+    aasdk::messenger::IMessenger::Pointer messenger_;
     aasdk::channel::av::IAudioServiceChannel::Pointer channel_;
     projection::IAudioOutput::Pointer audioOutput_;
     int32_t session_;
+
+    // one ACK per audio packet, serialized once per session and sent straight to the messenger
+    aasdk::common::Data ackIndication_;
+    MessagePool ackMessages_;
+    SendPromisePool sendPromises_;
 };
 
 }
@@ -0,0 +1,84 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+// Latency of input events on their way to the phone, per stage: from the event source to the
+// input strand, to the completed send, and on to the next video frame received from the phone,
+// which is the earliest the reaction can show up. Shared by InputService and VideoService.
+class InputLatencyMonitor
+{
+public:
+    typedef std::shared_ptr<InputLatencyMonitor> Pointer;
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    InputLatencyMonitor();
+
+    void onDispatch(TimePoint eventTime, TimePoint dispatchTime);
+    void onSendComplete(TimePoint eventTime, TimePoint sendTime);
+    void onVideoFrame();
+    void report();
+
+private:
+    // power of two microsecond buckets, p50/p99 are read as the upper bound of a bucket
+    struct Histogram
+    {
+        std::array<uint64_t, 24> buckets{};
+        uint64_t count = 0;
+        uint64_t max = 0;
+
+        void add(std::chrono::steady_clock::duration latency);
+        uint64_t percentile(double fraction) const;
+        std::string format() const;
+    };
+
+    std::mutex mutex_;
+    Histogram dispatch_;
+    Histogram send_;
+    Histogram frame_;
+    Histogram total_;
+    // the oldest input sent since the last video frame
+    std::atomic<bool> awaitingFrame_;
+    TimePoint pendingEventTime_;
+    TimePoint pendingSendTime_;
+    TimePoint lastReportTime_;
+    uint64_t lastReportCount_;
+
+    static constexpr std::chrono::seconds cReportInterval{30};
+};
+
+}
+}
+}
+}
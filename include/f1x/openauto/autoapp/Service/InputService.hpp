@@ -18,9 +18,16 @@
 
 #pragma once
 
+#include <boost/asio/steady_timer.hpp>
 #include <aasdk_proto/ButtonCodeEnum.pb.h>
+#include <aasdk_proto/InputEventIndicationMessage.pb.h>
 #include <f1x/aasdk/Channel/Input/InputServiceChannel.hpp>
+#include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
 #include <f1x/openauto/autoapp/Service/IService.hpp>
+#include <f1x/openauto/autoapp/Service/InputLatencyMonitor.hpp>
+#include <f1x/openauto/autoapp/Service/MessagePool.hpp>
+#include <f1x/openauto/autoapp/Service/SendPromisePool.hpp>
+#include <f1x/openauto/autoapp/Projection/GestureRecognizer.hpp>
 #include <f1x/openauto/autoapp/Projection/IInputDevice.hpp>
 #include <f1x/openauto/autoapp/Projection/IInputDeviceEventHandler.hpp>
 
@@ -40,7 +47,8 @@ class InputService:
         public std::enable_shared_from_this<InputService>
 {
 public:
-    InputService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, projection::IInputDevice::Pointer inputDevice);
+    InputService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, configuration::IConfiguration::Pointer configuration,
+                 projection::KeyMap::Pointer keyMap, projection::IInputDevice::Pointer inputDevice, InputLatencyMonitor::Pointer latencyMonitor);
 
     void start() override;
     void stop() override;
@@ -55,10 +63,52 @@ public:
 
 private:
     using std::enable_shared_from_this<InputService>::shared_from_this;
+    static InputLatencyMonitor::TimePoint getEventTime(InputLatencyMonitor::TimePoint timestamp);
+    void sendButtonEvent(const projection::ButtonEvent& event, std::chrono::microseconds timestamp, InputLatencyMonitor::TimePoint eventTime);
+    void sendTouchEvent(const projection::TouchEvent& event, std::chrono::microseconds timestamp, InputLatencyMonitor::TimePoint eventTime);
+    void sendInputEventIndication(InputLatencyMonitor::TimePoint eventTime);
+    void sendPendingMove();
+    void sendPendingWheel();
+    void onMoveTimerExpired(const boost::system::error_code& error);
+    void onWheelTimerExpired(const boost::system::error_code& error);
+    void onGestureEvent(const projection::ButtonEvent& event);
+    void scheduleGestureTick();
+    void onGestureTimerExpired(const boost::system::error_code& error);
 
     boost::asio::io_service::strand strand_;
+    aasdk::messenger::IMessenger::Pointer messenger_;
     aasdk::channel::input::InputServiceChannel::Pointer channel_;
     projection::IInputDevice::Pointer inputDevice_;
+    InputLatencyMonitor::Pointer latencyMonitor_;
+
+    // reused for every event, clearing keeps the allocated touch locations
+    aasdk::proto::messages::InputEventIndication inputEventIndication_;
+    MessagePool inputEventMessages_;
+    SendPromisePool sendPromises_;
+
+    // DRAG events are coalesced to one per moveInterval_, the latest one carries every pointer
+    boost::asio::steady_timer moveTimer_;
+    std::chrono::steady_clock::duration moveInterval_;
+    std::chrono::steady_clock::time_point lastMoveSendTime_;
+    bool movePending_;
+    projection::TouchEvent pendingMove_;
+    std::chrono::microseconds pendingMoveTimestamp_;
+    InputLatencyMonitor::TimePoint pendingMoveEventTime_;
+    uint64_t touchEventsReceived_;
+    uint64_t touchEventsSent_;
+
+    // scroll wheel detents are summed into one relative event per moveInterval_
+    boost::asio::steady_timer wheelTimer_;
+    std::chrono::steady_clock::time_point lastWheelSendTime_;
+    bool wheelPending_;
+    int32_t pendingWheelDelta_;
+    std::chrono::microseconds pendingWheelTimestamp_;
+    InputLatencyMonitor::TimePoint pendingWheelEventTime_;
+
+    // buttons pass through the gesture recognizer, its timer wheel is turned only while a gesture is pending
+    projection::GestureRecognizer gestureRecognizer_;
+    boost::asio::steady_timer gestureTimer_;
+    bool gestureTickPending_;
 };
 
 }
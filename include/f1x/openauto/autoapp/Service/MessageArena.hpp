@@ -0,0 +1,80 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <boost/noncopyable.hpp>
+#include <google/protobuf/arena.h>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+// Protobuf arena for the messages a handler builds and sends in one go. The first block is
+// allocated with the arena, so a message that fits in it is built without touching the heap.
+// Messages are serialized by the channel before its send returns, reset() after the send frees
+// them and any blocks the message outgrew. Not thread safe, used from the strand of the owner.
+class MessageArena: boost::noncopyable
+{
+public:
+    explicit MessageArena(size_t initialBlockSize);
+
+    template<typename MessageType>
+    MessageType* create()
+    {
+        return this->create<MessageType>(std::integral_constant<bool, google::protobuf::Arena::is_arena_constructable<MessageType>::value>());
+    }
+
+    void reset();
+    uint64_t getOverflowCount() const;
+
+private:
+    // before protobuf 3.14 only messages generated with cc_enable_arenas are arena constructable,
+    // CreateMessage() refuses the others at compile time
+    template<typename MessageType>
+    MessageType* create(std::true_type)
+    {
+        return google::protobuf::Arena::CreateMessage<MessageType>(&arena_);
+    }
+
+    // the message itself goes on the arena, its fields still allocate from the heap
+    template<typename MessageType>
+    MessageType* create(std::false_type)
+    {
+        return google::protobuf::Arena::Create<MessageType>(&arena_);
+    }
+
+    static google::protobuf::ArenaOptions createOptions(char* initialBlock, size_t initialBlockSize);
+
+    size_t initialBlockSize_;
+    std::unique_ptr<char[]> initialBlock_;
+    google::protobuf::Arena arena_;
+    uint64_t overflowCount_;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,66 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <boost/noncopyable.hpp>
+#include <google/protobuf/message.h>
+#include <f1x/aasdk/Common/Data.hpp>
+#include <f1x/aasdk/Messenger/Message.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+// Outbound messages of one id on one channel, taken back once the messenger has let go of them.
+// A message handed out again keeps its payload capacity, so steady traffic stops allocating after
+// the first few sends. Not thread safe, used from the strand of the owning service.
+class MessagePool: boost::noncopyable
+{
+public:
+    MessagePool(aasdk::messenger::ChannelId channelId, uint16_t messageId);
+
+    // the payload holds the message id, the body is appended by the caller
+    aasdk::messenger::Message::Pointer acquire();
+    uint64_t getOverflowCount() const;
+
+    // serializes a body once for messages that are sent over and over unchanged
+    static void serialize(const google::protobuf::Message& message, aasdk::common::Data& data);
+
+private:
+    aasdk::messenger::Message::Pointer create() const;
+
+    static constexpr size_t cSize = 8;
+
+    aasdk::messenger::ChannelId channelId_;
+    aasdk::common::Data messageId_;
+    std::array<aasdk::messenger::Message::Pointer, cSize> messages_;
+    size_t next_;
+    uint64_t overflowCount_;
+};
+
+}
+}
+}
+}
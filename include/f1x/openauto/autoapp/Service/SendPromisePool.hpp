@@ -0,0 +1,70 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <memory>
+#include <type_traits>
+#include <boost/noncopyable.hpp>
+#include <f1x/aasdk/Channel/Promise.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+// Storage for the send promises of one service. aasdk promises are single-shot, so instead of being
+// reused they are placed into fixed blocks with allocate_shared. The allocator kept in each control
+// block holds the owner, so a pending promise keeps its service and strand alive without the handlers
+// capturing shared_from_this(). Blocks come back from whichever thread drops the last promise.
+class SendPromisePool: boost::noncopyable
+{
+public:
+    SendPromisePool();
+
+    aasdk::channel::SendPromise::Pointer defer(boost::asio::io_service::strand& strand, std::shared_ptr<void> owner);
+    uint64_t getOverflowCount() const;
+
+private:
+    template<typename T>
+    class Allocator;
+
+    void* allocate(size_t size);
+    void deallocate(void* pointer);
+
+    static constexpr size_t cBlockSize = 256;
+    static constexpr size_t cBlockCount = 32;
+
+    typedef std::aligned_storage<cBlockSize, alignof(std::max_align_t)>::type Block;
+    std::array<Block, cBlockCount> blocks_;
+    std::array<Block*, cBlockCount> freeBlocks_;
+    size_t freeCount_;
+    uint64_t overflowCount_;
+    mutable std::mutex mutex_;
+};
+
+}
+}
+}
+}
@@ -19,8 +19,11 @@
 #pragma once
 
 #include <gps.h>
+#include <aasdk_proto/SensorEventIndicationMessage.pb.h>
 #include <f1x/aasdk/Channel/Sensor/SensorServiceChannel.hpp>
 #include <f1x/openauto/autoapp/Service/IService.hpp>
+#include <f1x/openauto/autoapp/Service/MessagePool.hpp>
+#include <f1x/openauto/autoapp/Service/SendPromisePool.hpp>
 
 namespace f1x
 {
@@ -53,15 +56,22 @@ private:
     void sendDrivingStatusUnrestricted();
     void sendNightData();
     void sendGPSLocationData();
+    void sendSensorEventIndication();
     bool is_file_exist(const char *filename);
     void sensorPolling();
     bool firstRun = true;
 
     boost::asio::deadline_timer timer_;
     boost::asio::io_service::strand strand_;
+    aasdk::messenger::IMessenger::Pointer messenger_;
     aasdk::channel::sensor::SensorServiceChannel::Pointer channel_;
     struct gps_data_t gpsData_;
     bool gpsEnabled_ = false;
+
+    // reused for every update, clearing keeps the allocated location and night mode entries
+    aasdk::proto::messages::SensorEventIndication sensorEventIndication_;
+    MessagePool sensorEventMessages_;
+    SendPromisePool sendPromises_;
 };
 
 }
@@ -18,8 +18,11 @@
 
 #pragma once
 
+#include <QObject>
 #include <f1x/openauto/autoapp/Service/IServiceFactory.hpp>
+#include <f1x/openauto/autoapp/Service/InputLatencyMonitor.hpp>
 #include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
+#include <f1x/openauto/autoapp/Projection/IAudioOutput.hpp>
 
 namespace f1x
 {
@@ -36,10 +39,13 @@ public:
     ServiceFactory(boost::asio::io_service& ioService, configuration::IConfiguration::Pointer configuration);
     ServiceList create(aasdk::messenger::IMessenger::Pointer messenger) override;
 
+protected:
+    virtual projection::IAudioOutput::Pointer createAudioOutput(uint32_t channelCount, uint32_t sampleSize, uint32_t sampleRate);
+
 private:
-    IService::Pointer createVideoService(aasdk::messenger::IMessenger::Pointer messenger);
+    IService::Pointer createVideoService(aasdk::messenger::IMessenger::Pointer messenger, InputLatencyMonitor::Pointer latencyMonitor, QObject*& inputSurface);
     IService::Pointer createBluetoothService(aasdk::messenger::IMessenger::Pointer messenger);
-    IService::Pointer createInputService(aasdk::messenger::IMessenger::Pointer messenger);
+    IService::Pointer createInputService(aasdk::messenger::IMessenger::Pointer messenger, InputLatencyMonitor::Pointer latencyMonitor, QObject& inputSurface);
     void createAudioServices(ServiceList& serviceList, aasdk::messenger::IMessenger::Pointer messenger);
 
     boost::asio::io_service& ioService_;
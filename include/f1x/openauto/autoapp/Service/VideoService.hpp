@@ -23,6 +23,9 @@
 #include <f1x/aasdk/Channel/AV/IVideoServiceChannelEventHandler.hpp>
 #include <f1x/openauto/autoapp/Projection/IVideoOutput.hpp>
 #include <f1x/openauto/autoapp/Service/IService.hpp>
+#include <f1x/openauto/autoapp/Service/InputLatencyMonitor.hpp>
+#include <f1x/openauto/autoapp/Service/MessagePool.hpp>
+#include <f1x/openauto/autoapp/Service/SendPromisePool.hpp>
 
 namespace f1x
 {
@@ -38,7 +41,8 @@ class VideoService: public aasdk::channel::av::IVideoServiceChannelEventHandler,
 public:
     typedef std::shared_ptr<VideoService> Pointer;
 
-    VideoService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, projection::IVideoOutput::Pointer videoOutput);
+    VideoService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, projection::IVideoOutput::Pointer videoOutput,
+                 InputLatencyMonitor::Pointer latencyMonitor);
 
     void start() override;
     void stop() override;
@@ -57,11 +61,20 @@ public:
 private:
     using std::enable_shared_from_this<VideoService>::shared_from_this;
     void sendVideoFocusIndication();
+    void setSession(int32_t session);
+    void sendAVMediaAckIndication();
 
     boost::asio::io_service::strand strand_;
+    aasdk::messenger::IMessenger::Pointer messenger_;
     aasdk::channel::av::VideoServiceChannel::Pointer channel_;
     projection::IVideoOutput::Pointer videoOutput_;
+    InputLatencyMonitor::Pointer latencyMonitor_;
     int32_t session_;
+
+    // one ACK per frame, serialized once per session and sent straight to the messenger
+    aasdk::common::Data ackIndication_;
+    MessagePool ackMessages_;
+    SendPromisePool sendPromises_;
 };
 
 }
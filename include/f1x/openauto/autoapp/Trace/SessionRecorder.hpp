@@ -0,0 +1,100 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <fstream>
+#include <condition_variable>
+#include <chrono>
+#include <f1x/aasdk/Messenger/Message.hpp>
+#include <f1x/openauto/autoapp/Configuration/TraceMode.hpp>
+#include <f1x/openauto/autoapp/Trace/TraceFormat.hpp>
+
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace trace
+{
+
+// Writes the messages of one Android Auto session to a trace file. STREAM appends to a
+// timestamped file as the session runs, RING keeps only the newest ringSize bytes in memory
+// and dumps them to openauto-last.trace when the session stops. Disk and compression work
+// happens on an own thread, record() only encodes into a buffer.
+class SessionRecorder
+{
+public:
+    typedef std::shared_ptr<SessionRecorder> Pointer;
+
+    SessionRecorder(configuration::TraceMode mode, std::string directory, bool compress, size_t ringSize);
+    ~SessionRecorder();
+
+    void record(Direction direction, const aasdk::messenger::Message& message);
+    void stop();
+
+private:
+    typedef std::vector<uint8_t> Buffer;
+
+    void encode(Buffer& buffer, Direction direction, const aasdk::messenger::Message& message) const;
+    void run();
+    bool open(const std::string& fileName);
+    void write(const Buffer& buffer, bool finish);
+    void close();
+
+    configuration::TraceMode mode_;
+    std::string directory_;
+    bool compress_;
+    size_t ringSize_;
+    std::chrono::steady_clock::time_point startTime_;
+    uint64_t startTimestamp_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    Buffer pending_;
+    std::deque<Buffer> ring_;
+    size_t ringBytes_;
+    size_t droppedRecords_;
+    bool stopped_;
+
+    std::ofstream file_;
+    std::string fileName_;
+    Buffer compressed_;
+#ifdef USE_ZSTD
+    ZSTD_CCtx* zstd_;
+#endif
+    std::thread thread_;
+
+    static const size_t cMaxPendingSize;
+};
+
+}
+}
+}
+}
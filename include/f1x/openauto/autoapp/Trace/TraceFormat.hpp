@@ -0,0 +1,56 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace trace
+{
+
+// Session trace layout, all integers little endian:
+//
+//   file header  magic "OATRACE1" | u32 version | u32 flags | u64 start time (unix us)
+//   record       u32 length | u64 timestamp (us since start) | u8 direction | u8 channel id
+//                | u8 encryption type | u8 message type | payload (length - cRecordHeaderSize bytes)
+//
+// With cFlagZstd set, everything after the file header is a single zstd stream of records.
+
+static constexpr char cTraceMagic[8] = {'O', 'A', 'T', 'R', 'A', 'C', 'E', '1'};
+static constexpr uint32_t cTraceVersion = 1;
+static constexpr uint32_t cFlagZstd = 1 << 0;
+static constexpr size_t cFileHeaderSize = sizeof(cTraceMagic) + 4 + 4 + 8;
+static constexpr size_t cRecordHeaderSize = 8 + 1 + 1 + 1 + 1;
+
+enum class Direction : uint8_t
+{
+    INBOUND,
+    OUTBOUND
+};
+
+}
+}
+}
+}
@@ -0,0 +1,84 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <f1x/openauto/autoapp/Trace/TraceFormat.hpp>
+
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace trace
+{
+
+// Sequential reader for files written by SessionRecorder.
+class TraceReader
+{
+public:
+    struct Record
+    {
+        uint64_t timestamp;
+        Direction direction;
+        uint8_t channelId;
+        uint8_t encryptionType;
+        uint8_t messageType;
+        std::vector<uint8_t> payload;
+    };
+
+    TraceReader(std::string fileName);
+    ~TraceReader();
+
+    bool open();
+    bool read(Record& record);
+    uint64_t getStartTimestamp() const;
+
+private:
+    typedef std::vector<uint8_t> Buffer;
+
+    bool fill(size_t size);
+    bool readChunk(Buffer& chunk);
+
+    std::string fileName_;
+    std::ifstream file_;
+    uint64_t startTimestamp_;
+    Buffer buffer_;
+    size_t position_;
+#ifdef USE_ZSTD
+    ZSTD_DCtx* zstd_;
+    Buffer input_;
+    size_t inputPosition_;
+#endif
+
+    static constexpr size_t cChunkSize = 64 * 1024;
+    static constexpr size_t cMaxRecordSize = 16 * 1024 * 1024;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,56 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QLabel>
+#include <QTimer>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+// Small overlay with the window's frame count and paint+flush cost over the last second.
+class FrameTimeHud: public QLabel
+{
+    Q_OBJECT
+
+public:
+    FrameTimeHud(QWidget* parent = nullptr);
+
+    void addFrame(qint64 nsecs);
+
+private slots:
+    void report();
+
+private:
+    QTimer timer_;
+    int frames_;
+    qint64 totalNsecs_;
+    qint64 maxNsecs_;
+};
+
+}
+}
+}
+}
@@ -22,6 +22,12 @@
 #include <QMainWindow>
 #include <QFile>
 #include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
+#include <f1x/openauto/autoapp/UI/ThemeEngine.hpp>
+#include <f1x/openauto/autoapp/UI/WallpaperCache.hpp>
+#include <f1x/openauto/autoapp/UI/WallpaperSurface.hpp>
+#include <f1x/openauto/autoapp/UI/FrameTimeHud.hpp>
+#include <f1x/openauto/autoapp/UI/NowPlaying.hpp>
+#include <f1x/openauto/autoapp/UI/ScreenState.hpp>
 
 #include <QMediaPlayer>
 #include <QListWidgetItem>
@@ -45,6 +51,9 @@
 #include <QKeyEvent>
 
 #include <QBluetoothLocalDevice>
+#include <QSet>
+#include <QCache>
+#include <QFont>
 //#include <QtBluetooth>
 
 namespace Ui
@@ -158,8 +167,11 @@ private slots:
     void setRetryUSBConnect();
     void resetRetryUSBMessage();
     void updateNetworkInfo();
+    void onFileChanged(const QString& fileName);
     bool check_file_exist(const char *filename);
     void hostModeStateChanged(QBluetoothLocalDevice::HostMode);
+    void bluetoothDeviceConnected(const QBluetoothAddress& address);
+    void bluetoothDeviceDisconnected(const QBluetoothAddress& address);
 
     //void on_AlbumCoverListView_clicked(const QModelIndex &index);
     void on_AlbumCoverListView_clicked(const QModelIndex &index);
@@ -167,8 +179,25 @@ private slots:
     void on_pushButtonAlbum_clicked();
 
 private:
+    ScreenState readScreenState();
+    void reconcile(const ScreenState& state);
+    void restoreMenu();
+    void applyTheme();
+    void updateBluetoothDevice();
+    QPixmap findCover(const QStringList& fileNames);
+    void setWallpaper(WallpaperCache::Wallpaper wallpaper);
+
     Ui::MainWindow* ui_;
     configuration::IConfiguration::Pointer configuration_;
+    ThemeEngine themeEngine_;
+    WallpaperCache* wallpaperCache_;
+    WallpaperCache::Wallpaper currentWallpaper_ = WallpaperCache::Wallpaper::NONE;
+    WallpaperSurface* wallpaperSurface_ = nullptr;
+    FrameTimeHud* frameTimeHud_ = nullptr;
+    ScreenState screenState_;
+    bool screenStateValid_ = false;
+    int layoutRequests_ = 0;
+    int reconcilePasses_ = 0;
 
     QString brightnessFilename = "/sys/class/backlight/rpi_backlight/brightness";
     QString brightnessFilenameAlt = "/tmp/custombrightness";
@@ -176,7 +205,7 @@ private:
     QFile *brightnessFileAlt;
     char brightness_str[6];
     char volume_str[6];
-    int alpha_current_str;
+    int alpha_current_str = -1;
     QString bversion;
     QString bdate;
 
@@ -213,8 +242,16 @@ private:
     QString musicfolder = "/media/CSSTORAGE/Music";
     QString albumfolder = "/";
     QString date_text;
+    QString clock_text;
+    QSet<QString> connectedBluetoothDevices;
 
     QMediaPlaylist *playlist;
+    NowPlaying *nowPlaying;
+
+    QFont playingFontLarge;
+    QFont playingFontSmall;
+    QPixmap defaultCover;
+    QCache<QString, QPixmap> coverCache;
 
     bool customBrightnessControl = false;
 
@@ -275,6 +312,10 @@ private:
 
 protected:
     void keyPressEvent(QKeyEvent *event);
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    bool event(QEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
 
 };
 
@@ -0,0 +1,64 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QPixmap>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+// State of the track shown by the player widget. Setters only notify on a real change,
+// so the bound labels are not touched again when the player reports the same metadata twice.
+class NowPlaying: public QObject
+{
+    Q_OBJECT
+
+public:
+    NowPlaying(QObject* parent = nullptr);
+
+    void setTitle(const QString& title);
+    void setTrack(const QString& track);
+    void setTrackCount(const QString& trackCount);
+    void setCover(const QPixmap& cover);
+
+signals:
+    void titleChanged(const QString& title);
+    void trackChanged(const QString& track);
+    void trackCountChanged(const QString& trackCount);
+    void coverChanged(const QPixmap& cover);
+
+private:
+    QString title_;
+    QString track_;
+    QString trackCount_;
+    qint64 coverKey_;
+};
+
+}
+}
+}
+}
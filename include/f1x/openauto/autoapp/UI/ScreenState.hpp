@@ -0,0 +1,59 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+// What the main window should look like, derived from the /tmp flag files.
+// MainWindow diffs this against the previous state and only touches widgets that changed.
+struct ScreenState
+{
+    bool blank = false;
+    bool screensaver = false;
+    bool blackscreen = false;
+    bool androidDevice = false;
+    bool hotspot = false;
+    bool wifiDevice = false;
+    bool updateAvailable = false;
+    bool locked = false;
+
+    bool operator==(const ScreenState& other) const
+    {
+        return blank == other.blank && screensaver == other.screensaver && blackscreen == other.blackscreen
+                && androidDevice == other.androidDevice && hotspot == other.hotspot && wifiDevice == other.wifiDevice
+                && updateAvailable == other.updateAvailable && locked == other.locked;
+    }
+
+    bool operator!=(const ScreenState& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+}
+}
+}
+}
@@ -19,11 +19,14 @@
 #pragma once
 
 #include <memory>
+#include <bitset>
 #include <QWidget>
 #include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
 #include <QFileDialog>
 #include <QKeyEvent>
-#include <sys/sysinfo.h>
+#include <QThread>
+#include <QStringList>
+#include <f1x/openauto/autoapp/UI/SystemInfoCollector.hpp>
 
 class QCheckBox;
 class QTimer;
@@ -82,7 +85,10 @@ private slots:
     void on_pushButtonNetwork0_clicked();
     void on_pushButtonNetwork1_clicked();
     void updateSystemInfo();
+    void onSystemInfoCollected(const QString& freeMemory, const QString& cpuFrequency, const QString& cpuTemperature,
+                               const QString& disconnectTimer, const QString& shutdownTimer);
     void updateInfo();
+    void loadPendingSystemValues();
 
 public slots:
     void show_tab1();
@@ -98,6 +104,15 @@ public slots:
 private:
     void showEvent(QShowEvent* event);
     void load();
+    void showTab(int tab);
+    void loadTabValues(int tab);
+    void loadDisplayValues();
+    void loadAudioValues();
+    void loadNetworkValues();
+    void loadSystemInfoValues();
+    void loadGPIOValues();
+    void loadHardwareValues();
+    void loadLightSensorValues();
     void loadButtonCheckBoxes();
     void saveButtonCheckBoxes();
     void saveButtonCheckBox(const QCheckBox* checkBox, configuration::IConfiguration::ButtonCodes& buttonCodes, aasdk::proto::enums::ButtonCode::Enum buttonCode);
@@ -105,6 +120,15 @@ private:
 
     Ui::SettingsWindow* ui_;
     configuration::IConfiguration::Pointer configuration_;
+    QThread systemInfoThread_;
+    SystemInfoCollector* systemInfoCollector_;
+    bool systemInfoPending_;
+
+    static constexpr int cTabCount = 9;
+    std::bitset<cTabCount> systemValuesLoaded_;
+    bool systemValuesAvailable_;
+    QStringList systemParams_;
+    int currentTab_;
 };
 
 }
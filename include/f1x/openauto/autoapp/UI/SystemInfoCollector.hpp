@@ -0,0 +1,64 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+// Gathers the values shown on the system info tab. Lives on its own thread so the
+// systemctl call and the sysfs reads never stall the GUI event loop.
+class SystemInfoCollector: public QObject
+{
+    Q_OBJECT
+
+public:
+    SystemInfoCollector(QObject* parent = nullptr);
+    ~SystemInfoCollector() override;
+
+public slots:
+    void collect();
+
+signals:
+    void collected(const QString& freeMemory, const QString& cpuFrequency, const QString& cpuTemperature,
+                   const QString& disconnectTimer, const QString& shutdownTimer);
+
+private:
+    int readValue(int& fd, const char* fileName);
+    void readTimers(QString& disconnectTimer, QString& shutdownTimer);
+
+    int cpuFrequencyFd_;
+    int cpuTemperatureFd_;
+
+    static const char* cCpuFrequencyFileName;
+    static const char* cCpuTemperatureFileName;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,56 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <QString>
+#include <QStringList>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+// Builds the MainWindow stylesheet with the rules for every menu button for a given transparency.
+// Sheets are generated once per alpha value and kept, so restyling is a single setStyleSheet call
+// with one polish pass. A widget's own styleSheet beats the window's, so the buttons styled here
+// carry none in mainwindow.ui.
+class ThemeEngine
+{
+public:
+    ThemeEngine();
+
+    void setCustomButtonColors(const QStringList& colors);
+    const QString& getStyleSheet(int alpha);
+
+private:
+    QString buildButtonRules(int alpha) const;
+
+    QStringList customButtonColors_;
+    std::map<int, QString> cache_;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,78 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <thread>
+#include <QObject>
+#include <QPixmap>
+#include <QImage>
+#include <QSize>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+// Decodes every wallpaper variant once on a background thread, pre-scaled to the screen size,
+// and keeps them as pixmaps so the window can switch backgrounds without touching the disk.
+class WallpaperCache: public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Wallpaper
+    {
+        NONE,
+        DAY,
+        NIGHT,
+        CLASSIC_DAY,
+        CLASSIC_NIGHT,
+        EQ,
+        CHRISTMAS,
+        FIREWORK
+    };
+
+    WallpaperCache(const QSize& size, QObject* parent = nullptr);
+    ~WallpaperCache() override;
+
+    const QPixmap& get(Wallpaper wallpaper) const;
+
+signals:
+    void loaded();
+
+private slots:
+    void onImageLoaded(int wallpaper, const QImage& image);
+
+private:
+    void loadImages(QSize size);
+
+    std::map<Wallpaper, QPixmap> pixmaps_;
+    QPixmap empty_;
+    std::thread thread_;
+};
+
+}
+}
+}
+}
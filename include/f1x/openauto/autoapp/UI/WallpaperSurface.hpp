@@ -0,0 +1,57 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QOpenGLWidget>
+#include <f1x/openauto/autoapp/UI/WallpaperCache.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+// Draws the main window wallpaper through OpenGL. Once a window contains a QOpenGLWidget,
+// Qt composes the whole backing store on the GPU, so the semi-transparent buttons are
+// blended over the wallpaper texture instead of on the CPU. Works with Mesa's llvmpipe.
+class WallpaperSurface: public QOpenGLWidget
+{
+    Q_OBJECT
+
+public:
+    WallpaperSurface(WallpaperCache* wallpaperCache, QWidget* parent = nullptr);
+
+    void setWallpaper(WallpaperCache::Wallpaper wallpaper);
+
+protected:
+    void initializeGL() override;
+    void paintGL() override;
+
+private:
+    WallpaperCache* wallpaperCache_;
+    WallpaperCache::Wallpaper wallpaper_;
+};
+
+}
+}
+}
+}
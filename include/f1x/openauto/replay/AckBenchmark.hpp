@@ -0,0 +1,55 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <boost/asio.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+// Host side cost of one media ACK, sent the way the services used to (protobuf built per frame,
+// a fresh promise with a bound error handler, serialized by the aasdk channel) and the way they
+// do now (pre-serialized body, pooled message and promise straight to the messenger). Sends are
+// completed at once by the replay messenger, completions run on one thread.
+class AckBenchmark
+{
+public:
+    explicit AckBenchmark(size_t count);
+
+    void run(std::ostream& stream);
+
+private:
+    void measure(std::ostream& stream, const std::string& name, boost::asio::io_service& ioService, boost::asio::io_service::strand& strand,
+                 const std::function<void()>& send);
+
+    size_t count_;
+
+    static constexpr size_t cBatchSize = 1000;
+};
+
+}
+}
+}
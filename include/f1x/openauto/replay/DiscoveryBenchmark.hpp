@@ -0,0 +1,56 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <boost/asio.hpp>
+#include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
+#include <f1x/openauto/autoapp/Service/IService.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+// Host side cost of the service discovery response filled in by the real service set, built on
+// the stack the way the entity used to and on its arena the way it does now, then sent through
+// the aasdk control channel to the replay messenger.
+class DiscoveryBenchmark
+{
+public:
+    DiscoveryBenchmark(autoapp::configuration::IConfiguration::Pointer configuration, autoapp::service::ServiceList serviceList, size_t count);
+
+    void run(std::ostream& stream);
+
+private:
+    void measure(std::ostream& stream, const std::string& name, boost::asio::io_service& ioService, boost::asio::io_service::strand& strand,
+                 const std::function<void()>& send);
+
+    autoapp::configuration::IConfiguration::Pointer configuration_;
+    autoapp::service::ServiceList serviceList_;
+    size_t count_;
+};
+
+}
+}
+}
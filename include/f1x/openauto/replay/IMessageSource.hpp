@@ -0,0 +1,51 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+#include <f1x/aasdk/Messenger/Message.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+struct ReplayMessage
+{
+    // microseconds since the start of the session
+    uint64_t timestamp;
+    aasdk::messenger::Message::Pointer message;
+};
+
+class IMessageSource
+{
+public:
+    typedef std::shared_ptr<IMessageSource> Pointer;
+
+    IMessageSource() = default;
+    virtual ~IMessageSource() = default;
+
+    virtual bool next(ReplayMessage& message) = 0;
+};
+
+}
+}
+}
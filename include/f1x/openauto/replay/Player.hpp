@@ -0,0 +1,75 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <boost/asio.hpp>
+#include <f1x/openauto/replay/IMessageSource.hpp>
+#include <f1x/openauto/replay/ReplayMessenger.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+// Feeds a message source into the replay messenger. Without realtime pacing a channel gets
+// its next message as soon as its queue has room, so the run is bound by the services alone.
+class Player: public std::enable_shared_from_this<Player>
+{
+public:
+    typedef std::shared_ptr<Player> Pointer;
+    typedef std::function<void()> FinishHandler;
+
+    Player(boost::asio::io_service& ioService, ReplayMessenger::Pointer messenger, IMessageSource::Pointer source, ReplayStatistics& statistics, bool realtime, double speed);
+
+    void start(FinishHandler handler);
+
+private:
+    using std::enable_shared_from_this<Player>::shared_from_this;
+
+    void pump();
+    void waitForDrain();
+
+    boost::asio::io_service::strand strand_;
+    boost::asio::steady_timer timer_;
+    ReplayMessenger::Pointer messenger_;
+    IMessageSource::Pointer source_;
+    ReplayStatistics& statistics_;
+    bool realtime_;
+    double speed_;
+    FinishHandler finishHandler_;
+
+    ReplayMessage next_;
+    bool hasNext_;
+    bool waiting_;
+    uint64_t firstTimestamp_;
+    std::chrono::steady_clock::time_point startTime_;
+    uint64_t deliveredCount_;
+    std::chrono::steady_clock::time_point progressTime_;
+
+    static constexpr size_t cQueueWindow = 32;
+    static constexpr std::chrono::milliseconds cStartDelay{200};
+    static constexpr std::chrono::milliseconds cDrainInterval{50};
+    static constexpr std::chrono::seconds cIdleTimeout{2};
+};
+
+}
+}
+}
@@ -0,0 +1,79 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <f1x/aasdk/Messenger/IMessenger.hpp>
+#include <f1x/openauto/replay/ReplayStatistics.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+// Stands in for the aasdk messenger. Injected messages are handed to the channel's pending
+// receive, sends complete immediately. The time between handing a message to a channel and
+// that channel asking for the next one is reported as the handler latency.
+class ReplayMessenger: public aasdk::messenger::IMessenger
+{
+public:
+    typedef std::shared_ptr<ReplayMessenger> Pointer;
+    typedef std::function<void()> DeliveryHandler;
+
+    ReplayMessenger(ReplayStatistics& statistics);
+
+    void enqueueReceive(aasdk::messenger::ChannelId channelId, ReceivePromise::Pointer promise) override;
+    void enqueueSend(aasdk::messenger::Message::Pointer message, SendPromise::Pointer promise) override;
+    void stop() override;
+
+    void inject(aasdk::messenger::Message::Pointer message);
+    void setDeliveryHandler(DeliveryHandler handler);
+    bool isReceiving(aasdk::messenger::ChannelId channelId) const;
+    size_t getQueueSize(aasdk::messenger::ChannelId channelId) const;
+    size_t getQueueSize() const;
+    uint64_t getDeliveredCount() const;
+
+private:
+    struct Channel
+    {
+        ReceivePromise::Pointer promise;
+        std::deque<aasdk::messenger::Message::Pointer> queue;
+        std::chrono::steady_clock::time_point deliveredAt;
+        bool handling = false;
+    };
+
+    void deliver(Channel& channel, ReceivePromise::Pointer promise, aasdk::messenger::Message::Pointer message, std::unique_lock<std::mutex>& lock);
+
+    ReplayStatistics& statistics_;
+    mutable std::mutex mutex_;
+    std::map<aasdk::messenger::ChannelId, Channel> channels_;
+    DeliveryHandler deliveryHandler_;
+    uint64_t deliveredCount_;
+    bool stopped_;
+};
+
+}
+}
+}
@@ -0,0 +1,42 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <f1x/openauto/autoapp/Service/ServiceFactory.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+// The production service set with audio routed to NullAudioOutput.
+class ReplayServiceFactory: public autoapp::service::ServiceFactory
+{
+public:
+    using autoapp::service::ServiceFactory::ServiceFactory;
+
+protected:
+    autoapp::projection::IAudioOutput::Pointer createAudioOutput(uint32_t channelCount, uint32_t sampleSize, uint32_t sampleRate) override;
+};
+
+}
+}
+}
@@ -0,0 +1,78 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <array>
+#include <mutex>
+#include <chrono>
+#include <ostream>
+#include <f1x/aasdk/Messenger/ChannelId.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+class ReplayStatistics
+{
+public:
+    struct Usage
+    {
+        std::chrono::microseconds wall;
+        std::chrono::microseconds user;
+        std::chrono::microseconds system;
+        uint64_t allocations;
+    };
+
+    ReplayStatistics();
+
+    void addInbound(aasdk::messenger::ChannelId channelId, size_t size);
+    void addOutbound(aasdk::messenger::ChannelId channelId, size_t size);
+    void addSkipped(aasdk::messenger::ChannelId channelId);
+    void addLatency(aasdk::messenger::ChannelId channelId, std::chrono::microseconds latency);
+    void report(std::ostream& stream, const Usage& usage) const;
+
+private:
+    // bucket n counts latencies below 2^n microseconds, the last one everything above
+    static constexpr size_t cHistogramBuckets = 24;
+    typedef std::array<uint64_t, cHistogramBuckets> Histogram;
+
+    struct ChannelStatistics
+    {
+        uint64_t inboundMessages = 0;
+        uint64_t inboundBytes = 0;
+        uint64_t outboundMessages = 0;
+        uint64_t outboundBytes = 0;
+        uint64_t skippedMessages = 0;
+        uint64_t maxLatency = 0;
+        Histogram latency{};
+    };
+
+    static uint64_t percentile(const Histogram& histogram, double fraction);
+
+    mutable std::mutex mutex_;
+    std::map<aasdk::messenger::ChannelId, ChannelStatistics> channels_;
+};
+
+}
+}
+}
@@ -0,0 +1,75 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <f1x/aasdk/Common/Data.hpp>
+#include <f1x/aasdk/Messenger/ChannelId.hpp>
+#include <f1x/openauto/replay/IMessageSource.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+// Generates a session without a recording: channel setup for video, media audio and input,
+// followed by video frames and 48 kHz stereo PCM at their nominal rates. The video loops an
+// encoded sample (800x480 H.264 baseline, 30 frames opening with a key frame), so the frames
+// are decoded like the ones of a phone.
+class SyntheticMessageSource: public IMessageSource
+{
+public:
+    struct Options
+    {
+        uint64_t duration = 30 * 1000000;
+        uint32_t videoFPS = 30;
+        bool audio = true;
+        bool input = true;
+    };
+
+    SyntheticMessageSource(const Options& options);
+
+    bool next(ReplayMessage& message) override;
+
+private:
+    void addChannelOpenRequest(aasdk::messenger::ChannelId channelId);
+    void addAVChannelSetup(aasdk::messenger::ChannelId channelId);
+    void addBindingRequest();
+    aasdk::messenger::Message::Pointer createMediaMessage(aasdk::messenger::ChannelId channelId, uint64_t timestamp, const aasdk::common::Data& data) const;
+
+    static std::vector<aasdk::common::Data> loadVideoSample();
+    static aasdk::common::Data createPCM(uint64_t duration);
+
+    Options options_;
+    std::deque<aasdk::messenger::Message::Pointer> setup_;
+    std::vector<aasdk::common::Data> videoFrames_;
+    aasdk::common::Data pcm_;
+    uint64_t frameIndex_;
+    uint64_t videoTimestamp_;
+    uint64_t audioTimestamp_;
+
+    static constexpr uint64_t cAudioChunkDuration = 20000;
+};
+
+}
+}
+}
@@ -0,0 +1,52 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <QWidget>
+#include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+// Day/night switch of the real main window, through its day and night buttons the way the user
+// or the light sensor switches it now, and restyled with a whole window stylesheet the way every
+// switch used to be. Each switch is timed up to the end of the synchronous repaint it causes.
+class ThemeBenchmark
+{
+public:
+    ThemeBenchmark(autoapp::configuration::IConfiguration::Pointer configuration, size_t count);
+
+    void run(std::ostream& stream);
+
+private:
+    void measure(std::ostream& stream, const std::string& name, QWidget& window, const std::function<void(bool)>& apply);
+
+    autoapp::configuration::IConfiguration::Pointer configuration_;
+    size_t count_;
+};
+
+}
+}
+}
@@ -0,0 +1,57 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QTimer>
+#include <QRect>
+#include <f1x/openauto/replay/UinputTouchscreen.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+// Repeats horizontal swipes, posted to the application the way Qt delivers a touchscreen to
+// InputDevice, or written to a uinput touchscreen when one is given.
+class TouchGenerator
+{
+public:
+    TouchGenerator(const QRect& geometry, int rate, UinputTouchscreen* touchscreen = nullptr);
+
+    void start();
+    void stop();
+
+private:
+    QObject* getSurface() const;
+    void step();
+
+    QRect geometry_;
+    int rate_;
+    int step_;
+    UinputTouchscreen* touchscreen_;
+    QTimer timer_;
+
+    static constexpr int cSwipeSteps = 20;
+};
+
+}
+}
+}
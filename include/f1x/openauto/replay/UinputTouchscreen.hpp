@@ -0,0 +1,55 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <string>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+// A virtual single-touch screen created through /dev/uinput, so synthetic touches travel the
+// same kernel path as a real panel and can be read back by EvdevInputDevice.
+class UinputTouchscreen
+{
+public:
+    UinputTouchscreen();
+    ~UinputTouchscreen();
+
+    bool create(int width, int height);
+    std::string getDevicePath() const;
+
+    void press(int x, int y);
+    void move(int x, int y);
+    void release();
+
+private:
+    void write(int type, int code, int value);
+    std::string findDevicePath() const;
+
+    int fd_;
+    std::string devicePath_;
+};
+
+}
+}
+}
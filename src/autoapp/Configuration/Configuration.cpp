@@ -19,6 +19,11 @@
 #include <f1x/openauto/autoapp/Configuration/Configuration.hpp>
 #include <f1x/openauto/Common/Log.hpp>
 #include <QTouchDevice>
+#include <QThread>
+#include <sstream>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace f1x
 {
@@ -30,6 +35,13 @@ namespace configuration
 {
 
 const std::string Configuration::cConfigFileName = "openauto.ini";
+const std::string Configuration::cConfigBackupFileName = "openauto.ini.bak";
+const uint32_t Configuration::cConfigVersion = 1;
+const int Configuration::cSaveDelayMs = 1000;
+const std::string Configuration::cCSEnvFileName = "/boot/crankshaft/crankshaft_env.sh";
+const std::string Configuration::cCSDefaultEnvFileName = "/opt/crankshaft/crankshaft_default_env.sh";
+
+const std::string Configuration::cMetaVersionKey = "Meta.Version";
 
 const std::string Configuration::cGeneralShowClockKey = "General.ShowClock";
 
@@ -52,6 +64,8 @@ const std::string Configuration::cGeneralMp3TrackKey = "General.Mp3Track";
 const std::string Configuration::cGeneralMp3AutoPlayKey = "General.Mp3AutoPlay";
 const std::string Configuration::cGeneralShowAutoPlayKey = "General.ShowAutoPlay";
 const std::string Configuration::cGeneralInstantPlayKey = "General.InstantPlay";
+const std::string Configuration::cGeneralOpenGLRenderingKey = "General.OpenGLRendering";
+const std::string Configuration::cGeneralShowFrameTimesKey = "General.ShowFrameTimes";
 
 const std::string Configuration::cVideoFPSKey = "Video.FPS";
 const std::string Configuration::cVideoResolutionKey = "Video.Resolution";
@@ -64,10 +78,23 @@ const std::string Configuration::cAudioMusicAudioChannelEnabled = "Audio.MusicAu
 const std::string Configuration::cAudioSpeechAudioChannelEnabled = "Audio.SpeechAudioChannelEnabled";
 const std::string Configuration::cAudioOutputBackendType = "Audio.OutputBackendType";
 
+const std::string Configuration::cTraceModeKey = "Trace.Mode";
+const std::string Configuration::cTraceDirectoryKey = "Trace.Directory";
+const std::string Configuration::cTraceCompressionEnabledKey = "Trace.CompressionEnabled";
+const std::string Configuration::cTraceRingSizeKey = "Trace.RingSize";
+
 const std::string Configuration::cBluetoothAdapterTypeKey = "Bluetooth.AdapterType";
 const std::string Configuration::cBluetoothRemoteAdapterAddressKey = "Bluetooth.RemoteAdapterAddress";
 
 const std::string Configuration::cInputEnableTouchscreenKey = "Input.EnableTouchscreen";
+const std::string Configuration::cInputTouchscreenBackendKey = "Input.TouchscreenBackend";
+const std::string Configuration::cInputTouchscreenDeviceKey = "Input.TouchscreenDevice";
+const std::string Configuration::cInputTouchMoveRateKey = "Input.TouchMoveRate";
+const std::string Configuration::cInputControlDevicesKey = "Input.ControlDevices";
+const std::string Configuration::cInputRotaryGpioChipKey = "Input.RotaryGpioChip";
+const std::string Configuration::cInputRotaryGpioLineAKey = "Input.RotaryGpioLineA";
+const std::string Configuration::cInputRotaryGpioLineBKey = "Input.RotaryGpioLineB";
+const std::string Configuration::cInputRotaryAccelerationKey = "Input.RotaryAcceleration";
 const std::string Configuration::cInputEnablePlayerControlKey = "Input.EnablePlayerControl";
 const std::string Configuration::cInputPlayButtonKey = "Input.PlayButton";
 const std::string Configuration::cInputPauseButtonKey = "Input.PauseButton";
@@ -88,8 +115,27 @@ const std::string Configuration::cInputEnterButtonKey = "Input.EnterButton";
 const std::string Configuration::cInputNavButtonKey = "Input.NavButton";
 
 Configuration::Configuration()
+    : fileStore_(std::make_shared<FileStore>())
 {
+    saveTimer_.setSingleShot(true);
+    saveTimer_.setInterval(cSaveDelayMs);
+    QObject::connect(&saveTimer_, &QTimer::timeout, [this]() { this->flush(); });
+
     this->load();
+
+    const auto configFileName = QString::fromStdString(cConfigFileName);
+    QObject::connect(fileStore_.get(), &FileStore::fileChanged, fileStore_.get(), [this, configFileName](const QString& fileName) {
+        if(fileName == configFileName)
+        {
+            this->onConfigFileChanged();
+        }
+    });
+    fileStore_->exists(configFileName);
+}
+
+Configuration::~Configuration()
+{
+    this->flush();
 }
 
 void Configuration::load()
@@ -98,49 +144,8 @@ void Configuration::load()
 
     try
     {
-        boost::property_tree::ini_parser::read_ini(cConfigFileName, iniConfig);
-
-        handednessOfTrafficType_ = static_cast<HandednessOfTrafficType>(iniConfig.get<uint32_t>(cGeneralHandednessOfTrafficTypeKey,
-                                                                                              static_cast<uint32_t>(HandednessOfTrafficType::LEFT_HAND_DRIVE)));
-        showClock_ = iniConfig.get<bool>(cGeneralShowClockKey, true);
-        showBigClock_ = iniConfig.get<bool>(cGeneralShowBigClockKey, false);
-        oldGUI_ = iniConfig.get<bool>(cGeneralOldGUIKey, false);
-        alphaTrans_ = iniConfig.get<size_t>(cGeneralAlphaTransKey, 50);
-        hideMenuToggle_ = iniConfig.get<bool>(cGeneralHideMenuToggleKey, false);
-        hideAlpha_ = iniConfig.get<bool>(cGeneralHideAlphaKey, false);
-        showLux_ = iniConfig.get<bool>(cGeneralShowLuxKey, false);
-        showCursor_ = iniConfig.get<bool>(cGeneralShowCursorKey, false);
-        hideBrightnessControl_ = iniConfig.get<bool>(cGeneralHideBrightnessControlKey, false);
-        hideWarning_ = iniConfig.get<bool>(cGeneralHideWarningKey, false);
-        showNetworkinfo_ = iniConfig.get<bool>(cGeneralShowNetworkinfoKey, false);
-        mp3MasterPath_ = iniConfig.get<std::string>(cGeneralMp3MasterPathKey, "/media/MYMEDIA");
-        mp3SubFolder_ = iniConfig.get<std::string>(cGeneralMp3SubFolderKey, "/");
-        mp3Track_ = iniConfig.get<size_t>(cGeneralMp3TrackKey, 0);
-        mp3AutoPlay_ = iniConfig.get<bool>(cGeneralMp3AutoPlayKey, false);
-        showAutoPlay_ = iniConfig.get<bool>(cGeneralShowAutoPlayKey, false);
-        instantPlay_ = iniConfig.get<bool>(cGeneralInstantPlayKey, false);
-
-        videoFPS_ = static_cast<aasdk::proto::enums::VideoFPS::Enum>(iniConfig.get<uint32_t>(cVideoFPSKey,
-                                                                                             aasdk::proto::enums::VideoFPS::_30));
-
-        videoResolution_ = static_cast<aasdk::proto::enums::VideoResolution::Enum>(iniConfig.get<uint32_t>(cVideoResolutionKey,
-                                                                                                           aasdk::proto::enums::VideoResolution::_480p));
-        screenDPI_ = iniConfig.get<size_t>(cVideoScreenDPIKey, 140);
-
-        omxLayerIndex_ = iniConfig.get<int32_t>(cVideoOMXLayerIndexKey, 1);
-        videoMargins_ = QRect(0, 0, iniConfig.get<int32_t>(cVideoMarginWidth, 0), iniConfig.get<int32_t>(cVideoMarginHeight, 0));
-
-        enableTouchscreen_ = iniConfig.get<bool>(cInputEnableTouchscreenKey, true);
-        enablePlayerControl_ = iniConfig.get<bool>(cInputEnablePlayerControlKey, false);
-        this->readButtonCodes(iniConfig);
-
-        bluetoothAdapterType_ = static_cast<BluetoothAdapterType>(iniConfig.get<uint32_t>(cBluetoothAdapterTypeKey,
-                                                                                          static_cast<uint32_t>(BluetoothAdapterType::NONE)));
-
-        bluetoothRemoteAdapterAddress_ = iniConfig.get<std::string>(cBluetoothRemoteAdapterAddressKey, "");
-        musicAudioChannelEnabled_ = iniConfig.get<bool>(cAudioMusicAudioChannelEnabled, true);
-        speechAudiochannelEnabled_ = iniConfig.get<bool>(cAudioSpeechAudioChannelEnabled, true);
-        audioOutputBackendType_ = static_cast<AudioOutputBackendType>(iniConfig.get<uint32_t>(cAudioOutputBackendType, static_cast<uint32_t>(AudioOutputBackendType::RTAUDIO)));
+        this->readConfigFile(iniConfig);
+        this->applyConfig(iniConfig);
     }
     catch(const boost::property_tree::ini_parser_error& e)
     {
@@ -149,6 +154,71 @@ void Configuration::load()
                             << ". Using default configuration.";
         this->reset();
     }
+
+    boost::property_tree::ptree currentConfig;
+    this->writeConfig(currentConfig);
+    this->updateSnapshot(currentConfig);
+}
+
+void Configuration::applyConfig(const boost::property_tree::ptree& iniConfig)
+{
+    handednessOfTrafficType_ = static_cast<HandednessOfTrafficType>(iniConfig.get<uint32_t>(cGeneralHandednessOfTrafficTypeKey,
+                                                                                          static_cast<uint32_t>(HandednessOfTrafficType::LEFT_HAND_DRIVE)));
+    showClock_ = iniConfig.get<bool>(cGeneralShowClockKey, true);
+    showBigClock_ = iniConfig.get<bool>(cGeneralShowBigClockKey, false);
+    oldGUI_ = iniConfig.get<bool>(cGeneralOldGUIKey, false);
+    alphaTrans_ = iniConfig.get<size_t>(cGeneralAlphaTransKey, 50);
+    hideMenuToggle_ = iniConfig.get<bool>(cGeneralHideMenuToggleKey, false);
+    hideAlpha_ = iniConfig.get<bool>(cGeneralHideAlphaKey, false);
+    showLux_ = iniConfig.get<bool>(cGeneralShowLuxKey, false);
+    showCursor_ = iniConfig.get<bool>(cGeneralShowCursorKey, false);
+    hideBrightnessControl_ = iniConfig.get<bool>(cGeneralHideBrightnessControlKey, false);
+    hideWarning_ = iniConfig.get<bool>(cGeneralHideWarningKey, false);
+    showNetworkinfo_ = iniConfig.get<bool>(cGeneralShowNetworkinfoKey, false);
+    mp3MasterPath_ = iniConfig.get<std::string>(cGeneralMp3MasterPathKey, "/media/MYMEDIA");
+    mp3SubFolder_ = iniConfig.get<std::string>(cGeneralMp3SubFolderKey, "/");
+    mp3Track_ = iniConfig.get<size_t>(cGeneralMp3TrackKey, 0);
+    mp3AutoPlay_ = iniConfig.get<bool>(cGeneralMp3AutoPlayKey, false);
+    showAutoPlay_ = iniConfig.get<bool>(cGeneralShowAutoPlayKey, false);
+    instantPlay_ = iniConfig.get<bool>(cGeneralInstantPlayKey, false);
+    openGLRendering_ = iniConfig.get<bool>(cGeneralOpenGLRenderingKey, false);
+    showFrameTimes_ = iniConfig.get<bool>(cGeneralShowFrameTimesKey, false);
+
+    videoFPS_ = static_cast<aasdk::proto::enums::VideoFPS::Enum>(iniConfig.get<uint32_t>(cVideoFPSKey,
+                                                                                         aasdk::proto::enums::VideoFPS::_30));
+
+    videoResolution_ = static_cast<aasdk::proto::enums::VideoResolution::Enum>(iniConfig.get<uint32_t>(cVideoResolutionKey,
+                                                                                                       aasdk::proto::enums::VideoResolution::_480p));
+    screenDPI_ = iniConfig.get<size_t>(cVideoScreenDPIKey, 140);
+
+    omxLayerIndex_ = iniConfig.get<int32_t>(cVideoOMXLayerIndexKey, 1);
+    videoMargins_ = QRect(0, 0, iniConfig.get<int32_t>(cVideoMarginWidth, 0), iniConfig.get<int32_t>(cVideoMarginHeight, 0));
+
+    enableTouchscreen_ = iniConfig.get<bool>(cInputEnableTouchscreenKey, true);
+    touchscreenBackendType_ = static_cast<TouchscreenBackendType>(iniConfig.get<uint32_t>(cInputTouchscreenBackendKey, static_cast<uint32_t>(TouchscreenBackendType::QT)));
+    touchscreenDevice_ = iniConfig.get<std::string>(cInputTouchscreenDeviceKey, "");
+    touchMoveRate_ = iniConfig.get<uint32_t>(cInputTouchMoveRateKey, 0);
+    controlDevices_ = iniConfig.get<std::string>(cInputControlDevicesKey, "");
+    rotaryGpioChip_ = iniConfig.get<std::string>(cInputRotaryGpioChipKey, "");
+    rotaryGpioLineA_ = iniConfig.get<uint32_t>(cInputRotaryGpioLineAKey, 0);
+    rotaryGpioLineB_ = iniConfig.get<uint32_t>(cInputRotaryGpioLineBKey, 0);
+    rotaryAccelerationEnabled_ = iniConfig.get<bool>(cInputRotaryAccelerationKey, false);
+    enablePlayerControl_ = iniConfig.get<bool>(cInputEnablePlayerControlKey, false);
+    buttonCodes_.clear();
+    this->readButtonCodes(iniConfig);
+
+    bluetoothAdapterType_ = static_cast<BluetoothAdapterType>(iniConfig.get<uint32_t>(cBluetoothAdapterTypeKey,
+                                                                                      static_cast<uint32_t>(BluetoothAdapterType::NONE)));
+
+    bluetoothRemoteAdapterAddress_ = iniConfig.get<std::string>(cBluetoothRemoteAdapterAddressKey, "");
+    musicAudioChannelEnabled_ = iniConfig.get<bool>(cAudioMusicAudioChannelEnabled, true);
+    speechAudiochannelEnabled_ = iniConfig.get<bool>(cAudioSpeechAudioChannelEnabled, true);
+    audioOutputBackendType_ = static_cast<AudioOutputBackendType>(iniConfig.get<uint32_t>(cAudioOutputBackendType, static_cast<uint32_t>(AudioOutputBackendType::RTAUDIO)));
+
+    traceMode_ = static_cast<TraceMode>(iniConfig.get<uint32_t>(cTraceModeKey, static_cast<uint32_t>(TraceMode::NONE)));
+    traceDirectory_ = iniConfig.get<std::string>(cTraceDirectoryKey, "/tmp");
+    traceCompressionEnabled_ = iniConfig.get<bool>(cTraceCompressionEnabledKey, true);
+    traceRingSize_ = iniConfig.get<size_t>(cTraceRingSizeKey, 8 * 1024 * 1024);
 }
 
 void Configuration::reset()
@@ -171,12 +241,22 @@ void Configuration::reset()
     mp3AutoPlay_ = false;
     showAutoPlay_ = false;
     instantPlay_ = false;
+    openGLRendering_ = false;
+    showFrameTimes_ = false;
     videoFPS_ = aasdk::proto::enums::VideoFPS::_30;
     videoResolution_ = aasdk::proto::enums::VideoResolution::_480p;
     screenDPI_ = 140;
     omxLayerIndex_ = 1;
     videoMargins_ = QRect(0, 0, 0, 0);
     enableTouchscreen_ = true;
+    touchscreenBackendType_ = TouchscreenBackendType::QT;
+    touchscreenDevice_ = "";
+    touchMoveRate_ = 0;
+    controlDevices_ = "";
+    rotaryGpioChip_ = "";
+    rotaryGpioLineA_ = 0;
+    rotaryGpioLineB_ = 0;
+    rotaryAccelerationEnabled_ = false;
     enablePlayerControl_ = false;
     buttonCodes_.clear();
     bluetoothAdapterType_ = BluetoothAdapterType::NONE;
@@ -184,11 +264,47 @@ void Configuration::reset()
     musicAudioChannelEnabled_ = true;
     speechAudiochannelEnabled_ = true;
     audioOutputBackendType_ = AudioOutputBackendType::QT;
+    traceMode_ = TraceMode::NONE;
+    traceDirectory_ = "/tmp";
+    traceCompressionEnabled_ = true;
+    traceRingSize_ = 8 * 1024 * 1024;
 }
 
 void Configuration::save()
 {
     boost::property_tree::ptree iniConfig;
+    this->writeConfig(iniConfig);
+    this->updateSnapshot(iniConfig);
+
+    // written last, a file which lacks it was cut short
+    iniConfig.put<uint32_t>(cMetaVersionKey, cConfigVersion);
+
+    std::ostringstream content;
+    boost::property_tree::ini_parser::write_ini(content, iniConfig);
+
+    std::lock_guard<decltype(persistMutex_)> lock(persistMutex_);
+
+    if(content.str() == persistedContent_)
+    {
+        pendingContent_.clear();
+        return;
+    }
+
+    pendingContent_ = content.str();
+
+    // batch rapid successive saves (e.g. track changes) into a single write
+    if(QThread::currentThread() == saveTimer_.thread())
+    {
+        saveTimer_.start();
+    }
+    else
+    {
+        this->persist();
+    }
+}
+
+void Configuration::writeConfig(boost::property_tree::ptree& iniConfig)
+{
     iniConfig.put<uint32_t>(cGeneralHandednessOfTrafficTypeKey, static_cast<uint32_t>(handednessOfTrafficType_));
 
     iniConfig.put<bool>(cGeneralShowClockKey, showClock_);
@@ -208,6 +324,8 @@ void Configuration::save()
     iniConfig.put<bool>(cGeneralMp3AutoPlayKey, mp3AutoPlay_);
     iniConfig.put<bool>(cGeneralShowAutoPlayKey, showAutoPlay_);
     iniConfig.put<bool>(cGeneralInstantPlayKey, instantPlay_);
+    iniConfig.put<bool>(cGeneralOpenGLRenderingKey, openGLRendering_);
+    iniConfig.put<bool>(cGeneralShowFrameTimesKey, showFrameTimes_);
 
     iniConfig.put<uint32_t>(cVideoFPSKey, static_cast<uint32_t>(videoFPS_));
     iniConfig.put<uint32_t>(cVideoResolutionKey, static_cast<uint32_t>(videoResolution_));
@@ -217,6 +335,14 @@ void Configuration::save()
     iniConfig.put<uint32_t>(cVideoMarginHeight, videoMargins_.height());
 
     iniConfig.put<bool>(cInputEnableTouchscreenKey, enableTouchscreen_);
+    iniConfig.put<uint32_t>(cInputTouchscreenBackendKey, static_cast<uint32_t>(touchscreenBackendType_));
+    iniConfig.put<std::string>(cInputTouchscreenDeviceKey, touchscreenDevice_);
+    iniConfig.put<uint32_t>(cInputTouchMoveRateKey, touchMoveRate_);
+    iniConfig.put<std::string>(cInputControlDevicesKey, controlDevices_);
+    iniConfig.put<std::string>(cInputRotaryGpioChipKey, rotaryGpioChip_);
+    iniConfig.put<uint32_t>(cInputRotaryGpioLineAKey, rotaryGpioLineA_);
+    iniConfig.put<uint32_t>(cInputRotaryGpioLineBKey, rotaryGpioLineB_);
+    iniConfig.put<bool>(cInputRotaryAccelerationKey, rotaryAccelerationEnabled_);
     iniConfig.put<bool>(cInputEnablePlayerControlKey, enablePlayerControl_);
     this->writeButtonCodes(iniConfig);
 
@@ -226,7 +352,249 @@ void Configuration::save()
     iniConfig.put<bool>(cAudioMusicAudioChannelEnabled, musicAudioChannelEnabled_);
     iniConfig.put<bool>(cAudioSpeechAudioChannelEnabled, speechAudiochannelEnabled_);
     iniConfig.put<uint32_t>(cAudioOutputBackendType, static_cast<uint32_t>(audioOutputBackendType_));
-    boost::property_tree::ini_parser::write_ini(cConfigFileName, iniConfig);
+
+    iniConfig.put<uint32_t>(cTraceModeKey, static_cast<uint32_t>(traceMode_));
+    iniConfig.put<std::string>(cTraceDirectoryKey, traceDirectory_);
+    iniConfig.put<bool>(cTraceCompressionEnabledKey, traceCompressionEnabled_);
+    iniConfig.put<size_t>(cTraceRingSizeKey, traceRingSize_);
+}
+
+void Configuration::addListener(IConfigurationListener::WeakPointer listener)
+{
+    std::lock_guard<decltype(changeMutex_)> lock(changeMutex_);
+    listeners_.push_back(std::move(listener));
+}
+
+void Configuration::updateSnapshot(const boost::property_tree::ptree& iniConfig)
+{
+    Snapshot snapshot;
+    for(const auto& section : iniConfig)
+    {
+        for(const auto& value : section.second)
+        {
+            snapshot[section.first + "." + value.first] = value.second.data();
+        }
+    }
+
+    ConfigurationChange change;
+    std::vector<IConfigurationListener::Pointer> listeners;
+
+    {
+        std::lock_guard<decltype(changeMutex_)> lock(changeMutex_);
+
+        // the first snapshot is taken by the constructor, there is nobody to notify yet
+        if(!snapshot_.empty())
+        {
+            for(const auto& value : snapshot)
+            {
+                auto it = snapshot_.find(value.first);
+                if(it == snapshot_.end() || it->second != value.second)
+                {
+                    (isSessionKey(value.first) ? change.sessionKeys : change.liveKeys).insert(value.first);
+                }
+            }
+        }
+
+        snapshot_ = std::move(snapshot);
+
+        if(change.liveKeys.empty() && change.sessionKeys.empty())
+        {
+            return;
+        }
+
+        listeners_.erase(std::remove_if(listeners_.begin(), listeners_.end(), [&listeners](const IConfigurationListener::WeakPointer& weakListener) {
+            auto listener = weakListener.lock();
+            if(listener != nullptr)
+            {
+                listeners.push_back(std::move(listener));
+            }
+            return listener == nullptr;
+        }), listeners_.end());
+    }
+
+    for(const auto& key : change.sessionKeys)
+    {
+        OPENAUTO_LOG(info) << "[Configuration] " << key << " changed, applies on next session.";
+    }
+
+    // listeners are called without the lock held so they may query the configuration
+    for(const auto& listener : listeners)
+    {
+        listener->onConfigurationChanged(change);
+    }
+}
+
+bool Configuration::isSessionKey(const std::string& key)
+{
+    // these are consumed by ServiceFactory when the Android Auto session is built
+    return key.compare(0, 6, "Video.") == 0 || key.compare(0, 6, "Audio.") == 0 || key.compare(0, 10, "Bluetooth.") == 0
+            || key.compare(0, 6, "Trace.") == 0 || key.compare(0, 17, "Input.Touchscreen") == 0
+            || key == cInputTouchMoveRateKey || key == cInputControlDevicesKey || key.compare(0, 12, "Input.Rotary") == 0;
+}
+
+void Configuration::onConfigFileChanged()
+{
+    // persist() and most editors replace the file by a rename, which drops the inotify watch
+    // along with the old inode. Reading it through the store watches the new one.
+    fileStore_->exists(QString::fromStdString(cConfigFileName));
+
+    boost::property_tree::ptree iniConfig;
+    std::string content;
+
+    try
+    {
+        content = readSnapshot(cConfigFileName, iniConfig, false);
+    }
+    catch(const boost::property_tree::ini_parser_error& e)
+    {
+        OPENAUTO_LOG(warning) << "[Configuration] ignoring change of " << cConfigFileName << ": " << e.what();
+        return;
+    }
+
+    {
+        std::lock_guard<decltype(persistMutex_)> lock(persistMutex_);
+
+        // our own write coming back through the watcher
+        if(content == persistedContent_)
+        {
+            return;
+        }
+
+        // edited outside of the application, the file wins over unsaved changes
+        saveTimer_.stop();
+        pendingContent_.clear();
+        persistedContent_ = content;
+    }
+
+    OPENAUTO_LOG(info) << "[Configuration] " << cConfigFileName << " changed on disk, reloading.";
+
+    this->applyConfig(iniConfig);
+
+    boost::property_tree::ptree currentConfig;
+    this->writeConfig(currentConfig);
+    this->updateSnapshot(currentConfig);
+}
+
+void Configuration::flush()
+{
+    std::lock_guard<decltype(persistMutex_)> lock(persistMutex_);
+
+    if(QThread::currentThread() == saveTimer_.thread())
+    {
+        saveTimer_.stop();
+    }
+
+    if(!pendingContent_.empty())
+    {
+        this->persist();
+    }
+}
+
+void Configuration::persist()
+{
+    // keep the previous snapshot as the last known good one, then swap in the new file
+    if(!persistedContent_.empty() && !writeFileAtomically(cConfigBackupFileName, persistedContent_))
+    {
+        OPENAUTO_LOG(warning) << "[Configuration] failed to write backup configuration file: " << cConfigBackupFileName;
+    }
+
+    if(writeFileAtomically(cConfigFileName, pendingContent_))
+    {
+        persistedContent_ = std::move(pendingContent_);
+    }
+    else
+    {
+        OPENAUTO_LOG(error) << "[Configuration] failed to write configuration file: " << cConfigFileName;
+    }
+
+    pendingContent_.clear();
+}
+
+void Configuration::readConfigFile(boost::property_tree::ptree& iniConfig)
+{
+    // Once a backup exists the main file has been written by persist() and must carry the version marker,
+    // without a backup it may still be a file from an older release which never had one.
+    const bool requireVersion = static_cast<bool>(std::ifstream(cConfigBackupFileName));
+
+    try
+    {
+        persistedContent_ = readSnapshot(cConfigFileName, iniConfig, requireVersion);
+    }
+    catch(const boost::property_tree::ini_parser_error& e)
+    {
+        OPENAUTO_LOG(warning) << "[Configuration] " << e.what() << ", trying last known good configuration: " << cConfigBackupFileName;
+
+        iniConfig.clear();
+        persistedContent_ = readSnapshot(cConfigBackupFileName, iniConfig, false);
+    }
+}
+
+std::string Configuration::readSnapshot(const std::string& fileName, boost::property_tree::ptree& iniConfig, bool requireVersion)
+{
+    std::ifstream inFile(fileName);
+    if(!inFile)
+    {
+        throw boost::property_tree::ini_parser_error("cannot open file", fileName, 0);
+    }
+
+    std::ostringstream content;
+    content << inFile.rdbuf();
+
+    std::istringstream stream(content.str());
+    boost::property_tree::ini_parser::read_ini(stream, iniConfig);
+
+    if(requireVersion && !iniConfig.get_optional<uint32_t>(cMetaVersionKey))
+    {
+        throw boost::property_tree::ini_parser_error("incomplete file, version marker missing", fileName, 0);
+    }
+
+    return content.str();
+}
+
+bool Configuration::writeFileAtomically(const std::string& fileName, const std::string& content)
+{
+    const std::string tempFileName = fileName + ".tmp";
+
+    const int fd = ::open(tempFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    size_t written = 0;
+    while(written < content.size())
+    {
+        const auto result = ::write(fd, content.data() + written, content.size() - written);
+        if(result < 0)
+        {
+            ::close(fd);
+            ::unlink(tempFileName.c_str());
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+
+    if(::fsync(fd) != 0 || ::close(fd) != 0)
+    {
+        ::unlink(tempFileName.c_str());
+        return false;
+    }
+
+    if(::rename(tempFileName.c_str(), fileName.c_str()) != 0)
+    {
+        ::unlink(tempFileName.c_str());
+        return false;
+    }
+
+    // make the rename itself durable
+    const int dirFd = ::open(".", O_RDONLY);
+    if(dirFd >= 0)
+    {
+        ::fsync(dirFd);
+        ::close(dirFd);
+    }
+
+    return true;
 }
 
 bool Configuration::hasTouchScreen() const
@@ -428,6 +796,26 @@ bool Configuration::instantPlay() const
     return instantPlay_;
 }
 
+void Configuration::openGLRendering(bool value)
+{
+    openGLRendering_ = value;
+}
+
+bool Configuration::openGLRendering() const
+{
+    return openGLRendering_;
+}
+
+void Configuration::showFrameTimes(bool value)
+{
+    showFrameTimes_ = value;
+}
+
+bool Configuration::showFrameTimes() const
+{
+    return showFrameTimes_;
+}
+
 aasdk::proto::enums::VideoFPS::Enum Configuration::getVideoFPS() const
 {
     return videoFPS_;
@@ -488,6 +876,86 @@ void Configuration::setTouchscreenEnabled(bool value)
     enableTouchscreen_ = value;
 }
 
+TouchscreenBackendType Configuration::getTouchscreenBackendType() const
+{
+    return touchscreenBackendType_;
+}
+
+void Configuration::setTouchscreenBackendType(TouchscreenBackendType value)
+{
+    touchscreenBackendType_ = value;
+}
+
+std::string Configuration::getTouchscreenDevice() const
+{
+    return touchscreenDevice_;
+}
+
+void Configuration::setTouchscreenDevice(const std::string& value)
+{
+    touchscreenDevice_ = value;
+}
+
+uint32_t Configuration::getTouchMoveRate() const
+{
+    return touchMoveRate_;
+}
+
+void Configuration::setTouchMoveRate(uint32_t value)
+{
+    touchMoveRate_ = value;
+}
+
+std::string Configuration::getControlDevices() const
+{
+    return controlDevices_;
+}
+
+void Configuration::setControlDevices(const std::string& value)
+{
+    controlDevices_ = value;
+}
+
+std::string Configuration::getRotaryGpioChip() const
+{
+    return rotaryGpioChip_;
+}
+
+void Configuration::setRotaryGpioChip(const std::string& value)
+{
+    rotaryGpioChip_ = value;
+}
+
+uint32_t Configuration::getRotaryGpioLineA() const
+{
+    return rotaryGpioLineA_;
+}
+
+void Configuration::setRotaryGpioLineA(uint32_t value)
+{
+    rotaryGpioLineA_ = value;
+}
+
+uint32_t Configuration::getRotaryGpioLineB() const
+{
+    return rotaryGpioLineB_;
+}
+
+void Configuration::setRotaryGpioLineB(uint32_t value)
+{
+    rotaryGpioLineB_ = value;
+}
+
+bool Configuration::rotaryAccelerationEnabled() const
+{
+    return rotaryAccelerationEnabled_;
+}
+
+void Configuration::setRotaryAccelerationEnabled(bool value)
+{
+    rotaryAccelerationEnabled_ = value;
+}
+
 bool Configuration::playerButtonControl() const
 {
     return enablePlayerControl_;
@@ -558,130 +1026,88 @@ void Configuration::setAudioOutputBackendType(AudioOutputBackendType value)
     audioOutputBackendType_ = value;
 }
 
+TraceMode Configuration::getTraceMode() const
+{
+    return traceMode_;
+}
+
+void Configuration::setTraceMode(TraceMode value)
+{
+    traceMode_ = value;
+}
+
+std::string Configuration::getTraceDirectory() const
+{
+    return traceDirectory_;
+}
+
+void Configuration::setTraceDirectory(const std::string& value)
+{
+    traceDirectory_ = value;
+}
+
+bool Configuration::traceCompressionEnabled() const
+{
+    return traceCompressionEnabled_;
+}
+
+void Configuration::setTraceCompressionEnabled(bool value)
+{
+    traceCompressionEnabled_ = value;
+}
+
+size_t Configuration::getTraceRingSize() const
+{
+    return traceRingSize_;
+}
+
+void Configuration::setTraceRingSize(size_t value)
+{
+    traceRingSize_ = value;
+}
+
 QString Configuration::getCSValue(QString searchString) const
 {
-    using namespace std;
-    ifstream inFile;
-    ifstream inFile2;
-    string line;
+    QString value;
     searchString = searchString.append("=");
-    inFile.open("/boot/crankshaft/crankshaft_env.sh");
-    inFile2.open("/opt/crankshaft/crankshaft_default_env.sh");
 
-    size_t pos;
-
-    if(inFile) {
-        while(inFile.good())
-        {
-            getline(inFile,line); // get line from file
-            if (line[0] != '#') {
-                pos=line.find(searchString.toStdString()); // search
-                if(pos!=std::string::npos) // string::npos is returned if string is not found
-                {
-                    int equalPosition = line.find("=");
-                    QString value = line.substr(equalPosition + 1).c_str();
-                    value.replace("\"","");
-                    OPENAUTO_LOG(info) << "[Configuration] CS param found: " << searchString.toStdString() << " Value:" << value.toStdString();
-                    return value;
-                }
-            }
-        }
-        OPENAUTO_LOG(warning) << "[Configuration] unable to find cs param: " << searchString.toStdString();
-        OPENAUTO_LOG(warning) << "[Configuration] Fallback to /opt/crankshaft/crankshaft_default_env.sh)";
-        while(inFile2.good())
-        {
-            getline(inFile2,line); // get line from file
-            if (line[0] != '#') {
-                pos=line.find(searchString.toStdString()); // search
-                if(pos!=std::string::npos) // string::npos is returned if string is not found
-                {
-                    int equalPosition = line.find("=");
-                    QString value = line.substr(equalPosition + 1).c_str();
-                    value.replace("\"","");
-                    OPENAUTO_LOG(info) << "[Configuration] CS param found: " << searchString.toStdString() << " Value:" << value.toStdString();
-                    return value;
-                }
-            }
-        }
-        return "";
-    } else {
-        OPENAUTO_LOG(warning) << "[Configuration] unable to open cs param file (/boot/crankshaft/crankshaft_env.sh)";
-        OPENAUTO_LOG(warning) << "[Configuration] Fallback to /opt/crankshaft/crankshaft_default_env.sh)";
+    if(fileStore_->findParam(QString::fromStdString(cCSEnvFileName), searchString.toStdString(), value))
+    {
+        return value;
+    }
 
-        while(inFile2.good())
-        {
-            getline(inFile2,line); // get line from file
-            if (line[0] != '#') {
-                pos=line.find(searchString.toStdString()); // search
-                if(pos!=std::string::npos) // string::npos is returned if string is not found
-                {
-                    int equalPosition = line.find("=");
-                    QString value = line.substr(equalPosition + 1).c_str();
-                    value.replace("\"","");
-                    OPENAUTO_LOG(info) << "[Configuration] CS param found: " << searchString.toStdString() << " Value:" << value.toStdString();
-                    return value;
-                }
-            }
-        }
-        return "";
+    if(fileStore_->findParam(QString::fromStdString(cCSDefaultEnvFileName), searchString.toStdString(), value))
+    {
+        OPENAUTO_LOG(debug) << "[Configuration] CS param " << searchString.toStdString() << " taken from fallback file " << cCSDefaultEnvFileName;
+        return value;
     }
+
+    OPENAUTO_LOG(warning) << "[Configuration] unable to find cs param: " << searchString.toStdString();
+    return "";
 }
 
 QString Configuration::getParamFromFile(QString fileName, QString searchString) const
 {
-    OPENAUTO_LOG(info) << "[Configuration] Request param from file: " << fileName.toStdString() << " param: " << searchString.toStdString();
-    using namespace std;
-    ifstream inFile;
-    string line;
     if (!searchString.contains("dtoverlay")) {
         searchString = searchString.append("=");
     }
-    inFile.open(fileName.toStdString());
-
-    size_t pos;
 
-    if(inFile) {
-        while(inFile.good())
-        {
-            getline(inFile,line); // get line from file
-            if (line[0] != '#') {
-                pos=line.find(searchString.toStdString()); // search
-                if(pos!=std::string::npos) // string::npos is returned if string is not found
-                {
-                    int equalPosition = line.find("=");
-                    QString value = line.substr(equalPosition + 1).c_str();
-                    value.replace("\"","");
-                    OPENAUTO_LOG(info) << "[Configuration] Param from file: " << fileName.toStdString() << " found: " << searchString.toStdString() << " Value:" << value.toStdString();
-                    return value;
-                }
-            }
-        }
-        return "";
-    } else {
-        return "";
-    }
+    QString value;
+    fileStore_->findParam(fileName, searchString.toStdString(), value);
+    return value;
 }
 
 QString Configuration::readFileContent(QString fileName) const
 {
-    using namespace std;
-    ifstream inFile;
-    string line;
-    inFile.open(fileName.toStdString());
-    string result = "";
-    if(inFile) {
-        while(inFile.good())
-        {
-            getline(inFile,line); // get line from file
-            result.append(line);
-        }
-        return result.c_str();
-    } else {
-        return "";
-    }
+    return fileStore_->readContent(fileName);
+}
+
+FileStore::Pointer Configuration::getFileStore() const
+{
+    return fileStore_;
 }
 
-void Configuration::readButtonCodes(boost::property_tree::ptree& iniConfig)
+void Configuration::readButtonCodes(const boost::property_tree::ptree& iniConfig)
 {
     this->insertButtonCode(iniConfig, cInputPlayButtonKey, aasdk::proto::enums::ButtonCode::PLAY);
     this->insertButtonCode(iniConfig, cInputPauseButtonKey, aasdk::proto::enums::ButtonCode::PAUSE);
@@ -702,7 +1128,7 @@ void Configuration::readButtonCodes(boost::property_tree::ptree& iniConfig)
     this->insertButtonCode(iniConfig, cInputNavButtonKey, aasdk::proto::enums::ButtonCode::NAVIGATION);
 }
 
-void Configuration::insertButtonCode(boost::property_tree::ptree& iniConfig, const std::string& buttonCodeKey, aasdk::proto::enums::ButtonCode::Enum buttonCode)
+void Configuration::insertButtonCode(const boost::property_tree::ptree& iniConfig, const std::string& buttonCodeKey, aasdk::proto::enums::ButtonCode::Enum buttonCode)
 {
     if(iniConfig.get<bool>(buttonCodeKey, false))
     {
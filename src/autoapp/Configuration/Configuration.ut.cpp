@@ -0,0 +1,142 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <boost/test/unit_test.hpp>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <f1x/openauto/autoapp/Configuration/Configuration.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace configuration
+{
+namespace ut
+{
+
+class ConfigurationDirectoryFixture
+{
+public:
+    ConfigurationDirectoryFixture()
+        : previousDirectory_(QDir::currentPath())
+    {
+        // the configuration lives in the working directory
+        BOOST_REQUIRE(directory_.isValid());
+        QDir::setCurrent(directory_.path());
+    }
+
+    ~ConfigurationDirectoryFixture()
+    {
+        QDir::setCurrent(previousDirectory_);
+    }
+
+private:
+    QString previousDirectory_;
+    QTemporaryDir directory_;
+};
+
+void writeAlphaTrans(size_t value)
+{
+    std::ofstream("openauto.ini") << "[General]" << std::endl << "AlphaTrans=" << value << std::endl;
+}
+
+// the way editors save: a new file renamed over the old one
+void replaceAlphaTrans(size_t value)
+{
+    std::ofstream("openauto.ini.edit") << "[General]" << std::endl << "AlphaTrans=" << value << std::endl;
+    BOOST_REQUIRE(std::rename("openauto.ini.edit", "openauto.ini") == 0);
+}
+
+bool waitFor(const std::function<bool()>& condition)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while(!condition())
+    {
+        if(timer.elapsed() > 5000)
+        {
+            return false;
+        }
+
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+        usleep(10000);
+    }
+
+    return true;
+}
+
+void settle()
+{
+    QElapsedTimer timer;
+    timer.start();
+    waitFor([&timer]() { return timer.elapsed() > 300; });
+}
+
+BOOST_FIXTURE_TEST_CASE(Configuration_SeesEveryExternalEdit, ConfigurationDirectoryFixture)
+{
+    writeAlphaTrans(10);
+    Configuration configuration;
+    BOOST_CHECK_EQUAL(configuration.getAlphaTrans(), 10u);
+
+    replaceAlphaTrans(20);
+    BOOST_CHECK(waitFor([&]() { return configuration.getAlphaTrans() == 20; }));
+    settle();
+
+    writeAlphaTrans(30);
+    BOOST_CHECK(waitFor([&]() { return configuration.getAlphaTrans() == 30; }));
+    settle();
+
+    replaceAlphaTrans(40);
+    BOOST_CHECK(waitFor([&]() { return configuration.getAlphaTrans() == 40; }));
+}
+
+BOOST_FIXTURE_TEST_CASE(Configuration_SeesExternalEditAfterPersist, ConfigurationDirectoryFixture)
+{
+    writeAlphaTrans(10);
+    Configuration configuration;
+
+    configuration.setAlphaTrans(20);
+    configuration.save();
+    configuration.flush();
+    settle();
+    BOOST_CHECK_EQUAL(configuration.getAlphaTrans(), 20u);
+
+    writeAlphaTrans(30);
+    BOOST_CHECK(waitFor([&]() { return configuration.getAlphaTrans() == 30; }));
+    settle();
+
+    replaceAlphaTrans(40);
+    BOOST_CHECK(waitFor([&]() { return configuration.getAlphaTrans() == 40; }));
+}
+
+}
+}
+}
+}
+}
+}
@@ -0,0 +1,291 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <fstream>
+#include <QThread>
+#include <QFileInfo>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Configuration/FileStore.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace configuration
+{
+
+FileStore::Entry::Entry(const QString& fileName)
+    : fileName(fileName.toStdString())
+    , size(-1)
+    , exists(false)
+    , valid(false)
+    , watched(false)
+    , changed(false)
+{
+
+}
+
+void FileStore::Entry::refresh(bool force)
+{
+    QFileInfo fileInfo(QString::fromStdString(fileName));
+
+    if(!fileInfo.exists())
+    {
+        exists = false;
+        content.clear();
+        lines.clear();
+        values.clear();
+        return;
+    }
+
+    if(force || !exists || fileInfo.lastModified() != lastModified || fileInfo.size() != size)
+    {
+        lastModified = fileInfo.lastModified();
+        size = fileInfo.size();
+        this->parse();
+    }
+
+    exists = true;
+}
+
+void FileStore::Entry::parse()
+{
+    content.clear();
+    lines.clear();
+    values.clear();
+
+    std::ifstream inFile(fileName);
+    std::string line;
+
+    while(std::getline(inFile, line))
+    {
+        content.append(line);
+
+        if(line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        const auto equalPosition = line.find('=');
+        if(equalPosition != std::string::npos)
+        {
+            auto key = line.substr(0, equalPosition);
+            key.erase(0, key.find_first_not_of(" \t"));
+            key.erase(key.find_last_not_of(" \t") + 1);
+
+            // first occurrence wins, same as the former line-by-line scan
+            values.emplace(std::move(key), line.substr(equalPosition + 1));
+        }
+
+        lines.push_back(std::move(line));
+    }
+
+    OPENAUTO_LOG(info) << "[FileStore] parsed " << fileName << ", entries: " << values.size();
+}
+
+bool FileStore::Entry::find(const std::string& searchString, QString& value) const
+{
+    std::string rawValue;
+    bool found = false;
+
+    if(!searchString.empty() && searchString.back() == '=')
+    {
+        const auto it = values.find(searchString.substr(0, searchString.size() - 1));
+        if(it != values.end())
+        {
+            rawValue = it->second;
+            found = true;
+        }
+    }
+
+    if(!found)
+    {
+        // Substring match for lookups like "dtoverlay=i2c-rtc" or "export KEY=".
+        for(const auto& line : lines)
+        {
+            if(line.find(searchString) != std::string::npos)
+            {
+                rawValue = line.substr(line.find('=') + 1);
+                found = true;
+                break;
+            }
+        }
+    }
+
+    if(found)
+    {
+        value = QString::fromStdString(rawValue);
+        value.replace("\"", "");
+    }
+
+    return found;
+}
+
+FileStore::FileStore(QObject* parent)
+    : QObject(parent)
+{
+    connect(&watcher_, &QFileSystemWatcher::fileChanged, this, &FileStore::onFileChanged);
+    connect(&watcher_, &QFileSystemWatcher::directoryChanged, this, &FileStore::onDirectoryChanged);
+}
+
+bool FileStore::exists(const QString& fileName)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return this->getEntry(fileName).exists;
+}
+
+QString FileStore::readContent(const QString& fileName)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return QString::fromStdString(this->getEntry(fileName).content);
+}
+
+bool FileStore::findParam(const QString& fileName, const std::string& searchString, QString& value)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    auto& entry = this->getEntry(fileName);
+    return entry.exists && entry.find(searchString, value);
+}
+
+FileStore::Entry& FileStore::getEntry(const QString& fileName)
+{
+    auto it = entries_.find(fileName);
+    if(it == entries_.end())
+    {
+        it = entries_.emplace(fileName, Entry(fileName)).first;
+    }
+
+    auto& entry = it->second;
+
+    if(!entry.valid)
+    {
+        if(isVolatile(fileName))
+        {
+            entry.refresh(true);
+        }
+        else
+        {
+            // vfat keeps modification times to 2 seconds, a same-size edit in that window looks unchanged
+            entry.refresh(entry.changed);
+            entry.changed = false;
+            this->addWatch(fileName, entry);
+            entry.valid = entry.watched;
+        }
+    }
+
+    return entry;
+}
+
+void FileStore::addWatch(const QString& fileName, Entry& entry)
+{
+    if(QThread::currentThread() != this->thread())
+    {
+        // QFileSystemWatcher may only be touched from its own thread, until the queued call
+        // lands the entry stays unwatched and is revalidated by modification time on every read.
+        QMetaObject::invokeMethod(this, "watch", Qt::QueuedConnection, Q_ARG(QString, fileName));
+        return;
+    }
+
+    const auto directory = QFileInfo(fileName).absolutePath();
+    if(!watcher_.directories().contains(directory) && QFileInfo(directory).isDir())
+    {
+        watcher_.addPath(directory);
+    }
+
+    // files are dropped from the watcher when deleted or replaced, so re-add them on every load
+    if(entry.exists && !watcher_.files().contains(fileName))
+    {
+        watcher_.addPath(fileName);
+    }
+
+    entry.watched = watcher_.directories().contains(directory);
+}
+
+void FileStore::watch(const QString& fileName)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    auto it = entries_.find(fileName);
+    if(it != entries_.end())
+    {
+        this->addWatch(fileName, it->second);
+    }
+}
+
+void FileStore::onFileChanged(const QString& fileName)
+{
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+        auto it = entries_.find(fileName);
+        if(it == entries_.end())
+        {
+            return;
+        }
+
+        it->second.valid = false;
+        it->second.changed = true;
+    }
+
+    OPENAUTO_LOG(debug) << "[FileStore] file changed: " << fileName.toStdString();
+    emit fileChanged(fileName);
+}
+
+void FileStore::onDirectoryChanged(const QString& directory)
+{
+    QStringList changedFiles;
+
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+        for(auto& entry : entries_)
+        {
+            if(!entry.second.valid || QFileInfo(entry.first).absolutePath() != directory)
+            {
+                continue;
+            }
+
+            // created, removed, or replaced by a rename which took the file watch with the old inode
+            const bool exists = QFileInfo::exists(entry.first);
+            if(exists != entry.second.exists || (exists && !watcher_.files().contains(entry.first)))
+            {
+                entry.second.valid = false;
+                entry.second.changed = true;
+                changedFiles.append(entry.first);
+            }
+        }
+    }
+
+    for(const auto& fileName : changedFiles)
+    {
+        OPENAUTO_LOG(debug) << "[FileStore] file created, removed or replaced: " << fileName.toStdString();
+        emit fileChanged(fileName);
+    }
+}
+
+bool FileStore::isVolatile(const QString& fileName)
+{
+    return fileName.startsWith("/sys/") || fileName.startsWith("/proc/");
+}
+
+}
+}
+}
+}
@@ -0,0 +1,72 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/autoapp/Projection/ButtonCodeSet.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+ButtonCodeSet::ButtonCodeSet(const IInputDevice::ButtonCodes& buttonCodes)
+{
+    for(const auto& buttonCode : buttonCodes)
+    {
+        this->insert(buttonCode);
+    }
+}
+
+void ButtonCodeSet::insert(aasdk::proto::enums::ButtonCode::Enum buttonCode)
+{
+    const auto index = getIndex(buttonCode);
+    if(index >= 0)
+    {
+        bits_.set(index);
+    }
+}
+
+bool ButtonCodeSet::contains(aasdk::proto::enums::ButtonCode::Enum buttonCode) const
+{
+    const auto index = getIndex(buttonCode);
+    return index >= 0 && bits_.test(index);
+}
+
+int ButtonCodeSet::getIndex(aasdk::proto::enums::ButtonCode::Enum buttonCode)
+{
+    const auto code = static_cast<uint32_t>(buttonCode);
+
+    if(code < cRangeSize)
+    {
+        return code;
+    }
+    else if(code >= aasdk::proto::enums::ButtonCode::SCROLL_WHEEL && code < aasdk::proto::enums::ButtonCode::SCROLL_WHEEL + cRangeSize)
+    {
+        return cRangeSize + code - aasdk::proto::enums::ButtonCode::SCROLL_WHEEL;
+    }
+
+    return -1;
+}
+
+}
+}
+}
+}
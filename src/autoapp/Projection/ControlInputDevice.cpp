@@ -0,0 +1,342 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <boost/algorithm/string.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Projection/ControlInputDevice.hpp>
+#include <f1x/openauto/autoapp/Projection/EvdevInputDevice.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+constexpr std::chrono::milliseconds ControlInputDevice::cAccelerationInterval;
+constexpr int32_t ControlInputDevice::cMaxAcceleration;
+
+ControlInputDevice::EvdevSource::EvdevSource(boost::asio::io_service& ioService)
+    : descriptor(ioService)
+    , relativeDelta(0)
+    , dropped(false)
+{
+
+}
+
+ControlInputDevice::ControlInputDevice(boost::asio::io_service& ioService, configuration::IConfiguration::Pointer configuration, KeyMap::Pointer keyMap, IInputDevice::Pointer inputDevice)
+    : ioService_(ioService)
+    , strand_(ioService)
+    , configuration_(std::move(configuration))
+    , keyMap_(std::move(keyMap))
+    , inputDevice_(std::move(inputDevice))
+    , accelerationEnabled_(configuration_->rotaryAccelerationEnabled())
+    , eventHandler_(nullptr)
+{
+
+}
+
+void ControlInputDevice::start(IInputDeviceEventHandler& eventHandler)
+{
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        eventHandler_ = &eventHandler;
+    }
+
+    // the wrapped device may deliver a button from start(), which dispatch() handles under mutex_
+    inputDevice_->start(*this);
+
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        buttonCodes_ = ButtonCodeSet(inputDevice_->getSupportedButtonCodes());
+
+#ifdef USE_GPIO_ROTARY
+        const bool opened = !evdevSources_.empty() || rotaryEncoder_ != nullptr;
+#else
+        const bool opened = !evdevSources_.empty();
+#endif
+        if(!opened)
+        {
+            this->open();
+        }
+    });
+}
+
+void ControlInputDevice::stop()
+{
+    inputDevice_->stop();
+
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        eventHandler_ = nullptr;
+    }
+
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        OPENAUTO_LOG(info) << "[ControlInputDevice] stop.";
+
+        // sources stay allocated, reads completed before the close may still be queued
+        for(auto& source : evdevSources_)
+        {
+            boost::system::error_code ec;
+            source->descriptor.close(ec);
+        }
+
+#ifdef USE_GPIO_ROTARY
+        if(rotaryEncoder_ != nullptr)
+        {
+            rotaryEncoder_->close();
+        }
+#endif
+    });
+}
+
+IInputDevice::ButtonCodes ControlInputDevice::getSupportedButtonCodes() const
+{
+    return inputDevice_->getSupportedButtonCodes();
+}
+
+bool ControlInputDevice::hasTouchscreen() const
+{
+    return inputDevice_->hasTouchscreen();
+}
+
+QRect ControlInputDevice::getTouchscreenGeometry() const
+{
+    return inputDevice_->getTouchscreenGeometry();
+}
+
+void ControlInputDevice::onButtonEvent(const ButtonEvent& event)
+{
+    this->dispatch(event);
+}
+
+void ControlInputDevice::onTouchEvent(const TouchEvent& event)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(eventHandler_ != nullptr)
+    {
+        eventHandler_->onTouchEvent(event);
+    }
+}
+
+void ControlInputDevice::open()
+{
+    std::vector<std::string> devicePaths;
+    boost::split(devicePaths, configuration_->getControlDevices(), boost::is_any_of(","));
+
+    for(auto& devicePath : devicePaths)
+    {
+        boost::trim(devicePath);
+        if(!devicePath.empty())
+        {
+            this->openEvdevSource(devicePath);
+        }
+    }
+
+    const auto chipPath = configuration_->getRotaryGpioChip();
+    if(!chipPath.empty())
+    {
+#ifdef USE_GPIO_ROTARY
+        rotaryEncoder_ = std::make_shared<GpioRotaryEncoder>(ioService_, strand_, [this](int32_t detents, std::chrono::steady_clock::time_point eventTime) {
+            this->turnWheel(detents, eventTime);
+        });
+        rotaryEncoder_->open(chipPath, configuration_->getRotaryGpioLineA(), configuration_->getRotaryGpioLineB());
+#else
+        OPENAUTO_LOG(error) << "[ControlInputDevice] built without GPIO v2 support, the rotary encoder on " << chipPath << " is not read.";
+#endif
+    }
+}
+
+void ControlInputDevice::openEvdevSource(const std::string& devicePath)
+{
+    const int fd = ::open(devicePath.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if(fd < 0)
+    {
+        OPENAUTO_LOG(error) << "[ControlInputDevice] unable to open " << devicePath << ": " << strerror(errno);
+        return;
+    }
+
+    EvdevInputDevice::useMonotonicClock(fd);
+
+    // keep the same keys from also reaching Qt through its evdev keyboard plugin
+    if(ioctl(fd, EVIOCGRAB, 1) < 0)
+    {
+        OPENAUTO_LOG(warning) << "[ControlInputDevice] unable to grab " << devicePath << ": " << strerror(errno);
+    }
+
+    evdevSources_.emplace_back(std::make_unique<EvdevSource>(ioService_));
+    evdevSources_.back()->descriptor.assign(fd);
+    // keys held while opening are taken as down already, their release is still sent
+    EvdevInputDevice::readKeys(fd, evdevSources_.back()->keys);
+    OPENAUTO_LOG(info) << "[ControlInputDevice] reading controls from " << devicePath;
+
+    this->read(*evdevSources_.back());
+}
+
+void ControlInputDevice::read(EvdevSource& source)
+{
+    source.descriptor.async_read_some(boost::asio::buffer(source.events), strand_.wrap([this, self = this->shared_from_this(), &source](const boost::system::error_code& e, size_t size) {
+        if(e)
+        {
+            if(e != boost::asio::error::operation_aborted)
+            {
+                OPENAUTO_LOG(error) << "[ControlInputDevice] read failed: " << e.message();
+            }
+            return;
+        }
+
+        if(source.descriptor.is_open())
+        {
+            this->handleEvents(source, size / sizeof(input_event));
+            this->read(source);
+        }
+    }));
+}
+
+void ControlInputDevice::handleEvents(EvdevSource& source, size_t count)
+{
+    for(size_t i = 0; i < count; ++i)
+    {
+        const auto& event = source.events[i];
+
+        if(event.type == EV_SYN && event.code == SYN_DROPPED)
+        {
+            // skip to the report that ends the gap, then catch up with the keys of the device
+            source.dropped = true;
+        }
+        else if(source.dropped)
+        {
+            if(event.type == EV_SYN && event.code == SYN_REPORT)
+            {
+                source.dropped = false;
+                this->readKeys(source, event);
+            }
+        }
+        else if(event.type == EV_KEY)
+        {
+            if(event.code < KEY_CNT && event.value != 2)
+            {
+                source.keys[event.code] = event.value != 0;
+            }
+            this->handleKey(event);
+        }
+        else if(event.type == EV_REL && (event.code == REL_DIAL || event.code == REL_WHEEL))
+        {
+            source.relativeDelta += event.value;
+        }
+        else if(event.type == EV_SYN && event.code == SYN_REPORT && source.relativeDelta != 0)
+        {
+            this->turnWheel(source.relativeDelta, EvdevInputDevice::getEventTime(event));
+            source.relativeDelta = 0;
+        }
+    }
+}
+
+void ControlInputDevice::readKeys(EvdevSource& source, const input_event& report)
+{
+    std::bitset<KEY_CNT> keys;
+    if(!EvdevInputDevice::readKeys(source.descriptor.native_handle(), keys))
+    {
+        OPENAUTO_LOG(warning) << "[ControlInputDevice] unable to read the key state: " << strerror(errno);
+        return;
+    }
+
+    // presses and releases lost in the drop are sent with the time of the report that ended it
+    const auto changed = keys ^ source.keys;
+    source.keys = keys;
+
+    for(size_t code = 0; code < KEY_CNT; ++code)
+    {
+        if(changed[code])
+        {
+            input_event event = report;
+            event.type = EV_KEY;
+            event.code = static_cast<uint16_t>(code);
+            event.value = keys[code] ? 1 : 0;
+            this->handleKey(event);
+        }
+    }
+}
+
+void ControlInputDevice::handleKey(const input_event& event)
+{
+    const auto* binding = keyMap_->getEvdevBinding(event.code);
+
+    // value 2 is autorepeat
+    if(binding == nullptr || event.value == 2)
+    {
+        return;
+    }
+
+    if(binding->wheelDirection != WheelDirection::NONE)
+    {
+        if(event.value == 0)
+        {
+            this->turnWheel(binding->wheelDirection == WheelDirection::LEFT ? -1 : 1, EvdevInputDevice::getEventTime(event));
+        }
+    }
+    else if(buttonCodes_.contains(binding->code))
+    {
+        this->dispatch({event.value != 0 ? ButtonEventType::PRESS : ButtonEventType::RELEASE, WheelDirection::NONE, binding->code, 1, false, EvdevInputDevice::getEventTime(event)});
+    }
+}
+
+void ControlInputDevice::turnWheel(int32_t steps, std::chrono::steady_clock::time_point eventTime)
+{
+    if(!buttonCodes_.contains(aasdk::proto::enums::ButtonCode::SCROLL_WHEEL))
+    {
+        return;
+    }
+
+    const auto interval = eventTime - lastWheelTime_;
+    lastWheelTime_ = eventTime;
+
+    if(accelerationEnabled_ && interval < cAccelerationInterval)
+    {
+        // the faster the knob spins, the further each detent scrolls
+        const auto factor = cAccelerationInterval / std::max<std::chrono::steady_clock::duration>(interval, std::chrono::milliseconds(1));
+        steps *= static_cast<int32_t>(std::min<decltype(factor)>(cMaxAcceleration, factor));
+    }
+
+    this->dispatch({ButtonEventType::NONE, steps < 0 ? WheelDirection::LEFT : WheelDirection::RIGHT, aasdk::proto::enums::ButtonCode::SCROLL_WHEEL,
+                    static_cast<uint32_t>(std::abs(steps)), false, eventTime});
+}
+
+void ControlInputDevice::dispatch(const ButtonEvent& event)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(eventHandler_ != nullptr)
+    {
+        eventHandler_->onButtonEvent(event);
+    }
+}
+
+}
+}
+}
+}
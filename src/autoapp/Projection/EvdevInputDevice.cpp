@@ -0,0 +1,351 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <ctime>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Projection/EvdevInputDevice.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+namespace
+{
+
+constexpr size_t cBitsPerLong = sizeof(unsigned long) * 8;
+
+bool testBit(size_t bit, const unsigned long* bits)
+{
+    return (bits[bit / cBitsPerLong] >> (bit % cBitsPerLong)) & 1;
+}
+
+}
+
+constexpr size_t EvdevInputDevice::cMaxSlots;
+
+EvdevInputDevice::EvdevInputDevice(boost::asio::io_service& ioService, configuration::IConfiguration::Pointer configuration, IInputDevice::Pointer buttonDevice,
+                                   const QRect& touchscreenGeometry, const QRect& videoGeometry)
+    : strand_(ioService)
+    , descriptor_(ioService)
+    , configuration_(std::move(configuration))
+    , buttonDevice_(std::move(buttonDevice))
+    , touchscreenGeometry_(touchscreenGeometry)
+    , videoGeometry_(videoGeometry)
+    , eventHandler_(nullptr)
+{
+
+}
+
+void EvdevInputDevice::start(IInputDeviceEventHandler& eventHandler)
+{
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        eventHandler_ = &eventHandler;
+    }
+
+    // buttonDevice calls back under its own lock, never hold ours while calling into it
+    buttonDevice_->start(*this);
+
+    if(!configuration_->getTouchscreenEnabled())
+    {
+        return;
+    }
+
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        auto devicePath = configuration_->getTouchscreenDevice();
+        if(devicePath.empty())
+        {
+            devicePath = findTouchscreen();
+        }
+
+        if(devicePath.empty())
+        {
+            OPENAUTO_LOG(error) << "[EvdevInputDevice] no touchscreen found in /dev/input.";
+        }
+        else if(!descriptor_.is_open() && this->open(devicePath))
+        {
+            this->read();
+        }
+    });
+}
+
+void EvdevInputDevice::stop()
+{
+    buttonDevice_->stop();
+
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        eventHandler_ = nullptr;
+    }
+
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        OPENAUTO_LOG(info) << "[EvdevInputDevice] stop.";
+        boost::system::error_code ec;
+        descriptor_.close(ec);
+    });
+}
+
+IInputDevice::ButtonCodes EvdevInputDevice::getSupportedButtonCodes() const
+{
+    return buttonDevice_->getSupportedButtonCodes();
+}
+
+bool EvdevInputDevice::hasTouchscreen() const
+{
+    return configuration_->getTouchscreenEnabled();
+}
+
+QRect EvdevInputDevice::getTouchscreenGeometry() const
+{
+    return touchscreenGeometry_;
+}
+
+void EvdevInputDevice::onButtonEvent(const ButtonEvent& event)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(eventHandler_ != nullptr)
+    {
+        eventHandler_->onButtonEvent(event);
+    }
+}
+
+void EvdevInputDevice::onTouchEvent(const TouchEvent&)
+{
+    // the same touch already arrived from the evdev node
+}
+
+std::string EvdevInputDevice::findTouchscreen()
+{
+    for(int i = 0; i < 32; ++i)
+    {
+        const std::string devicePath = "/dev/input/event" + std::to_string(i);
+        const int fd = ::open(devicePath.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if(fd < 0)
+        {
+            continue;
+        }
+
+        unsigned long absBits[ABS_CNT / cBitsPerLong + 1] = {};
+        unsigned long keyBits[KEY_CNT / cBitsPerLong + 1] = {};
+        const bool isTouchscreen = ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits) >= 0
+                && ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) >= 0
+                && ((testBit(ABS_X, absBits) && testBit(ABS_Y, absBits)) || (testBit(ABS_MT_POSITION_X, absBits) && testBit(ABS_MT_POSITION_Y, absBits)))
+                && testBit(BTN_TOUCH, keyBits);
+        ::close(fd);
+
+        if(isTouchscreen)
+        {
+            return devicePath;
+        }
+    }
+
+    return std::string();
+}
+
+bool EvdevInputDevice::useMonotonicClock(int fd)
+{
+    // events are stamped with CLOCK_REALTIME unless asked otherwise
+    int clockId = CLOCK_MONOTONIC;
+    return ioctl(fd, EVIOCSCLOCKID, &clockId) >= 0;
+}
+
+bool EvdevInputDevice::readKeys(int fd, std::bitset<KEY_CNT>& keys)
+{
+    unsigned long keyBits[KEY_CNT / cBitsPerLong + 1] = {};
+    if(ioctl(fd, EVIOCGKEY(sizeof(keyBits)), keyBits) < 0)
+    {
+        return false;
+    }
+
+    for(size_t code = 0; code < KEY_CNT; ++code)
+    {
+        keys[code] = testBit(code, keyBits);
+    }
+    return true;
+}
+
+std::chrono::steady_clock::time_point EvdevInputDevice::getEventTime(const input_event& event)
+{
+    const auto now = std::chrono::steady_clock::now();
+    const std::chrono::steady_clock::time_point eventTime(std::chrono::seconds(event.time.tv_sec) + std::chrono::microseconds(event.time.tv_usec));
+
+    // a kernel without EVIOCSCLOCKID leaves the timestamps on the realtime clock
+    return now >= eventTime && now - eventTime < std::chrono::seconds(1) ? eventTime : now;
+}
+
+bool EvdevInputDevice::open(const std::string& devicePath)
+{
+    const int fd = ::open(devicePath.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if(fd < 0)
+    {
+        OPENAUTO_LOG(error) << "[EvdevInputDevice] unable to open " << devicePath << ": " << strerror(errno);
+        return false;
+    }
+
+    useMonotonicClock(fd);
+
+    unsigned long absBits[ABS_CNT / cBitsPerLong + 1] = {};
+    ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits);
+    const bool multitouch = testBit(ABS_MT_SLOT, absBits) && testBit(ABS_MT_POSITION_X, absBits) && testBit(ABS_MT_POSITION_Y, absBits);
+
+    size_t slotCount = 1;
+    if(multitouch)
+    {
+        input_absinfo slotInfo{};
+        ioctl(fd, EVIOCGABS(ABS_MT_SLOT), &slotInfo);
+        slotCount = std::min<size_t>(cMaxSlots, std::max(0, slotInfo.maximum) + 1);
+    }
+
+    touchState_.reset(multitouch, slotCount,
+                      this->createAxis(fd, multitouch ? ABS_MT_POSITION_X : ABS_X, videoGeometry_.width()),
+                      this->createAxis(fd, multitouch ? ABS_MT_POSITION_Y : ABS_Y, videoGeometry_.height()));
+
+    // fingers already on the panel, e.g. when the device comes back after a reconnect
+    this->readState(fd);
+
+    descriptor_.assign(fd);
+    OPENAUTO_LOG(info) << "[EvdevInputDevice] reading touches from " << devicePath << (multitouch ? ", slots: " + std::to_string(slotCount) : ", single touch");
+    return true;
+}
+
+EvdevTouchState::Axis EvdevInputDevice::createAxis(int fd, int code, int size) const
+{
+    input_absinfo info{};
+    if(ioctl(fd, EVIOCGABS(code), &info) < 0 || info.maximum <= info.minimum)
+    {
+        return EvdevTouchState::Axis{1.0f, 0.0f, size - 1};
+    }
+
+    const float scale = static_cast<float>(size) / (info.maximum - info.minimum + 1);
+    return EvdevTouchState::Axis{scale, -info.minimum * scale, size - 1};
+}
+
+void EvdevInputDevice::readState(int fd)
+{
+    if(!touchState_.isMultitouch())
+    {
+        std::bitset<KEY_CNT> keys;
+        input_absinfo x{};
+        input_absinfo y{};
+        if(readKeys(fd, keys) && ioctl(fd, EVIOCGABS(ABS_X), &x) >= 0 && ioctl(fd, EVIOCGABS(ABS_Y), &y) >= 0)
+        {
+            touchState_.setContact(0, keys[BTN_TOUCH] ? 0 : -1, x.value, y.value);
+        }
+        return;
+    }
+
+    input_absinfo slotInfo{};
+    if(ioctl(fd, EVIOCGABS(ABS_MT_SLOT), &slotInfo) >= 0)
+    {
+        touchState_.setCurrentSlot(static_cast<size_t>(std::max(0, slotInfo.value)));
+    }
+
+    // EVIOCGMTSLOTS takes the axis code in the first word and returns one value per slot after it
+    const auto slotCount = touchState_.getSlotCount();
+    std::vector<int32_t> trackingIds(slotCount + 1);
+    std::vector<int32_t> positionsX(slotCount + 1);
+    std::vector<int32_t> positionsY(slotCount + 1);
+    trackingIds[0] = ABS_MT_TRACKING_ID;
+    positionsX[0] = ABS_MT_POSITION_X;
+    positionsY[0] = ABS_MT_POSITION_Y;
+
+    const auto size = trackingIds.size() * sizeof(int32_t);
+    if(ioctl(fd, EVIOCGMTSLOTS(size), trackingIds.data()) < 0 || ioctl(fd, EVIOCGMTSLOTS(size), positionsX.data()) < 0
+            || ioctl(fd, EVIOCGMTSLOTS(size), positionsY.data()) < 0)
+    {
+        OPENAUTO_LOG(warning) << "[EvdevInputDevice] unable to read the touch slots: " << strerror(errno);
+        return;
+    }
+
+    for(size_t i = 0; i < slotCount; ++i)
+    {
+        touchState_.setContact(i, trackingIds[i + 1], positionsX[i + 1], positionsY[i + 1]);
+    }
+}
+
+void EvdevInputDevice::read()
+{
+    descriptor_.async_read_some(boost::asio::buffer(events_), strand_.wrap([this, self = this->shared_from_this()](const boost::system::error_code& e, size_t size) {
+        if(e)
+        {
+            if(e != boost::asio::error::operation_aborted)
+            {
+                OPENAUTO_LOG(error) << "[EvdevInputDevice] read failed: " << e.message();
+            }
+            return;
+        }
+
+        this->handleEvents(size / sizeof(input_event));
+        this->read();
+    }));
+}
+
+void EvdevInputDevice::handleEvents(size_t count)
+{
+    for(size_t i = 0; i < count; ++i)
+    {
+        const auto result = touchState_.handleEvent(events_[i]);
+        if(result == EvdevTouchState::Result::RESYNC)
+        {
+            // events were dropped, catch up with the slots as the device has them now
+            OPENAUTO_LOG(debug) << "[EvdevInputDevice] events dropped, reading the touch state.";
+            this->readState(descriptor_.native_handle());
+        }
+
+        if(result != EvdevTouchState::Result::NONE)
+        {
+            this->sendTouchEvents(touchState_.report(), getEventTime(events_[i]));
+        }
+    }
+}
+
+void EvdevInputDevice::sendTouchEvents(std::vector<TouchEvent> events, std::chrono::steady_clock::time_point eventTime)
+{
+    if(events.empty())
+    {
+        return;
+    }
+
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(eventHandler_ != nullptr)
+    {
+        for(auto& event : events)
+        {
+            event.timestamp = eventTime;
+            eventHandler_->onTouchEvent(event);
+        }
+    }
+}
+
+}
+}
+}
+}
@@ -0,0 +1,200 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <algorithm>
+#include <f1x/openauto/autoapp/Projection/EvdevTouchState.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+uint32_t EvdevTouchState::Axis::map(int32_t value) const
+{
+    const auto mapped = static_cast<int32_t>(std::lround(value * scale + offset));
+    return static_cast<uint32_t>(std::min(limit, std::max(0, mapped)));
+}
+
+EvdevTouchState::EvdevTouchState()
+    : axisX_{1.0f, 0.0f, 0}
+    , axisY_{1.0f, 0.0f, 0}
+    , multitouch_(false)
+    , slot_(0)
+    , dropped_(false)
+{
+
+}
+
+void EvdevTouchState::reset(bool multitouch, size_t slotCount, const Axis& axisX, const Axis& axisY)
+{
+    axisX_ = axisX;
+    axisY_ = axisY;
+    multitouch_ = multitouch;
+    slots_.assign(multitouch ? std::max<size_t>(slotCount, 1) : 1, Slot{-1, -1, 0, 0, false, false});
+    slot_ = 0;
+    dropped_ = false;
+    tracker_.reset();
+}
+
+bool EvdevTouchState::isMultitouch() const
+{
+    return multitouch_;
+}
+
+size_t EvdevTouchState::getSlotCount() const
+{
+    return slots_.size();
+}
+
+EvdevTouchState::Result EvdevTouchState::handleEvent(const input_event& event)
+{
+    if(event.type == EV_SYN)
+    {
+        if(event.code == SYN_DROPPED)
+        {
+            // the kernel buffer overflowed, the events up to the next report are incomplete
+            dropped_ = true;
+        }
+        else if(event.code == SYN_REPORT)
+        {
+            const auto result = dropped_ ? Result::RESYNC : Result::REPORT;
+            dropped_ = false;
+            return result;
+        }
+    }
+    else if(dropped_)
+    {
+        return Result::NONE;
+    }
+    else if(multitouch_ && event.type == EV_ABS)
+    {
+        switch(event.code)
+        {
+        case ABS_MT_SLOT:
+            slot_ = static_cast<size_t>(std::max(0, event.value));
+            break;
+        case ABS_MT_TRACKING_ID:
+            if(slot_ < slots_.size())
+            {
+                slots_[slot_].trackingId = event.value;
+            }
+            break;
+        case ABS_MT_POSITION_X:
+        case ABS_MT_POSITION_Y:
+            if(slot_ < slots_.size())
+            {
+                (event.code == ABS_MT_POSITION_X ? slots_[slot_].x : slots_[slot_].y) = event.value;
+                slots_[slot_].changed = true;
+            }
+            break;
+        }
+    }
+    else if(!multitouch_ && event.type == EV_ABS && (event.code == ABS_X || event.code == ABS_Y))
+    {
+        (event.code == ABS_X ? slots_[0].x : slots_[0].y) = event.value;
+        slots_[0].changed = true;
+    }
+    else if(!multitouch_ && event.type == EV_KEY && event.code == BTN_TOUCH)
+    {
+        slots_[0].trackingId = event.value != 0 ? 0 : -1;
+    }
+
+    return Result::NONE;
+}
+
+std::vector<TouchEvent> EvdevTouchState::report()
+{
+    // a finger lifted and another put down on the same slot, only seen after a resync,
+    // is released in a report of its own before the new contact goes down
+    std::vector<TouchEvent> events;
+    bool replaced = false;
+    for(size_t i = 0; i < slots_.size(); ++i)
+    {
+        auto& slot = slots_[i];
+        if(slot.down && slot.trackingId >= 0 && slot.trackingId != slot.activeId)
+        {
+            tracker_.up(i);
+            slot.down = false;
+            replaced = true;
+        }
+    }
+
+    if(replaced)
+    {
+        events = tracker_.flush();
+    }
+
+    for(size_t i = 0; i < slots_.size(); ++i)
+    {
+        auto& slot = slots_[i];
+        const bool down = slot.trackingId >= 0;
+
+        if(down && !slot.down)
+        {
+            tracker_.down(i, axisX_.map(slot.x), axisY_.map(slot.y));
+        }
+        else if(down && slot.changed)
+        {
+            tracker_.move(i, axisX_.map(slot.x), axisY_.map(slot.y));
+        }
+        else if(!down && slot.down)
+        {
+            tracker_.up(i);
+        }
+
+        slot.down = down;
+        slot.activeId = down ? slot.trackingId : -1;
+        slot.changed = false;
+    }
+
+    auto reported = tracker_.flush();
+    events.insert(events.end(), reported.begin(), reported.end());
+    return events;
+}
+
+void EvdevTouchState::setCurrentSlot(size_t slot)
+{
+    slot_ = slot;
+}
+
+void EvdevTouchState::setContact(size_t slot, int32_t trackingId, int32_t x, int32_t y)
+{
+    if(slot >= slots_.size())
+    {
+        return;
+    }
+
+    auto& contact = slots_[slot];
+    contact.trackingId = trackingId;
+    if(trackingId >= 0 && (contact.x != x || contact.y != y))
+    {
+        contact.x = x;
+        contact.y = y;
+        contact.changed = true;
+    }
+}
+
+}
+}
+}
+}
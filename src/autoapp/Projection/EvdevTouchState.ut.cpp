@@ -0,0 +1,127 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <f1x/openauto/autoapp/Projection/EvdevTouchState.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+namespace ut
+{
+
+class MultitouchFixture
+{
+public:
+    MultitouchFixture()
+    {
+        // device units map 1:1 to video coordinates
+        state_.reset(true, 2, EvdevTouchState::Axis{1.0f, 0.0f, 1023}, EvdevTouchState::Axis{1.0f, 0.0f, 1023});
+    }
+
+protected:
+    EvdevTouchState::Result send(uint16_t type, uint16_t code, int32_t value)
+    {
+        input_event event{};
+        event.type = type;
+        event.code = code;
+        event.value = value;
+        return state_.handleEvent(event);
+    }
+
+    EvdevTouchState state_;
+};
+
+BOOST_FIXTURE_TEST_CASE(EvdevTouchState_ContactDownAtOpen, MultitouchFixture)
+{
+    // the device reports slot 1 as current with a finger on it
+    state_.setCurrentSlot(1);
+    state_.setContact(1, 7, 100, 200);
+
+    send(EV_ABS, ABS_MT_POSITION_X, 110);
+    BOOST_REQUIRE(send(EV_SYN, SYN_REPORT, 0) == EvdevTouchState::Result::REPORT);
+
+    const auto events = state_.report();
+    BOOST_REQUIRE_EQUAL(events.size(), 1u);
+    BOOST_CHECK_EQUAL(events[0].type, aasdk::proto::enums::TouchAction::PRESS);
+    BOOST_REQUIRE_EQUAL(events[0].pointers.size(), 1u);
+    BOOST_CHECK_EQUAL(events[0].pointers[0].x, 110u);
+    BOOST_CHECK_EQUAL(events[0].pointers[0].y, 200u);
+}
+
+BOOST_FIXTURE_TEST_CASE(EvdevTouchState_LiftDuringDrop, MultitouchFixture)
+{
+    send(EV_ABS, ABS_MT_SLOT, 0);
+    send(EV_ABS, ABS_MT_TRACKING_ID, 3);
+    send(EV_ABS, ABS_MT_POSITION_X, 100);
+    send(EV_ABS, ABS_MT_POSITION_Y, 200);
+    BOOST_REQUIRE(send(EV_SYN, SYN_REPORT, 0) == EvdevTouchState::Result::REPORT);
+    BOOST_REQUIRE_EQUAL(state_.report().size(), 1u);
+
+    // the finger lifts while the kernel buffer overflows, only part of the gap is delivered
+    send(EV_SYN, SYN_DROPPED, 0);
+    send(EV_ABS, ABS_MT_POSITION_X, 120);
+    BOOST_REQUIRE(send(EV_SYN, SYN_REPORT, 0) == EvdevTouchState::Result::RESYNC);
+
+    // the device state read after the drop has no contacts left
+    state_.setContact(0, -1, 120, 200);
+    state_.setContact(1, -1, 0, 0);
+
+    const auto events = state_.report();
+    BOOST_REQUIRE_EQUAL(events.size(), 1u);
+    BOOST_CHECK_EQUAL(events[0].type, aasdk::proto::enums::TouchAction::RELEASE);
+    BOOST_REQUIRE_EQUAL(events[0].pointers.size(), 1u);
+    BOOST_CHECK_EQUAL(events[0].pointers[0].x, 100u);
+    BOOST_CHECK_EQUAL(events[0].pointers[0].y, 200u);
+}
+
+BOOST_FIXTURE_TEST_CASE(EvdevTouchState_ContactReplacedDuringDrop, MultitouchFixture)
+{
+    send(EV_ABS, ABS_MT_SLOT, 0);
+    send(EV_ABS, ABS_MT_TRACKING_ID, 3);
+    send(EV_ABS, ABS_MT_POSITION_X, 100);
+    send(EV_ABS, ABS_MT_POSITION_Y, 200);
+    send(EV_SYN, SYN_REPORT, 0);
+    state_.report();
+
+    send(EV_SYN, SYN_DROPPED, 0);
+    BOOST_REQUIRE(send(EV_SYN, SYN_REPORT, 0) == EvdevTouchState::Result::RESYNC);
+
+    // another finger went down on the same slot in the gap
+    state_.setContact(0, 4, 300, 400);
+    state_.setContact(1, -1, 0, 0);
+
+    const auto events = state_.report();
+    BOOST_REQUIRE_EQUAL(events.size(), 2u);
+    BOOST_CHECK_EQUAL(events[0].type, aasdk::proto::enums::TouchAction::RELEASE);
+    BOOST_CHECK_EQUAL(events[1].type, aasdk::proto::enums::TouchAction::PRESS);
+    BOOST_REQUIRE_EQUAL(events[1].pointers.size(), 1u);
+    BOOST_CHECK_EQUAL(events[1].pointers[0].x, 300u);
+    BOOST_CHECK_EQUAL(events[1].pointers[0].y, 400u);
+}
+
+}
+}
+}
+}
+}
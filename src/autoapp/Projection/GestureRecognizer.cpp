@@ -0,0 +1,350 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Projection/GestureRecognizer.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+constexpr std::chrono::milliseconds GestureRecognizer::cTick;
+constexpr size_t GestureRecognizer::cMaxChords;
+constexpr size_t GestureRecognizer::cInvalidIndex;
+
+GestureRecognizer::GestureRecognizer(KeyMap::Pointer keyMap, EventHandler eventHandler)
+    : keyMap_(std::move(keyMap))
+    , eventHandler_(std::move(eventHandler))
+    , buttonCount_(0)
+    , chordCount_(0)
+{
+    for(const auto& gesture : keyMap_->getGestures())
+    {
+        const auto index = this->addButton(gesture.trigger);
+        if(index == cInvalidIndex)
+        {
+            OPENAUTO_LOG(warning) << "[GestureRecognizer] too many gesture buttons, ignoring " << gesture.trigger;
+            continue;
+        }
+
+        if(gesture.type == GestureType::LONG_PRESS)
+        {
+            buttons_[index].longPressCode = gesture.target;
+        }
+        else if(gesture.type == GestureType::DOUBLE_PRESS)
+        {
+            buttons_[index].doublePressCode = gesture.target;
+        }
+        else
+        {
+            const auto partner = this->addButton(gesture.partner);
+            if(partner == cInvalidIndex || partner == index || chordCount_ == cMaxChords)
+            {
+                OPENAUTO_LOG(warning) << "[GestureRecognizer] ignoring chord " << gesture.trigger << " + " << gesture.partner;
+                continue;
+            }
+
+            chords_[chordCount_++] = {index, partner, gesture.target};
+            buttons_[index].chordMember = true;
+            buttons_[partner].chordMember = true;
+        }
+    }
+
+    OPENAUTO_LOG(info) << "[GestureRecognizer] gesture buttons: " << buttonCount_ << ", chords: " << chordCount_;
+}
+
+void GestureRecognizer::onButtonEvent(const ButtonEvent& event, TimePoint now)
+{
+    const auto index = event.type == ButtonEventType::NONE ? cInvalidIndex : this->findButton(event.code);
+    if(index == cInvalidIndex)
+    {
+        eventHandler_(event);
+        return;
+    }
+
+    // a window that closed before this event arrived has to be settled first
+    this->advance(now);
+
+    if(event.type == ButtonEventType::PRESS)
+    {
+        this->handlePress(index, event.timestamp, now);
+    }
+    else
+    {
+        this->handleRelease(index, event.timestamp, now);
+    }
+}
+
+void GestureRecognizer::advance(TimePoint now)
+{
+    while(!timerWheel_.empty() && cursorTime_ + cTick <= now)
+    {
+        cursorTime_ += cTick;
+        timerWheel_.advance([this, now](size_t index) {
+            this->onTimeout(index, now);
+        });
+    }
+}
+
+bool GestureRecognizer::isIdle() const
+{
+    return timerWheel_.empty();
+}
+
+GestureRecognizer::TimePoint GestureRecognizer::getNextTick() const
+{
+    return cursorTime_ + cTick;
+}
+
+void GestureRecognizer::reset()
+{
+    timerWheel_.clear();
+
+    for(size_t i = 0; i < buttonCount_; ++i)
+    {
+        buttons_[i].state = State::IDLE;
+    }
+}
+
+size_t GestureRecognizer::findButton(aasdk::proto::enums::ButtonCode::Enum code) const
+{
+    for(size_t i = 0; i < buttonCount_; ++i)
+    {
+        if(buttons_[i].code == code)
+        {
+            return i;
+        }
+    }
+
+    return cInvalidIndex;
+}
+
+size_t GestureRecognizer::addButton(aasdk::proto::enums::ButtonCode::Enum code)
+{
+    auto index = this->findButton(code);
+
+    if(index == cInvalidIndex && buttonCount_ < buttons_.size())
+    {
+        index = buttonCount_++;
+        buttons_[index] = {code, aasdk::proto::enums::ButtonCode::NONE, aasdk::proto::enums::ButtonCode::NONE, false, State::IDLE, cInvalidIndex, TimePoint()};
+    }
+
+    return index;
+}
+
+size_t GestureRecognizer::getTicks(uint32_t milliseconds) const
+{
+    return (milliseconds + cTick.count() - 1) / cTick.count();
+}
+
+void GestureRecognizer::schedule(size_t index, uint32_t milliseconds, TimePoint now)
+{
+    // an idle wheel is not turned, line its cursor up with the present again
+    if(timerWheel_.empty())
+    {
+        cursorTime_ = now;
+    }
+
+    timerWheel_.schedule(index, this->getTicks(milliseconds));
+}
+
+void GestureRecognizer::handlePress(size_t index, TimePoint eventTime, TimePoint now)
+{
+    auto& button = buttons_[index];
+
+    if(button.state == State::RELEASED)
+    {
+        timerWheel_.cancel(index);
+        button.state = State::SECOND_PRESSED;
+    }
+    else if(button.state == State::IDLE && button.chordMember)
+    {
+        for(size_t i = 0; i < chordCount_; ++i)
+        {
+            const auto& chord = chords_[i];
+            const auto partner = chord.first == index ? chord.second : (chord.second == index ? chord.first : cInvalidIndex);
+
+            if(partner != cInvalidIndex && buttons_[partner].state == State::CHORD_WAIT)
+            {
+                timerWheel_.cancel(partner);
+                buttons_[partner].state = State::CHORD_PRESSED;
+                buttons_[partner].chord = i;
+                button.state = State::CHORD_PRESSED;
+                button.chord = i;
+                this->dispatch(ButtonEventType::PRESS, chord.code, eventTime);
+                return;
+            }
+        }
+
+        // the partner may still follow within the chord time
+        button.state = State::CHORD_WAIT;
+        button.pressTime = eventTime;
+        this->schedule(index, keyMap_->getChordTime(), now);
+    }
+    else if(button.state == State::IDLE)
+    {
+        this->beginPress(index, eventTime, now);
+    }
+}
+
+void GestureRecognizer::handleRelease(size_t index, TimePoint eventTime, TimePoint now)
+{
+    auto& button = buttons_[index];
+
+    switch(button.state)
+    {
+    case State::CHORD_WAIT:
+        timerWheel_.cancel(index);
+        this->beginPress(index, button.pressTime, now);
+        this->handleRelease(index, eventTime, now);
+        break;
+
+    case State::PRESSED:
+        timerWheel_.cancel(index);
+
+        if(button.doublePressCode != aasdk::proto::enums::ButtonCode::NONE)
+        {
+            button.state = State::RELEASED;
+            this->schedule(index, keyMap_->getDoublePressTime(), now);
+        }
+        else
+        {
+            button.state = State::IDLE;
+            this->tap(button.code, eventTime);
+        }
+        break;
+
+    case State::LONG_PRESSED:
+        button.state = State::IDLE;
+        this->dispatch(ButtonEventType::RELEASE, button.longPressCode, eventTime, button.longPressCode == button.code);
+        break;
+
+    case State::SECOND_PRESSED:
+        button.state = State::IDLE;
+        this->tap(button.doublePressCode, eventTime);
+        break;
+
+    case State::PASSED:
+        button.state = State::IDLE;
+        this->dispatch(ButtonEventType::RELEASE, button.code, eventTime);
+        break;
+
+    case State::CHORD_PRESSED:
+    {
+        // the first button to go up ends the chord, the other one is swallowed
+        const auto& chord = chords_[button.chord];
+        auto& partner = buttons_[chord.first == index ? chord.second : chord.first];
+
+        if(partner.state == State::CHORD_PRESSED)
+        {
+            partner.state = State::CHORD_RELEASED;
+        }
+
+        button.state = State::IDLE;
+        this->dispatch(ButtonEventType::RELEASE, chord.code, eventTime);
+        break;
+    }
+
+    case State::CHORD_RELEASED:
+        button.state = State::IDLE;
+        break;
+
+    default:
+        break;
+    }
+}
+
+void GestureRecognizer::beginPress(size_t index, TimePoint eventTime, TimePoint now)
+{
+    auto& button = buttons_[index];
+
+    if(button.longPressCode == aasdk::proto::enums::ButtonCode::NONE && button.doublePressCode == aasdk::proto::enums::ButtonCode::NONE)
+    {
+        button.state = State::PASSED;
+        this->dispatch(ButtonEventType::PRESS, button.code, eventTime);
+        return;
+    }
+
+    // what the press means is known once it is released or held long enough
+    button.state = State::PRESSED;
+    button.pressTime = eventTime;
+
+    if(button.longPressCode != aasdk::proto::enums::ButtonCode::NONE)
+    {
+        // a press that waited out the chord time has been held for that long already
+        const auto held = std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(now - eventTime).count());
+        this->schedule(index, static_cast<uint32_t>(std::max<int64_t>(0, keyMap_->getLongPressTime() - held)), now);
+    }
+}
+
+void GestureRecognizer::onTimeout(size_t index, TimePoint now)
+{
+    auto& button = buttons_[index];
+
+    switch(button.state)
+    {
+    case State::CHORD_WAIT:
+        this->beginPress(index, button.pressTime, now);
+        break;
+
+    case State::PRESSED:
+        button.state = State::LONG_PRESSED;
+
+        if(button.longPressCode == button.code)
+        {
+            // same sequence as an Android key held down: a plain press, then a long one
+            this->dispatch(ButtonEventType::PRESS, button.code, now);
+            this->dispatch(ButtonEventType::PRESS, button.code, now, true);
+        }
+        else
+        {
+            this->dispatch(ButtonEventType::PRESS, button.longPressCode, now);
+        }
+        break;
+
+    case State::RELEASED:
+        button.state = State::IDLE;
+        this->tap(button.code, now);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void GestureRecognizer::dispatch(ButtonEventType type, aasdk::proto::enums::ButtonCode::Enum code, TimePoint eventTime, bool longPress)
+{
+    eventHandler_({type, WheelDirection::NONE, code, 1, longPress, eventTime});
+}
+
+void GestureRecognizer::tap(aasdk::proto::enums::ButtonCode::Enum code, TimePoint eventTime)
+{
+    this->dispatch(ButtonEventType::PRESS, code, eventTime);
+    this->dispatch(ButtonEventType::RELEASE, code, eventTime);
+}
+
+}
+}
+}
+}
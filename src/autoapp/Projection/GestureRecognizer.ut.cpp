@@ -0,0 +1,219 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <f1x/openauto/autoapp/Projection/GestureRecognizer.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+namespace ut
+{
+
+using aasdk::proto::enums::ButtonCode;
+
+class GestureRecognizerFixture
+{
+public:
+    GestureRecognizerFixture()
+        : start_(std::chrono::steady_clock::now())
+    {
+        const std::string fileName("GestureRecognizer.ut.ini");
+        std::ofstream(fileName) << "[Gestures]" << std::endl
+                                << "LongPressTime=700" << std::endl
+                                << "DoublePressTime=300" << std::endl
+                                << "ChordTime=80" << std::endl
+                                << "long HOME=MICROPHONE_1" << std::endl
+                                << "double PHONE=CALL_END" << std::endl
+                                << "chord LEFT RIGHT=NAVIGATION" << std::endl
+                                << "long LEFT=BACK" << std::endl;
+
+        auto keyMap(std::make_shared<KeyMap>());
+        keyMap->load(fileName);
+        std::remove(fileName.c_str());
+
+        recognizer_ = std::make_unique<GestureRecognizer>(std::move(keyMap), [this](const ButtonEvent& event) {
+            events_.push_back(event);
+        });
+    }
+
+protected:
+    GestureRecognizer::TimePoint at(int64_t milliseconds) const
+    {
+        return start_ + std::chrono::milliseconds(milliseconds);
+    }
+
+    void press(ButtonCode::Enum code, int64_t milliseconds)
+    {
+        recognizer_->onButtonEvent({ButtonEventType::PRESS, WheelDirection::NONE, code, 1, false, this->at(milliseconds)}, this->at(milliseconds));
+    }
+
+    void release(ButtonCode::Enum code, int64_t milliseconds)
+    {
+        recognizer_->onButtonEvent({ButtonEventType::RELEASE, WheelDirection::NONE, code, 1, false, this->at(milliseconds)}, this->at(milliseconds));
+    }
+
+    void advance(int64_t milliseconds)
+    {
+        recognizer_->advance(this->at(milliseconds));
+    }
+
+    void checkEvent(size_t index, ButtonEventType type, ButtonCode::Enum code, bool longPress = false) const
+    {
+        BOOST_REQUIRE_GT(events_.size(), index);
+        BOOST_CHECK(events_[index].type == type);
+        BOOST_CHECK_EQUAL(events_[index].code, code);
+        BOOST_CHECK_EQUAL(events_[index].longPress, longPress);
+    }
+
+    GestureRecognizer::TimePoint start_;
+    std::unique_ptr<GestureRecognizer> recognizer_;
+    std::vector<ButtonEvent> events_;
+};
+
+BOOST_FIXTURE_TEST_CASE(GestureRecognizer_Tap, GestureRecognizerFixture)
+{
+    press(ButtonCode::HOME, 0);
+    BOOST_CHECK(events_.empty());
+
+    release(ButtonCode::HOME, 100);
+    BOOST_REQUIRE_EQUAL(events_.size(), 2u);
+    checkEvent(0, ButtonEventType::PRESS, ButtonCode::HOME);
+    checkEvent(1, ButtonEventType::RELEASE, ButtonCode::HOME);
+    BOOST_CHECK(recognizer_->isIdle());
+}
+
+BOOST_FIXTURE_TEST_CASE(GestureRecognizer_PassThrough, GestureRecognizerFixture)
+{
+    press(ButtonCode::ENTER, 0);
+    release(ButtonCode::ENTER, 50);
+
+    BOOST_REQUIRE_EQUAL(events_.size(), 2u);
+    checkEvent(0, ButtonEventType::PRESS, ButtonCode::ENTER);
+    checkEvent(1, ButtonEventType::RELEASE, ButtonCode::ENTER);
+}
+
+BOOST_FIXTURE_TEST_CASE(GestureRecognizer_LongPress, GestureRecognizerFixture)
+{
+    press(ButtonCode::HOME, 0);
+    advance(690);
+    BOOST_CHECK(events_.empty());
+
+    advance(700);
+    BOOST_REQUIRE_EQUAL(events_.size(), 1u);
+    checkEvent(0, ButtonEventType::PRESS, ButtonCode::MICROPHONE_1);
+
+    release(ButtonCode::HOME, 900);
+    BOOST_REQUIRE_EQUAL(events_.size(), 2u);
+    checkEvent(1, ButtonEventType::RELEASE, ButtonCode::MICROPHONE_1);
+}
+
+BOOST_FIXTURE_TEST_CASE(GestureRecognizer_DoubleTap, GestureRecognizerFixture)
+{
+    press(ButtonCode::PHONE, 0);
+    release(ButtonCode::PHONE, 50);
+    press(ButtonCode::PHONE, 150);
+    release(ButtonCode::PHONE, 200);
+
+    BOOST_REQUIRE_EQUAL(events_.size(), 2u);
+    checkEvent(0, ButtonEventType::PRESS, ButtonCode::CALL_END);
+    checkEvent(1, ButtonEventType::RELEASE, ButtonCode::CALL_END);
+    BOOST_CHECK(recognizer_->isIdle());
+}
+
+BOOST_FIXTURE_TEST_CASE(GestureRecognizer_SingleTapAfterDoubleTapWindow, GestureRecognizerFixture)
+{
+    press(ButtonCode::PHONE, 0);
+    release(ButtonCode::PHONE, 50);
+    advance(340);
+    BOOST_CHECK(events_.empty());
+
+    advance(350);
+    BOOST_REQUIRE_EQUAL(events_.size(), 2u);
+    checkEvent(0, ButtonEventType::PRESS, ButtonCode::PHONE);
+    checkEvent(1, ButtonEventType::RELEASE, ButtonCode::PHONE);
+}
+
+BOOST_FIXTURE_TEST_CASE(GestureRecognizer_Chord, GestureRecognizerFixture)
+{
+    press(ButtonCode::LEFT, 0);
+    press(ButtonCode::RIGHT, 40);
+    BOOST_REQUIRE_EQUAL(events_.size(), 1u);
+    checkEvent(0, ButtonEventType::PRESS, ButtonCode::NAVIGATION);
+
+    // the first release ends the chord, the second is swallowed
+    release(ButtonCode::RIGHT, 300);
+    release(ButtonCode::LEFT, 320);
+    BOOST_REQUIRE_EQUAL(events_.size(), 2u);
+    checkEvent(1, ButtonEventType::RELEASE, ButtonCode::NAVIGATION);
+    BOOST_CHECK(recognizer_->isIdle());
+}
+
+BOOST_FIXTURE_TEST_CASE(GestureRecognizer_ChordTimeoutFallsBackToPress, GestureRecognizerFixture)
+{
+    press(ButtonCode::RIGHT, 0);
+    advance(70);
+    BOOST_CHECK(events_.empty());
+
+    // the partner did not follow within the chord time
+    advance(80);
+    BOOST_REQUIRE_EQUAL(events_.size(), 1u);
+    checkEvent(0, ButtonEventType::PRESS, ButtonCode::RIGHT);
+    BOOST_CHECK(events_[0].timestamp == at(0));
+
+    release(ButtonCode::RIGHT, 200);
+    BOOST_REQUIRE_EQUAL(events_.size(), 2u);
+    checkEvent(1, ButtonEventType::RELEASE, ButtonCode::RIGHT);
+}
+
+BOOST_FIXTURE_TEST_CASE(GestureRecognizer_LongPressAfterChordTimeout, GestureRecognizerFixture)
+{
+    // the long press time counts from the press, not from the end of the chord time
+    press(ButtonCode::LEFT, 0);
+    advance(80);
+    advance(690);
+    BOOST_CHECK(events_.empty());
+
+    advance(700);
+    BOOST_REQUIRE_EQUAL(events_.size(), 1u);
+    checkEvent(0, ButtonEventType::PRESS, ButtonCode::BACK);
+}
+
+BOOST_FIXTURE_TEST_CASE(GestureRecognizer_ChordReleaseBeforeTimeout, GestureRecognizerFixture)
+{
+    press(ButtonCode::RIGHT, 0);
+    release(ButtonCode::RIGHT, 30);
+
+    BOOST_REQUIRE_EQUAL(events_.size(), 2u);
+    checkEvent(0, ButtonEventType::PRESS, ButtonCode::RIGHT);
+    checkEvent(1, ButtonEventType::RELEASE, ButtonCode::RIGHT);
+    BOOST_CHECK(recognizer_->isIdle());
+}
+
+}
+}
+}
+}
+}
@@ -0,0 +1,163 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <cerrno>
+#include <cstring>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Projection/GpioRotaryEncoder.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+namespace
+{
+
+// quarter steps indexed by (previous state << 2) | state, where state is (A << 1) | B;
+// transitions that skip a state are bounce and count as nothing
+constexpr int8_t cTransitionTable[16] = {0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1, 0};
+
+}
+
+constexpr int32_t GpioRotaryEncoder::cTransitionsPerDetent;
+
+GpioRotaryEncoder::GpioRotaryEncoder(boost::asio::io_service& ioService, boost::asio::io_service::strand& strand, StepHandler stepHandler)
+    : strand_(strand)
+    , descriptor_(ioService)
+    , stepHandler_(std::move(stepHandler))
+    , lineA_(0)
+    , lineB_(0)
+    , state_(0)
+    , transitions_(0)
+{
+
+}
+
+bool GpioRotaryEncoder::open(const std::string& chipPath, uint32_t lineA, uint32_t lineB)
+{
+    const int chipFd = ::open(chipPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if(chipFd < 0)
+    {
+        OPENAUTO_LOG(error) << "[GpioRotaryEncoder] unable to open " << chipPath << ": " << strerror(errno);
+        return false;
+    }
+
+    gpio_v2_line_request request{};
+    request.offsets[0] = lineA;
+    request.offsets[1] = lineB;
+    request.num_lines = 2;
+    request.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING | GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+    strncpy(request.consumer, "openauto", sizeof(request.consumer) - 1);
+
+    const int result = ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &request);
+    ::close(chipFd);
+
+    if(result < 0)
+    {
+        OPENAUTO_LOG(error) << "[GpioRotaryEncoder] unable to request lines " << lineA << ", " << lineB << " of " << chipPath << ": " << strerror(errno);
+        return false;
+    }
+
+    gpio_v2_line_values values{};
+    values.mask = 3;
+    ioctl(request.fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values);
+
+    lineA_ = lineA;
+    lineB_ = lineB;
+    state_ = ((values.bits & 1) << 1) | ((values.bits >> 1) & 1);
+    transitions_ = 0;
+    descriptor_.assign(request.fd);
+
+    OPENAUTO_LOG(info) << "[GpioRotaryEncoder] reading encoder on " << chipPath << ", lines " << lineA << ", " << lineB;
+    this->read();
+    return true;
+}
+
+void GpioRotaryEncoder::close()
+{
+    boost::system::error_code ec;
+    descriptor_.close(ec);
+}
+
+void GpioRotaryEncoder::read()
+{
+    descriptor_.async_read_some(boost::asio::buffer(events_), strand_.wrap([this, self = this->shared_from_this()](const boost::system::error_code& e, size_t size) {
+        if(e)
+        {
+            if(e != boost::asio::error::operation_aborted)
+            {
+                OPENAUTO_LOG(error) << "[GpioRotaryEncoder] read failed: " << e.message();
+            }
+            return;
+        }
+
+        if(!descriptor_.is_open())
+        {
+            // completed before close() and queued behind it
+            return;
+        }
+
+        for(size_t i = 0; i < size / sizeof(gpio_v2_line_event); ++i)
+        {
+            this->handleEvent(events_[i]);
+        }
+
+        // one call per read, however many detents a fast spin packed into it
+        const auto detents = transitions_ / cTransitionsPerDetent;
+        transitions_ -= detents * cTransitionsPerDetent;
+        if(detents != 0)
+        {
+            // edge timestamps are taken from CLOCK_MONOTONIC, the clock behind steady_clock
+            const auto& lastEvent = events_[size / sizeof(gpio_v2_line_event) - 1];
+            stepHandler_(detents, std::chrono::steady_clock::time_point(std::chrono::nanoseconds(lastEvent.timestamp_ns)));
+        }
+
+        this->read();
+    }));
+}
+
+void GpioRotaryEncoder::handleEvent(const gpio_v2_line_event& event)
+{
+    const uint8_t level = event.id == GPIO_V2_LINE_EVENT_RISING_EDGE ? 1 : 0;
+    uint8_t state = state_;
+
+    if(event.offset == lineA_)
+    {
+        state = (state & 1) | (level << 1);
+    }
+    else if(event.offset == lineB_)
+    {
+        state = (state & 2) | level;
+    }
+
+    transitions_ += cTransitionTable[(state_ << 2) | state];
+    state_ = state;
+}
+
+}
+}
+}
+}
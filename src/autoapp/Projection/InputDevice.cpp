@@ -16,6 +16,7 @@
 *  along with openauto. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <f1x/openauto/Common/Log.hpp>
 #include <f1x/openauto/autoapp/Projection/IInputDeviceEventHandler.hpp>
 #include <f1x/openauto/autoapp/Projection/InputDevice.hpp>
@@ -29,14 +30,32 @@ namespace autoapp
 namespace projection
 {
 
-InputDevice::InputDevice(QObject& parent, configuration::IConfiguration::Pointer configuration, const QRect& touchscreenGeometry, const QRect& displayGeometry)
-    : parent_(parent)
+namespace
+{
+
+std::chrono::steady_clock::time_point getEventTime(const QInputEvent* event)
+{
+    // platform plugins stamp events from different clocks, only a timestamp that looks
+    // like recent monotonic time is trusted
+    const auto now = std::chrono::steady_clock::now();
+    const std::chrono::steady_clock::time_point eventTime(std::chrono::milliseconds(event->timestamp()));
+
+    return now >= eventTime && now - eventTime < std::chrono::seconds(1) ? eventTime : now;
+}
+
+}
+
+InputDevice::InputDevice(QObject& surface, configuration::IConfiguration::Pointer configuration, KeyMap::Pointer keyMap, const QRect& touchscreenGeometry, const QRect& displayGeometry)
+    : surface_(&surface)
     , configuration_(std::move(configuration))
+    , keyMap_(std::move(keyMap))
     , touchscreenGeometry_(touchscreenGeometry)
     , displayGeometry_(displayGeometry)
     , eventHandler_(nullptr)
+    , touchscreenEnabled_(configuration_->getTouchscreenEnabled())
+    , buttonCodes_(configuration_->getButtonCodes())
 {
-    this->moveToThread(parent.thread());
+    this->moveToThread(surface.thread());
 }
 
 void InputDevice::start(IInputDeviceEventHandler& eventHandler)
@@ -45,7 +64,9 @@ void InputDevice::start(IInputDeviceEventHandler& eventHandler)
 
     OPENAUTO_LOG(info) << "[InputDevice] start.";
     eventHandler_ = &eventHandler;
-    parent_.installEventFilter(this);
+
+    // the filter is installed from the GUI thread, the surface may be gone by the time it runs
+    QMetaObject::invokeMethod(this, "attachFilter", Qt::QueuedConnection);
 }
 
 void InputDevice::stop()
@@ -53,12 +74,48 @@ void InputDevice::stop()
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
     OPENAUTO_LOG(info) << "[InputDevice] stop.";
-    parent_.removeEventFilter(this);
     eventHandler_ = nullptr;
+    touchTracker_.reset();
+    QMetaObject::invokeMethod(this, "detachFilter", Qt::QueuedConnection);
+}
+
+void InputDevice::attachFilter()
+{
+    // the video widget takes the focus while projecting, so keys arrive here together with touches
+    if(surface_ != nullptr)
+    {
+        surface_->installEventFilter(this);
+    }
+}
+
+void InputDevice::detachFilter()
+{
+    if(surface_ != nullptr)
+    {
+        surface_->removeEventFilter(this);
+    }
 }
 
 bool InputDevice::eventFilter(QObject* obj, QEvent* event)
 {
+    // paint, layout and timer events of the surface pass without touching the mutex
+    switch(event->type())
+    {
+    case QEvent::KeyPress:
+    case QEvent::KeyRelease:
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseMove:
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd:
+    case QEvent::TouchCancel:
+        break;
+
+    default:
+        return QObject::eventFilter(obj, event);
+    }
+
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
     if(eventHandler_ != nullptr)
@@ -75,6 +132,10 @@ bool InputDevice::eventFilter(QObject* obj, QEvent* event)
         {
             return this->handleTouchEvent(event);
         }
+        else if(event->type() == QEvent::TouchBegin || event->type() == QEvent::TouchUpdate || event->type() == QEvent::TouchEnd || event->type() == QEvent::TouchCancel)
+        {
+            return this->handleMultiTouchEvent(static_cast<QTouchEvent*>(event));
+        }
     }
 
     return QObject::eventFilter(obj, event);
@@ -82,111 +143,31 @@ bool InputDevice::eventFilter(QObject* obj, QEvent* event)
 
 bool InputDevice::handleKeyEvent(QEvent* event, QKeyEvent* key)
 {
-    auto eventType = event->type() == QEvent::KeyPress ? ButtonEventType::PRESS : ButtonEventType::RELEASE;
-    aasdk::proto::enums::ButtonCode::Enum buttonCode;
-    WheelDirection wheelDirection = WheelDirection::NONE;
-
-    switch(key->key())
+    const auto* binding = keyMap_->getQtBinding(key->key());
+    if(binding == nullptr)
     {
-    case Qt::Key_Return:
-    case Qt::Key_Enter:
-        buttonCode = aasdk::proto::enums::ButtonCode::ENTER;
-        break;
-
-    case Qt::Key_Left:
-        buttonCode = aasdk::proto::enums::ButtonCode::LEFT;
-        break;
-
-    case Qt::Key_Right:
-        buttonCode = aasdk::proto::enums::ButtonCode::RIGHT;
-        break;
-
-    case Qt::Key_Up:
-        buttonCode = aasdk::proto::enums::ButtonCode::UP;
-        break;
-
-    case Qt::Key_Down:
-        buttonCode = aasdk::proto::enums::ButtonCode::DOWN;
-        break;
-
-    case Qt::Key_Escape:
-        buttonCode = aasdk::proto::enums::ButtonCode::BACK;
-        break;
-
-    case Qt::Key_H:
-        buttonCode = aasdk::proto::enums::ButtonCode::HOME;
-        break;
-
-    case Qt::Key_P:
-        buttonCode = aasdk::proto::enums::ButtonCode::PHONE;
-        break;
-
-    case Qt::Key_O:
-        buttonCode = aasdk::proto::enums::ButtonCode::CALL_END;
-        break;
-
-    case Qt::Key_X:
-        buttonCode = aasdk::proto::enums::ButtonCode::PLAY;
-        break;
-
-    case Qt::Key_C:
-        buttonCode = aasdk::proto::enums::ButtonCode::PAUSE;
-        break;
-
-    case Qt::Key_MediaPrevious:
-    case Qt::Key_V:
-        buttonCode = aasdk::proto::enums::ButtonCode::PREV;
-        break;
-
-    case Qt::Key_MediaPlay:
-    case Qt::Key_B:
-        buttonCode = aasdk::proto::enums::ButtonCode::TOGGLE_PLAY;
-        break;
-
-    case Qt::Key_MediaNext:
-    case Qt::Key_N:
-        buttonCode = aasdk::proto::enums::ButtonCode::NEXT;
-        break;
-
-    case Qt::Key_M:
-        buttonCode = aasdk::proto::enums::ButtonCode::MICROPHONE_1;
-        break;
-
-    case Qt::Key_1:
-        wheelDirection = WheelDirection::LEFT;
-        eventType = ButtonEventType::NONE;
-        buttonCode = aasdk::proto::enums::ButtonCode::SCROLL_WHEEL;
-        break;
-
-    case Qt::Key_2:
-        wheelDirection = WheelDirection::RIGHT;
-        eventType = ButtonEventType::NONE;
-        buttonCode = aasdk::proto::enums::ButtonCode::SCROLL_WHEEL;
-        break;
-
-    case Qt::Key_F:
-        buttonCode = aasdk::proto::enums::ButtonCode::NAVIGATION;
-        break;
-
-    default:
         return true;
     }
 
-    const auto& buttonCodes = this->getSupportedButtonCodes();
-    if(std::find(buttonCodes.begin(), buttonCodes.end(), buttonCode) != buttonCodes.end())
+    if(binding->wheelDirection != WheelDirection::NONE)
     {
-        if(buttonCode != aasdk::proto::enums::ButtonCode::SCROLL_WHEEL || event->type() == QEvent::KeyRelease)
+        if(event->type() == QEvent::KeyRelease && buttonCodes_.contains(aasdk::proto::enums::ButtonCode::SCROLL_WHEEL))
         {
-            eventHandler_->onButtonEvent({eventType, wheelDirection, buttonCode});
+            eventHandler_->onButtonEvent({ButtonEventType::NONE, binding->wheelDirection, aasdk::proto::enums::ButtonCode::SCROLL_WHEEL, 1, false, getEventTime(key)});
         }
     }
+    else if(buttonCodes_.contains(binding->code))
+    {
+        const auto eventType = event->type() == QEvent::KeyPress ? ButtonEventType::PRESS : ButtonEventType::RELEASE;
+        eventHandler_->onButtonEvent({eventType, WheelDirection::NONE, binding->code, 1, false, getEventTime(key)});
+    }
 
     return true;
 }
 
 bool InputDevice::handleTouchEvent(QEvent* event)
 {
-    if(!configuration_->getTouchscreenEnabled())
+    if(!touchscreenEnabled_)
     {
         return true;
     }
@@ -213,12 +194,56 @@ bool InputDevice::handleTouchEvent(QEvent* event)
     {
         const uint32_t x = (static_cast<float>(mouse->pos().x()) / touchscreenGeometry_.width()) * displayGeometry_.width();
         const uint32_t y = (static_cast<float>(mouse->pos().y()) / touchscreenGeometry_.height()) * displayGeometry_.height();
-        eventHandler_->onTouchEvent({type, x, y, 0});
+        eventHandler_->onTouchEvent({type, {{x, y, 0}}, 0, getEventTime(mouse)});
     }
 
     return true;
 }
 
+bool InputDevice::handleMultiTouchEvent(QTouchEvent* touch)
+{
+    if(!touchscreenEnabled_)
+    {
+        return true;
+    }
+
+    if(touch->type() == QEvent::TouchCancel)
+    {
+        touchTracker_.upAll();
+    }
+
+    for(const auto& point : touch->touchPoints())
+    {
+        const uint32_t x = std::max(0.0, (point.pos().x() / touchscreenGeometry_.width()) * displayGeometry_.width());
+        const uint32_t y = std::max(0.0, (point.pos().y() / touchscreenGeometry_.height()) * displayGeometry_.height());
+
+        switch(point.state())
+        {
+        case Qt::TouchPointPressed:
+            touchTracker_.down(point.id(), x, y);
+            break;
+        case Qt::TouchPointMoved:
+            touchTracker_.move(point.id(), x, y);
+            break;
+        case Qt::TouchPointReleased:
+            touchTracker_.up(point.id());
+            break;
+        default:
+            break;
+        }
+    }
+
+    const auto eventTime = getEventTime(touch);
+    for(auto& event : touchTracker_.flush())
+    {
+        event.timestamp = eventTime;
+        eventHandler_->onTouchEvent(event);
+    }
+
+    // accepting the touch keeps Qt from synthesizing mouse events for it as well
+    return true;
+}
+
 bool InputDevice::hasTouchscreen() const
 {
     return configuration_->getTouchscreenEnabled();
@@ -234,6 +259,24 @@ IInputDevice::ButtonCodes InputDevice::getSupportedButtonCodes() const
     return configuration_->getButtonCodes();
 }
 
+void InputDevice::onConfigurationChanged(const configuration::ConfigurationChange& change)
+{
+    const auto inputChanged = std::any_of(change.liveKeys.begin(), change.liveKeys.end(), [](const std::string& key) {
+        return key.compare(0, 6, "Input.") == 0;
+    });
+
+    if(inputChanged)
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+        // the channel keeps the key codes and touch config announced at service discovery,
+        // events are filtered against the current settings
+        OPENAUTO_LOG(info) << "[InputDevice] input configuration changed.";
+        touchscreenEnabled_ = configuration_->getTouchscreenEnabled();
+        buttonCodes_ = ButtonCodeSet(configuration_->getButtonCodes());
+    }
+}
+
 }
 }
 }
@@ -0,0 +1,310 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <linux/input.h>
+#include <QKeySequence>
+#include <boost/algorithm/string.hpp>
+#include <boost/property_tree/ini_parser.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Projection/KeyMap.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+const std::string KeyMap::cFileName = "openauto_keymap.ini";
+
+constexpr size_t KeyMap::cQtTableSize;
+constexpr size_t KeyMap::cEvdevTableSize;
+
+KeyMap::KeyMap()
+    : longPressTime_(700)
+    , doublePressTime_(300)
+    , chordTime_(80)
+{
+    const KeyBinding unbound{aasdk::proto::enums::ButtonCode::NONE, WheelDirection::NONE};
+    qtBindings_.fill(unbound);
+    evdevBindings_.fill(unbound);
+
+    this->bindQtKey(Qt::Key_Return, aasdk::proto::enums::ButtonCode::ENTER);
+    this->bindQtKey(Qt::Key_Enter, aasdk::proto::enums::ButtonCode::ENTER);
+    this->bindQtKey(Qt::Key_Left, aasdk::proto::enums::ButtonCode::LEFT);
+    this->bindQtKey(Qt::Key_Right, aasdk::proto::enums::ButtonCode::RIGHT);
+    this->bindQtKey(Qt::Key_Up, aasdk::proto::enums::ButtonCode::UP);
+    this->bindQtKey(Qt::Key_Down, aasdk::proto::enums::ButtonCode::DOWN);
+    this->bindQtKey(Qt::Key_Escape, aasdk::proto::enums::ButtonCode::BACK);
+    this->bindQtKey(Qt::Key_H, aasdk::proto::enums::ButtonCode::HOME);
+    this->bindQtKey(Qt::Key_P, aasdk::proto::enums::ButtonCode::PHONE);
+    this->bindQtKey(Qt::Key_O, aasdk::proto::enums::ButtonCode::CALL_END);
+    this->bindQtKey(Qt::Key_X, aasdk::proto::enums::ButtonCode::PLAY);
+    this->bindQtKey(Qt::Key_C, aasdk::proto::enums::ButtonCode::PAUSE);
+    this->bindQtKey(Qt::Key_MediaPrevious, aasdk::proto::enums::ButtonCode::PREV);
+    this->bindQtKey(Qt::Key_V, aasdk::proto::enums::ButtonCode::PREV);
+    this->bindQtKey(Qt::Key_MediaPlay, aasdk::proto::enums::ButtonCode::TOGGLE_PLAY);
+    this->bindQtKey(Qt::Key_B, aasdk::proto::enums::ButtonCode::TOGGLE_PLAY);
+    this->bindQtKey(Qt::Key_MediaNext, aasdk::proto::enums::ButtonCode::NEXT);
+    this->bindQtKey(Qt::Key_N, aasdk::proto::enums::ButtonCode::NEXT);
+    this->bindQtKey(Qt::Key_M, aasdk::proto::enums::ButtonCode::MICROPHONE_1);
+    this->bindQtKey(Qt::Key_1, aasdk::proto::enums::ButtonCode::SCROLL_WHEEL, WheelDirection::LEFT);
+    this->bindQtKey(Qt::Key_2, aasdk::proto::enums::ButtonCode::SCROLL_WHEEL, WheelDirection::RIGHT);
+    this->bindQtKey(Qt::Key_F, aasdk::proto::enums::ButtonCode::NAVIGATION);
+
+    this->bindEvdevCode(KEY_ENTER, aasdk::proto::enums::ButtonCode::ENTER);
+    this->bindEvdevCode(KEY_OK, aasdk::proto::enums::ButtonCode::ENTER);
+    this->bindEvdevCode(KEY_LEFT, aasdk::proto::enums::ButtonCode::LEFT);
+    this->bindEvdevCode(KEY_RIGHT, aasdk::proto::enums::ButtonCode::RIGHT);
+    this->bindEvdevCode(KEY_UP, aasdk::proto::enums::ButtonCode::UP);
+    this->bindEvdevCode(KEY_DOWN, aasdk::proto::enums::ButtonCode::DOWN);
+    this->bindEvdevCode(KEY_ESC, aasdk::proto::enums::ButtonCode::BACK);
+    this->bindEvdevCode(KEY_BACK, aasdk::proto::enums::ButtonCode::BACK);
+    this->bindEvdevCode(KEY_HOMEPAGE, aasdk::proto::enums::ButtonCode::HOME);
+    this->bindEvdevCode(KEY_PHONE, aasdk::proto::enums::ButtonCode::PHONE);
+    this->bindEvdevCode(KEY_PLAY, aasdk::proto::enums::ButtonCode::PLAY);
+    this->bindEvdevCode(KEY_PAUSE, aasdk::proto::enums::ButtonCode::PAUSE);
+    this->bindEvdevCode(KEY_PLAYPAUSE, aasdk::proto::enums::ButtonCode::TOGGLE_PLAY);
+    this->bindEvdevCode(KEY_PREVIOUSSONG, aasdk::proto::enums::ButtonCode::PREV);
+    this->bindEvdevCode(KEY_NEXTSONG, aasdk::proto::enums::ButtonCode::NEXT);
+    this->bindEvdevCode(KEY_VOICECOMMAND, aasdk::proto::enums::ButtonCode::MICROPHONE_1);
+}
+
+void KeyMap::load(const std::string& fileName)
+{
+    std::ifstream file(fileName);
+    if(!file.is_open())
+    {
+        return;
+    }
+
+    boost::property_tree::ptree iniConfig;
+
+    try
+    {
+        boost::property_tree::ini_parser::read_ini(file, iniConfig);
+    }
+    catch(const boost::property_tree::ini_parser_error& e)
+    {
+        OPENAUTO_LOG(warning) << "[KeyMap] failed to read keymap file: " << fileName
+                              << ", error: " << e.what()
+                              << ". Default key bindings will be used.";
+        return;
+    }
+
+    OPENAUTO_LOG(info) << "[KeyMap] loading " << fileName;
+
+    // iterating the children keeps key names like "." away from the path syntax
+    const auto qtSection = iniConfig.get_child_optional("Qt");
+    if(qtSection)
+    {
+        this->readQtBindings(*qtSection);
+    }
+
+    const auto evdevSection = iniConfig.get_child_optional("Evdev");
+    if(evdevSection)
+    {
+        this->readEvdevBindings(*evdevSection);
+    }
+
+    const auto gesturesSection = iniConfig.get_child_optional("Gestures");
+    if(gesturesSection)
+    {
+        this->readGestures(*gesturesSection);
+    }
+}
+
+const KeyBinding* KeyMap::getQtBinding(int key) const
+{
+    const auto index = getQtIndex(key);
+    if(index < 0)
+    {
+        return nullptr;
+    }
+
+    const auto& binding = qtBindings_[index];
+    return binding.code == aasdk::proto::enums::ButtonCode::NONE ? nullptr : &binding;
+}
+
+const KeyBinding* KeyMap::getEvdevBinding(uint16_t code) const
+{
+    if(code >= cEvdevTableSize)
+    {
+        return nullptr;
+    }
+
+    const auto& binding = evdevBindings_[code];
+    return binding.code == aasdk::proto::enums::ButtonCode::NONE ? nullptr : &binding;
+}
+
+const std::vector<Gesture>& KeyMap::getGestures() const
+{
+    return gestures_;
+}
+
+uint32_t KeyMap::getLongPressTime() const
+{
+    return longPressTime_;
+}
+
+uint32_t KeyMap::getDoublePressTime() const
+{
+    return doublePressTime_;
+}
+
+uint32_t KeyMap::getChordTime() const
+{
+    return chordTime_;
+}
+
+int KeyMap::getQtIndex(int key)
+{
+    if(key >= 0 && key < 0x80)
+    {
+        return key;
+    }
+    else if(key >= Qt::Key_Escape && key < Qt::Key_Escape + 0x200)
+    {
+        return 0x80 + key - Qt::Key_Escape;
+    }
+    else if(key >= Qt::Key_Context1 && key < Qt::Key_Context1 + 0x100)
+    {
+        return 0x280 + key - Qt::Key_Context1;
+    }
+
+    return -1;
+}
+
+bool KeyMap::parseBinding(const std::string& value, KeyBinding& binding)
+{
+    const auto token = boost::trim_copy(value);
+
+    if(token == "WHEEL_LEFT" || token == "WHEEL_RIGHT")
+    {
+        binding = {aasdk::proto::enums::ButtonCode::SCROLL_WHEEL, token == "WHEEL_LEFT" ? WheelDirection::LEFT : WheelDirection::RIGHT};
+        return true;
+    }
+
+    binding.wheelDirection = WheelDirection::NONE;
+    return aasdk::proto::enums::ButtonCode::Enum_Parse(token, &binding.code);
+}
+
+bool KeyMap::parseGesture(const std::string& key, const std::string& value, Gesture& gesture)
+{
+    std::vector<std::string> tokens;
+    boost::split(tokens, key, boost::is_any_of(" \t"), boost::token_compress_on);
+
+    gesture.partner = aasdk::proto::enums::ButtonCode::NONE;
+
+    if(tokens.size() == 2 && (tokens[0] == "long" || tokens[0] == "double"))
+    {
+        gesture.type = tokens[0] == "long" ? GestureType::LONG_PRESS : GestureType::DOUBLE_PRESS;
+    }
+    else if(tokens.size() == 3 && tokens[0] == "chord")
+    {
+        gesture.type = GestureType::CHORD;
+        if(!aasdk::proto::enums::ButtonCode::Enum_Parse(tokens[2], &gesture.partner))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    return aasdk::proto::enums::ButtonCode::Enum_Parse(tokens[1], &gesture.trigger)
+            && aasdk::proto::enums::ButtonCode::Enum_Parse(boost::trim_copy(value), &gesture.target);
+}
+
+void KeyMap::bindQtKey(int key, aasdk::proto::enums::ButtonCode::Enum code, WheelDirection wheelDirection)
+{
+    qtBindings_[getQtIndex(key)] = {code, wheelDirection};
+}
+
+void KeyMap::bindEvdevCode(uint16_t code, aasdk::proto::enums::ButtonCode::Enum buttonCode)
+{
+    evdevBindings_[code] = {buttonCode, WheelDirection::NONE};
+}
+
+void KeyMap::readQtBindings(const boost::property_tree::ptree& section)
+{
+    for(const auto& entry : section)
+    {
+        const auto sequence = QKeySequence::fromString(QString::fromStdString(entry.first), QKeySequence::PortableText);
+        const auto index = sequence.count() == 1 ? getQtIndex(sequence[0] & ~Qt::KeyboardModifierMask) : -1;
+
+        KeyBinding binding;
+        if(index < 0 || !parseBinding(entry.second.data(), binding))
+        {
+            OPENAUTO_LOG(warning) << "[KeyMap] ignoring Qt binding " << entry.first << "=" << entry.second.data();
+            continue;
+        }
+
+        qtBindings_[index] = binding;
+    }
+}
+
+void KeyMap::readEvdevBindings(const boost::property_tree::ptree& section)
+{
+    for(const auto& entry : section)
+    {
+        char* end = nullptr;
+        const auto code = std::strtoul(entry.first.c_str(), &end, 0);
+
+        KeyBinding binding;
+        if(entry.first.empty() || *end != '\0' || code >= cEvdevTableSize || !parseBinding(entry.second.data(), binding))
+        {
+            OPENAUTO_LOG(warning) << "[KeyMap] ignoring evdev binding " << entry.first << "=" << entry.second.data();
+            continue;
+        }
+
+        evdevBindings_[code] = binding;
+    }
+}
+
+void KeyMap::readGestures(const boost::property_tree::ptree& section)
+{
+    for(const auto& entry : section)
+    {
+        if(entry.first == "LongPressTime" || entry.first == "DoublePressTime" || entry.first == "ChordTime")
+        {
+            auto& time = entry.first == "LongPressTime" ? longPressTime_ : (entry.first == "DoublePressTime" ? doublePressTime_ : chordTime_);
+            time = entry.second.get_value<uint32_t>(time);
+            continue;
+        }
+
+        Gesture gesture;
+        if(!parseGesture(entry.first, entry.second.data(), gesture))
+        {
+            OPENAUTO_LOG(warning) << "[KeyMap] ignoring gesture " << entry.first << "=" << entry.second.data();
+            continue;
+        }
+
+        gestures_.push_back(gesture);
+    }
+}
+
+}
+}
+}
+}
@@ -42,6 +42,10 @@ void QtVideoOutput::createVideoOutput()
 {
     OPENAUTO_LOG(debug) << "[QtVideoOutput] create.";
     videoWidget_ = std::make_unique<QVideoWidget>();
+    // multi-touch panels deliver QTouchEvents to InputDevice instead of a synthesized mouse
+    videoWidget_->setAttribute(Qt::WA_AcceptTouchEvents);
+    // InputDevice filters the events of this widget only, keys included, so it has to take the focus
+    videoWidget_->setFocusPolicy(Qt::StrongFocus);
     mediaPlayer_ = std::make_unique<QMediaPlayer>(nullptr, QMediaPlayer::StreamPlayback);
 }
 
@@ -62,6 +66,11 @@ void QtVideoOutput::stop()
     emit stopPlayback();
 }
 
+QWidget* QtVideoOutput::getVideoWidget() const
+{
+    return videoWidget_.get();
+}
+
 void QtVideoOutput::write(uint64_t, const aasdk::common::DataConstBuffer& buffer)
 {
     videoBuffer_.write(reinterpret_cast<const char*>(buffer.cdata), buffer.size);
@@ -70,10 +79,11 @@ void QtVideoOutput::write(uint64_t, const aasdk::common::DataConstBuffer& buffer
 void QtVideoOutput::onStartPlayback()
 {
     videoWidget_->setAspectRatioMode(Qt::IgnoreAspectRatio);
-    videoWidget_->setFocus();
     //videoWidget_->setWindowFlags(Qt::WindowStaysOnTopHint);
     videoWidget_->setFullScreen(true);
     videoWidget_->show();
+    videoWidget_->activateWindow();
+    videoWidget_->setFocus(Qt::ActiveWindowFocusReason);
 
     mediaPlayer_->setVideoOutput(videoWidget_.get());
     mediaPlayer_->setMedia(QMediaContent(), &videoBuffer_);
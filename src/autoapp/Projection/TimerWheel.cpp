@@ -0,0 +1,122 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/autoapp/Projection/TimerWheel.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+constexpr size_t TimerWheel::cCapacity;
+constexpr size_t TimerWheel::cSlots;
+constexpr uint8_t TimerWheel::cNone;
+
+TimerWheel::TimerWheel()
+    : cursor_(0)
+    , count_(0)
+{
+    this->clear();
+}
+
+void TimerWheel::schedule(size_t id, size_t ticks)
+{
+    if(id >= cCapacity)
+    {
+        return;
+    }
+
+    this->cancel(id);
+
+    // the cursor reaches the slot after (ticks - 1) % cSlots + 1 ticks, then every cSlots ticks
+    ticks = ticks == 0 ? 1 : ticks;
+    auto& entry = entries_[id];
+    entry.slot = static_cast<uint8_t>((cursor_ + ticks) % cSlots);
+    entry.rounds = static_cast<uint32_t>((ticks - 1) / cSlots);
+    entry.prev = cNone;
+    entry.next = heads_[entry.slot];
+
+    if(entry.next != cNone)
+    {
+        entries_[entry.next].prev = static_cast<uint8_t>(id);
+    }
+
+    heads_[entry.slot] = static_cast<uint8_t>(id);
+    ++count_;
+}
+
+void TimerWheel::cancel(size_t id)
+{
+    if(this->isScheduled(id))
+    {
+        this->unlink(id);
+    }
+}
+
+bool TimerWheel::isScheduled(size_t id) const
+{
+    return id < cCapacity && entries_[id].slot != cNone;
+}
+
+void TimerWheel::clear()
+{
+    heads_.fill(cNone);
+
+    for(auto& entry : entries_)
+    {
+        entry = {cNone, cNone, cNone, 0};
+    }
+
+    count_ = 0;
+}
+
+bool TimerWheel::empty() const
+{
+    return count_ == 0;
+}
+
+void TimerWheel::unlink(size_t id)
+{
+    auto& entry = entries_[id];
+
+    if(entry.prev != cNone)
+    {
+        entries_[entry.prev].next = entry.next;
+    }
+    else
+    {
+        heads_[entry.slot] = entry.next;
+    }
+
+    if(entry.next != cNone)
+    {
+        entries_[entry.next].prev = entry.prev;
+    }
+
+    entry = {cNone, cNone, cNone, 0};
+    --count_;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,93 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <f1x/openauto/autoapp/Projection/TimerWheel.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+namespace ut
+{
+
+class TimerWheelFixture
+{
+protected:
+    // turns the wheel until the given id expires and returns the ticks it took, 0 if it never did
+    size_t ticksUntil(size_t id, size_t maxTicks)
+    {
+        for(size_t tick = 1; tick <= maxTicks; ++tick)
+        {
+            bool expired = false;
+            timerWheel_.advance([&expired, id](size_t expiredId) { expired = expired || expiredId == id; });
+            if(expired)
+            {
+                return tick;
+            }
+        }
+
+        return 0;
+    }
+
+    TimerWheel timerWheel_;
+};
+
+BOOST_FIXTURE_TEST_CASE(TimerWheel_Expires, TimerWheelFixture)
+{
+    timerWheel_.schedule(3, 5);
+    BOOST_CHECK(timerWheel_.isScheduled(3));
+    BOOST_CHECK_EQUAL(ticksUntil(3, 10), 5u);
+    BOOST_CHECK(!timerWheel_.isScheduled(3));
+    BOOST_CHECK(timerWheel_.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(TimerWheel_ExpiresAfterFullRounds, TimerWheelFixture)
+{
+    timerWheel_.schedule(0, TimerWheel::cSlots * 2 + 3);
+    BOOST_CHECK_EQUAL(ticksUntil(0, TimerWheel::cSlots * 3), TimerWheel::cSlots * 2 + 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(TimerWheel_Cancel, TimerWheelFixture)
+{
+    timerWheel_.schedule(1, 4);
+    timerWheel_.schedule(2, 4);
+    timerWheel_.cancel(1);
+
+    BOOST_CHECK(!timerWheel_.isScheduled(1));
+    BOOST_CHECK_EQUAL(ticksUntil(1, 10), 0u);
+    BOOST_CHECK(timerWheel_.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(TimerWheel_Reschedule, TimerWheelFixture)
+{
+    // every id has one timer, scheduling again replaces it
+    timerWheel_.schedule(5, 2);
+    timerWheel_.schedule(5, 7);
+    BOOST_CHECK_EQUAL(ticksUntil(5, 10), 7u);
+}
+
+}
+}
+}
+}
+}
@@ -0,0 +1,178 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <f1x/openauto/autoapp/Projection/TouchTracker.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+void TouchTracker::down(int sourceId, uint32_t x, uint32_t y)
+{
+    if(this->find(sourceId) == active_.end())
+    {
+        pressed_.push_back({{x, y, 0}, sourceId});
+    }
+}
+
+void TouchTracker::move(int sourceId, uint32_t x, uint32_t y)
+{
+    auto pointer = this->find(sourceId);
+    if(pointer != active_.end() && (pointer->point.x != x || pointer->point.y != y))
+    {
+        pointer->point.x = x;
+        pointer->point.y = y;
+        moved_ = true;
+        return;
+    }
+
+    // moved again before the press was flushed
+    for(auto& pressed : pressed_)
+    {
+        if(pressed.sourceId == sourceId)
+        {
+            pressed.point.x = x;
+            pressed.point.y = y;
+        }
+    }
+}
+
+void TouchTracker::up(int sourceId)
+{
+    auto pressed = std::find_if(pressed_.begin(), pressed_.end(), [sourceId](const Pointer& pointer) { return pointer.sourceId == sourceId; });
+    if(pressed != pressed_.end())
+    {
+        // down and up within one report, still deliver the tap
+        released_.push_back(sourceId);
+        return;
+    }
+
+    if(this->find(sourceId) != active_.end())
+    {
+        released_.push_back(sourceId);
+    }
+}
+
+void TouchTracker::upAll()
+{
+    pressed_.clear();
+    released_.clear();
+    for(const auto& pointer : active_)
+    {
+        released_.push_back(pointer.sourceId);
+    }
+}
+
+void TouchTracker::reset()
+{
+    active_.clear();
+    pressed_.clear();
+    released_.clear();
+    moved_ = false;
+}
+
+std::vector<TouchEvent> TouchTracker::flush()
+{
+    std::vector<TouchEvent> events;
+
+    // releases first so a finger swap in one report does not look like a third pointer
+    std::vector<int> releasedLater;
+    for(const auto sourceId : released_)
+    {
+        auto pointer = this->find(sourceId);
+        if(pointer == active_.end())
+        {
+            releasedLater.push_back(sourceId);
+            continue;
+        }
+
+        const auto actionIndex = static_cast<uint32_t>(pointer - active_.begin());
+        const auto type = active_.size() > 1 ? aasdk::proto::enums::TouchAction::POINTER_UP : aasdk::proto::enums::TouchAction::RELEASE;
+        events.push_back({type, this->getPoints(), actionIndex});
+        active_.erase(pointer);
+    }
+
+    for(auto& pressed : pressed_)
+    {
+        pressed.point.pointerId = this->allocatePointerId();
+        active_.push_back(pressed);
+
+        const auto type = active_.size() > 1 ? aasdk::proto::enums::TouchAction::POINTER_DOWN : aasdk::proto::enums::TouchAction::PRESS;
+        events.push_back({type, this->getPoints(), static_cast<uint32_t>(active_.size() - 1)});
+    }
+
+    for(const auto sourceId : releasedLater)
+    {
+        auto pointer = this->find(sourceId);
+        if(pointer != active_.end())
+        {
+            const auto actionIndex = static_cast<uint32_t>(pointer - active_.begin());
+            const auto type = active_.size() > 1 ? aasdk::proto::enums::TouchAction::POINTER_UP : aasdk::proto::enums::TouchAction::RELEASE;
+            events.push_back({type, this->getPoints(), actionIndex});
+            active_.erase(pointer);
+        }
+    }
+
+    if(moved_ && events.empty() && !active_.empty())
+    {
+        events.push_back({aasdk::proto::enums::TouchAction::DRAG, this->getPoints(), 0});
+    }
+
+    pressed_.clear();
+    released_.clear();
+    moved_ = false;
+
+    return events;
+}
+
+std::vector<TouchTracker::Pointer>::iterator TouchTracker::find(int sourceId)
+{
+    return std::find_if(active_.begin(), active_.end(), [sourceId](const Pointer& pointer) { return pointer.sourceId == sourceId; });
+}
+
+uint32_t TouchTracker::allocatePointerId() const
+{
+    uint32_t pointerId = 0;
+    while(std::any_of(active_.begin(), active_.end(), [pointerId](const Pointer& pointer) { return pointer.point.pointerId == pointerId; }))
+    {
+        ++pointerId;
+    }
+    return pointerId;
+}
+
+std::vector<TouchPoint> TouchTracker::getPoints() const
+{
+    std::vector<TouchPoint> points;
+    points.reserve(active_.size());
+    for(const auto& pointer : active_)
+    {
+        points.push_back(pointer.point);
+    }
+    return points;
+}
+
+}
+}
+}
+}
@@ -29,6 +29,8 @@ namespace autoapp
 namespace service
 {
 
+constexpr size_t AndroidAutoEntity::cArenaSize;
+
 AndroidAutoEntity::AndroidAutoEntity(boost::asio::io_service& ioService,
                                      aasdk::messenger::ICryptor::Pointer cryptor,
                                      aasdk::transport::ITransport::Pointer transport,
@@ -45,6 +47,7 @@ AndroidAutoEntity::AndroidAutoEntity(boost::asio::io_service& ioService,
     , serviceList_(std::move(serviceList))
     , pinger_(std::move(pinger))
     , eventHandler_(nullptr)
+    , arena_(cArenaSize)
 {
 }
 
@@ -185,28 +188,35 @@ void AndroidAutoEntity::onServiceDiscoveryRequest(const aasdk::proto::messages::
     OPENAUTO_LOG(info) << "[AndroidAutoEntity] Discovery request, device name: " << request.device_name()
                        << ", brand: " << request.device_brand();
 
-    aasdk::proto::messages::ServiceDiscoveryResponse serviceDiscoveryResponse;
-    serviceDiscoveryResponse.mutable_channels()->Reserve(256);
-    serviceDiscoveryResponse.set_head_unit_name("Crankshaft-NG");
-    serviceDiscoveryResponse.set_car_model("Universal");
-    serviceDiscoveryResponse.set_car_year("2018");
-    serviceDiscoveryResponse.set_car_serial("20180301");
-    serviceDiscoveryResponse.set_left_hand_drive_vehicle(configuration_->getHandednessOfTrafficType() == configuration::HandednessOfTrafficType::LEFT_HAND_DRIVE);
-    serviceDiscoveryResponse.set_headunit_manufacturer("f1x");
-    serviceDiscoveryResponse.set_headunit_model("Crankshaft-NG Autoapp");
-    serviceDiscoveryResponse.set_sw_build("1");
-    serviceDiscoveryResponse.set_sw_version("1.0");
-    serviceDiscoveryResponse.set_can_play_native_media_during_vr(false);
-    serviceDiscoveryResponse.set_hide_clock(!configuration_->showClock());
-
-    std::for_each(serviceList_.begin(), serviceList_.end(), std::bind(&IService::fillFeatures, std::placeholders::_1, std::ref(serviceDiscoveryResponse)));
+    auto& serviceDiscoveryResponse = *arena_.create<aasdk::proto::messages::ServiceDiscoveryResponse>();
+    fillServiceDiscoveryResponse(*configuration_, serviceList_, serviceDiscoveryResponse);
 
     auto promise = aasdk::channel::SendPromise::defer(strand_);
     promise->then([]() {}, std::bind(&AndroidAutoEntity::onChannelError, this->shared_from_this(), std::placeholders::_1));
     controlServiceChannel_->sendServiceDiscoveryResponse(serviceDiscoveryResponse, std::move(promise));
+    arena_.reset();
     controlServiceChannel_->receive(this->shared_from_this());
 }
 
+void AndroidAutoEntity::fillServiceDiscoveryResponse(const configuration::IConfiguration& configuration, const ServiceList& serviceList,
+                                                     aasdk::proto::messages::ServiceDiscoveryResponse& response)
+{
+    response.mutable_channels()->Reserve(256);
+    response.set_head_unit_name("Crankshaft-NG");
+    response.set_car_model("Universal");
+    response.set_car_year("2018");
+    response.set_car_serial("20180301");
+    response.set_left_hand_drive_vehicle(configuration.getHandednessOfTrafficType() == configuration::HandednessOfTrafficType::LEFT_HAND_DRIVE);
+    response.set_headunit_manufacturer("f1x");
+    response.set_headunit_model("Crankshaft-NG Autoapp");
+    response.set_sw_build("1");
+    response.set_sw_version("1.0");
+    response.set_can_play_native_media_during_vr(false);
+    response.set_hide_clock(!configuration.showClock());
+
+    std::for_each(serviceList.begin(), serviceList.end(), std::bind(&IService::fillFeatures, std::placeholders::_1, std::ref(response)));
+}
+
 void AndroidAutoEntity::onAudioFocusRequest(const aasdk::proto::messages::AudioFocusRequest& request)
 {
     OPENAUTO_LOG(info) << "[AndroidAutoEntity] requested audio focus, type: " << request.audio_focus_type();
@@ -27,6 +27,8 @@
 #include <f1x/openauto/autoapp/Service/AndroidAutoEntityFactory.hpp>
 #include <f1x/openauto/autoapp/Service/AndroidAutoEntity.hpp>
 #include <f1x/openauto/autoapp/Service/Pinger.hpp>
+#include <f1x/openauto/autoapp/Trace/SessionRecorder.hpp>
+#include <f1x/openauto/autoapp/Trace/RecordingMessenger.hpp>
 
 namespace f1x
 {
@@ -65,10 +67,19 @@ IAndroidAutoEntity::Pointer AndroidAutoEntityFactory::create(aasdk::transport::I
     auto cryptor(std::make_shared<aasdk::messenger::Cryptor>(std::move(sslWrapper)));
     cryptor->init();
 
-    auto messenger(std::make_shared<aasdk::messenger::Messenger>(ioService_,
+    aasdk::messenger::IMessenger::Pointer messenger(std::make_shared<aasdk::messenger::Messenger>(ioService_,
                                                                  std::make_shared<aasdk::messenger::MessageInStream>(ioService_, transport, cryptor),
                                                                  std::make_shared<aasdk::messenger::MessageOutStream>(ioService_, transport, cryptor)));
 
+    if(configuration_->getTraceMode() != configuration::TraceMode::NONE)
+    {
+        auto recorder(std::make_shared<trace::SessionRecorder>(configuration_->getTraceMode(),
+                                                               configuration_->getTraceDirectory(),
+                                                               configuration_->traceCompressionEnabled(),
+                                                               configuration_->getTraceRingSize()));
+        messenger = std::make_shared<trace::RecordingMessenger>(ioService_, std::move(messenger), std::move(recorder));
+    }
+
     auto serviceList = serviceFactory_.create(messenger);
     auto pinger(std::make_shared<Pinger>(ioService_, 5000));
     return std::make_shared<AndroidAutoEntity>(ioService_, std::move(cryptor), std::move(transport), std::move(messenger), configuration_, std::move(serviceList), std::move(pinger));
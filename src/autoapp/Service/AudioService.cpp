@@ -16,6 +16,7 @@
 *  along with openauto. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
 #include <f1x/openauto/Common/Log.hpp>
 #include <f1x/openauto/autoapp/Service/AudioService.hpp>
 
@@ -28,13 +29,16 @@ namespace autoapp
 namespace service
 {
 
-AudioService::AudioService(boost::asio::io_service& ioService, aasdk::channel::av::IAudioServiceChannel::Pointer channel, projection::IAudioOutput::Pointer audioOutput)
+AudioService::AudioService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, aasdk::channel::av::IAudioServiceChannel::Pointer channel,
+                           projection::IAudioOutput::Pointer audioOutput)
     : strand_(ioService)
+    , messenger_(std::move(messenger))
     , channel_(std::move(channel))
     , audioOutput_(std::move(audioOutput))
     , session_(-1)
+    , ackMessages_(channel_->getId(), aasdk::proto::ids::AVChannelMessage::AV_MEDIA_ACK_INDICATION)
 {
-
+    this->setSession(-1);
 }
 
 void AudioService::start()
@@ -151,7 +155,7 @@ void AudioService::onAVChannelStartIndication(const aasdk::proto::messages::AVCh
     OPENAUTO_LOG(info) << "[AudioService] start indication"
                        << ", channel: " << aasdk::messenger::channelIdToString(channel_->getId())
                        << ", session: " << indication.session();
-    session_ = indication.session();
+    this->setSession(indication.session());
     audioOutput_->start();
     channel_->receive(this->shared_from_this());
 }
@@ -161,7 +165,7 @@ void AudioService::onAVChannelStopIndication(const aasdk::proto::messages::AVCha
     OPENAUTO_LOG(info) << "[AudioService] stop indication"
                        << ", channel: " << aasdk::messenger::channelIdToString(channel_->getId())
                        << ", session: " << session_;
-    session_ = -1;
+    this->setSession(-1);
     audioOutput_->suspend();
     channel_->receive(this->shared_from_this());
 }
@@ -169,13 +173,7 @@ void AudioService::onAVChannelStopIndication(const aasdk::proto::messages::AVCha
 void AudioService::onAVMediaWithTimestampIndication(aasdk::messenger::Timestamp::ValueType timestamp, const aasdk::common::DataConstBuffer& buffer)
 {
     audioOutput_->write(timestamp, buffer);
-    aasdk::proto::messages::AVMediaAckIndication indication;
-    indication.set_session(session_);
-    indication.set_value(1);
-
-    auto promise = aasdk::channel::SendPromise::defer(strand_);
-    promise->then([]() {}, std::bind(&AudioService::onChannelError, this->shared_from_this(), std::placeholders::_1));
-    channel_->sendAVMediaAckIndication(indication, std::move(promise));
+    this->sendAVMediaAckIndication();
     channel_->receive(this->shared_from_this());
 }
 
@@ -190,6 +188,29 @@ void AudioService::onChannelError(const aasdk::error::Error& e)
                         << ", channel: " << aasdk::messenger::channelIdToString(channel_->getId());
 }
 
+void AudioService::setSession(int32_t session)
+{
+    session_ = session;
+
+    aasdk::proto::messages::AVMediaAckIndication indication;
+    indication.set_session(session_);
+    indication.set_value(1);
+    MessagePool::serialize(indication, ackIndication_);
+}
+
+void AudioService::sendAVMediaAckIndication()
+{
+    auto message = ackMessages_.acquire();
+    message->insertPayload(ackIndication_);
+
+    auto promise = sendPromises_.defer(strand_, this->shared_from_this());
+    promise->then([]() {}, [channelId = channel_->getId()](const aasdk::error::Error& e) {
+        OPENAUTO_LOG(error) << "[AudioService] channel error: " << e.what()
+                            << ", channel: " << aasdk::messenger::channelIdToString(channelId);
+    });
+    messenger_->enqueueSend(std::move(message), std::move(promise));
+}
+
 }
 }
 }
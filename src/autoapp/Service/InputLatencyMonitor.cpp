@@ -0,0 +1,157 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Service/InputLatencyMonitor.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+constexpr std::chrono::seconds InputLatencyMonitor::cReportInterval;
+
+InputLatencyMonitor::InputLatencyMonitor()
+    : awaitingFrame_(false)
+    , lastReportTime_(std::chrono::steady_clock::now())
+    , lastReportCount_(0)
+{
+
+}
+
+void InputLatencyMonitor::onDispatch(TimePoint eventTime, TimePoint dispatchTime)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    dispatch_.add(dispatchTime - eventTime);
+}
+
+void InputLatencyMonitor::onSendComplete(TimePoint eventTime, TimePoint sendTime)
+{
+    bool reportDue = false;
+
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        send_.add(sendTime - eventTime);
+
+        if(!awaitingFrame_)
+        {
+            pendingEventTime_ = eventTime;
+            pendingSendTime_ = sendTime;
+            awaitingFrame_ = true;
+        }
+
+        reportDue = sendTime - lastReportTime_ >= cReportInterval;
+    }
+
+    if(reportDue)
+    {
+        this->report();
+    }
+}
+
+void InputLatencyMonitor::onVideoFrame()
+{
+    // every frame passes here, keep the common case free of the lock
+    if(!awaitingFrame_.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(awaitingFrame_)
+    {
+        frame_.add(now - pendingSendTime_);
+        total_.add(now - pendingEventTime_);
+        awaitingFrame_ = false;
+    }
+}
+
+void InputLatencyMonitor::report()
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    lastReportTime_ = std::chrono::steady_clock::now();
+    if(send_.count == lastReportCount_)
+    {
+        return;
+    }
+
+    lastReportCount_ = send_.count;
+    OPENAUTO_LOG(info) << "[InputLatencyMonitor] events: " << send_.count
+                       << ", to strand " << dispatch_.format()
+                       << ", to sent " << send_.format()
+                       << ", sent to next frame " << frame_.format()
+                       << ", input to next frame " << total_.format();
+}
+
+void InputLatencyMonitor::Histogram::add(std::chrono::steady_clock::duration latency)
+{
+    const auto value = static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(latency).count()));
+
+    size_t bucket = 0;
+    while(bucket < buckets.size() - 1 && value >= (uint64_t(1) << bucket))
+    {
+        ++bucket;
+    }
+
+    ++buckets[bucket];
+    ++count;
+    max = std::max(max, value);
+}
+
+uint64_t InputLatencyMonitor::Histogram::percentile(double fraction) const
+{
+    const uint64_t target = static_cast<uint64_t>(count * fraction);
+    uint64_t seen = 0;
+
+    for(size_t bucket = 0; bucket < buckets.size(); ++bucket)
+    {
+        seen += buckets[bucket];
+        if(seen > target)
+        {
+            return uint64_t(1) << bucket;
+        }
+    }
+
+    return uint64_t(1) << (buckets.size() - 1);
+}
+
+std::string InputLatencyMonitor::Histogram::format() const
+{
+    if(count == 0)
+    {
+        return "-";
+    }
+
+    std::ostringstream stream;
+    stream << "p50 < " << this->percentile(0.5) << " us, p99 < " << this->percentile(0.99) << " us, max " << max << " us";
+    return stream.str();
+}
+
+}
+}
+}
+}
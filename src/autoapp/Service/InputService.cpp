@@ -16,9 +16,11 @@
 *  along with openauto. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <aasdk_proto/InputChannelMessageIdsEnum.pb.h>
 #include <aasdk_proto/InputEventIndicationMessage.pb.h>
 #include <f1x/openauto/Common/Log.hpp>
 #include <f1x/openauto/autoapp/Service/InputService.hpp>
+#include <f1x/openauto/autoapp/Projection/ButtonCodeSet.hpp>
 
 namespace f1x
 {
@@ -29,12 +31,33 @@ namespace autoapp
 namespace service
 {
 
-InputService::InputService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, projection::IInputDevice::Pointer inputDevice)
+InputService::InputService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, configuration::IConfiguration::Pointer configuration,
+                           projection::KeyMap::Pointer keyMap, projection::IInputDevice::Pointer inputDevice, InputLatencyMonitor::Pointer latencyMonitor)
     : strand_(ioService)
+    , messenger_(messenger)
     , channel_(std::make_shared<aasdk::channel::input::InputServiceChannel>(strand_, std::move(messenger)))
     , inputDevice_(std::move(inputDevice))
+    , latencyMonitor_(std::move(latencyMonitor))
+    , inputEventMessages_(aasdk::messenger::ChannelId::INPUT, aasdk::proto::ids::InputChannelMessage::INPUT_EVENT_INDICATION)
+    , moveTimer_(ioService)
+    , movePending_(false)
+    , touchEventsReceived_(0)
+    , touchEventsSent_(0)
+    , wheelTimer_(ioService)
+    , wheelPending_(false)
+    , pendingWheelDelta_(0)
+    , gestureRecognizer_(std::move(keyMap), std::bind(&InputService::onGestureEvent, this, std::placeholders::_1))
+    , gestureTimer_(ioService)
+    , gestureTickPending_(false)
 {
+    // by default there is no point in moving faster than the phone renders frames
+    auto moveRate = configuration->getTouchMoveRate();
+    if(moveRate == 0)
+    {
+        moveRate = configuration->getVideoFPS() == aasdk::proto::enums::VideoFPS::_60 ? 60 : 30;
+    }
 
+    moveInterval_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(1)) / moveRate;
 }
 
 void InputService::start()
@@ -50,6 +73,16 @@ void InputService::stop()
     strand_.dispatch([this, self = this->shared_from_this()]() {
         OPENAUTO_LOG(info) << "[InputService] stop.";
         inputDevice_->stop();
+        moveTimer_.cancel();
+        movePending_ = false;
+        wheelTimer_.cancel();
+        wheelPending_ = false;
+        gestureTimer_.cancel();
+        gestureRecognizer_.reset();
+
+        OPENAUTO_LOG(info) << "[InputService] touch events received: " << touchEventsReceived_
+                           << ", sent: " << touchEventsSent_;
+        latencyMonitor_->report();
     });
 }
 
@@ -114,11 +147,11 @@ void InputService::onBindingRequest(const aasdk::proto::messages::BindingRequest
     OPENAUTO_LOG(info) << "[InputService] binding request, scan codes count: " << request.scan_codes_size();
 
     aasdk::proto::enums::Status::Enum status = aasdk::proto::enums::Status::OK;
-    const auto& supportedButtonCodes = inputDevice_->getSupportedButtonCodes();
+    const projection::ButtonCodeSet supportedButtonCodes(inputDevice_->getSupportedButtonCodes());
 
     for(int i = 0; i < request.scan_codes_size(); ++i)
     {
-        if(std::find(supportedButtonCodes.begin(), supportedButtonCodes.end(), request.scan_codes(i)) == supportedButtonCodes.end())
+        if(!supportedButtonCodes.contains(static_cast<aasdk::proto::enums::ButtonCode::Enum>(request.scan_codes(i))))
         {
             OPENAUTO_LOG(error) << "[InputService] binding request, scan code: " << request.scan_codes(i)
                                 << " is not supported.";
@@ -152,51 +185,227 @@ void InputService::onChannelError(const aasdk::error::Error& e)
 void InputService::onButtonEvent(const projection::ButtonEvent& event)
 {
     auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now().time_since_epoch());
+    const auto eventTime = getEventTime(event.timestamp);
 
-    strand_.dispatch([this, self = this->shared_from_this(), event = std::move(event), timestamp = std::move(timestamp)]() {
-        aasdk::proto::messages::InputEventIndication inputEventIndication;
-        inputEventIndication.set_timestamp(timestamp.count());
+    strand_.dispatch([this, self = this->shared_from_this(), event = std::move(event), timestamp = std::move(timestamp), eventTime]() {
+        latencyMonitor_->onDispatch(eventTime, std::chrono::steady_clock::now());
 
         if(event.code == aasdk::proto::enums::ButtonCode::SCROLL_WHEEL)
         {
-            auto relativeEvent = inputEventIndication.mutable_relative_input_event()->add_relative_input_events();
-            relativeEvent->set_delta(event.wheelDirection == projection::WheelDirection::LEFT ? -1 : 1);
-            relativeEvent->set_scan_code(event.code);
+            const auto steps = static_cast<int32_t>(event.wheelSteps);
+            pendingWheelDelta_ += event.wheelDirection == projection::WheelDirection::LEFT ? -steps : steps;
+            pendingWheelTimestamp_ = timestamp;
+
+            if(wheelPending_)
+            {
+                return;
+            }
+
+            wheelPending_ = true;
+            pendingWheelEventTime_ = eventTime;
+            const auto nextWheelSendTime = lastWheelSendTime_ + moveInterval_;
+
+            if(std::chrono::steady_clock::now() >= nextWheelSendTime)
+            {
+                this->sendPendingWheel();
+            }
+            else
+            {
+                wheelTimer_.expires_at(nextWheelSendTime);
+                wheelTimer_.async_wait(strand_.wrap(std::bind(&InputService::onWheelTimerExpired, this->shared_from_this(), std::placeholders::_1)));
+            }
         }
         else
         {
-            auto buttonEvent = inputEventIndication.mutable_button_event()->add_button_events();
-            buttonEvent->set_meta(0);
-            buttonEvent->set_is_pressed(event.type == projection::ButtonEventType::PRESS);
-            buttonEvent->set_long_press(false);
-            buttonEvent->set_scan_code(event.code);
+            gestureRecognizer_.onButtonEvent(event, std::chrono::steady_clock::now());
+            this->scheduleGestureTick();
         }
-
-        auto promise = aasdk::channel::SendPromise::defer(strand_);
-        promise->then([]() {}, std::bind(&InputService::onChannelError, this->shared_from_this(), std::placeholders::_1));
-        channel_->sendInputEventIndication(inputEventIndication, std::move(promise));
     });
 }
 
+void InputService::onGestureEvent(const projection::ButtonEvent& event)
+{
+    // a button pressed after turning the knob has to act on where the knob stopped
+    if(wheelPending_)
+    {
+        wheelTimer_.cancel();
+        this->sendPendingWheel();
+    }
+
+    const auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now().time_since_epoch());
+    this->sendButtonEvent(event, timestamp, getEventTime(event.timestamp));
+}
+
+void InputService::scheduleGestureTick()
+{
+    if(gestureTickPending_ || gestureRecognizer_.isIdle())
+    {
+        return;
+    }
+
+    gestureTickPending_ = true;
+    gestureTimer_.expires_at(gestureRecognizer_.getNextTick());
+    gestureTimer_.async_wait(strand_.wrap(std::bind(&InputService::onGestureTimerExpired, this->shared_from_this(), std::placeholders::_1)));
+}
+
+void InputService::onGestureTimerExpired(const boost::system::error_code& error)
+{
+    gestureTickPending_ = false;
+
+    if(!error)
+    {
+        gestureRecognizer_.advance(std::chrono::steady_clock::now());
+        this->scheduleGestureTick();
+    }
+}
+
+void InputService::onWheelTimerExpired(const boost::system::error_code& error)
+{
+    if(!error && wheelPending_)
+    {
+        this->sendPendingWheel();
+    }
+}
+
+void InputService::sendPendingWheel()
+{
+    wheelPending_ = false;
+    lastWheelSendTime_ = std::chrono::steady_clock::now();
+
+    // turned back and forth within one interval
+    if(pendingWheelDelta_ == 0)
+    {
+        return;
+    }
+
+    inputEventIndication_.Clear();
+    inputEventIndication_.set_timestamp(pendingWheelTimestamp_.count());
+
+    auto relativeEvent = inputEventIndication_.mutable_relative_input_event()->add_relative_input_events();
+    relativeEvent->set_delta(pendingWheelDelta_);
+    relativeEvent->set_scan_code(aasdk::proto::enums::ButtonCode::SCROLL_WHEEL);
+    pendingWheelDelta_ = 0;
+
+    this->sendInputEventIndication(pendingWheelEventTime_);
+}
+
+void InputService::sendButtonEvent(const projection::ButtonEvent& event, std::chrono::microseconds timestamp, InputLatencyMonitor::TimePoint eventTime)
+{
+    inputEventIndication_.Clear();
+    inputEventIndication_.set_timestamp(timestamp.count());
+
+    auto buttonEvent = inputEventIndication_.mutable_button_event()->add_button_events();
+    buttonEvent->set_meta(0);
+    buttonEvent->set_is_pressed(event.type == projection::ButtonEventType::PRESS);
+    buttonEvent->set_long_press(event.longPress);
+    buttonEvent->set_scan_code(event.code);
+
+    this->sendInputEventIndication(eventTime);
+}
+
 void InputService::onTouchEvent(const projection::TouchEvent& event)
 {
     auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now().time_since_epoch());
+    const auto eventTime = getEventTime(event.timestamp);
+
+    strand_.dispatch([this, self = this->shared_from_this(), event = std::move(event), timestamp = std::move(timestamp), eventTime]() {
+        latencyMonitor_->onDispatch(eventTime, std::chrono::steady_clock::now());
+        ++touchEventsReceived_;
+
+        if(event.type == aasdk::proto::enums::TouchAction::DRAG)
+        {
+            pendingMove_ = event;
+            pendingMoveTimestamp_ = timestamp;
+
+            if(movePending_)
+            {
+                return;
+            }
+
+            movePending_ = true;
+            pendingMoveEventTime_ = eventTime;
+            const auto nextMoveSendTime = lastMoveSendTime_ + moveInterval_;
+
+            if(std::chrono::steady_clock::now() >= nextMoveSendTime)
+            {
+                this->sendPendingMove();
+            }
+            else
+            {
+                moveTimer_.expires_at(nextMoveSendTime);
+                moveTimer_.async_wait(strand_.wrap(std::bind(&InputService::onMoveTimerExpired, this->shared_from_this(), std::placeholders::_1)));
+            }
+        }
+        else
+        {
+            // the last position has to reach the phone before a pointer goes down or up
+            if(movePending_)
+            {
+                moveTimer_.cancel();
+                this->sendPendingMove();
+            }
+
+            this->sendTouchEvent(event, timestamp, eventTime);
+        }
+    });
+}
+
+void InputService::onMoveTimerExpired(const boost::system::error_code& error)
+{
+    if(!error && movePending_)
+    {
+        this->sendPendingMove();
+    }
+}
 
-    strand_.dispatch([this, self = this->shared_from_this(), event = std::move(event), timestamp = std::move(timestamp)]() {
-        aasdk::proto::messages::InputEventIndication inputEventIndication;
-        inputEventIndication.set_timestamp(timestamp.count());
+void InputService::sendPendingMove()
+{
+    movePending_ = false;
+    lastMoveSendTime_ = std::chrono::steady_clock::now();
+    this->sendTouchEvent(pendingMove_, pendingMoveTimestamp_, pendingMoveEventTime_);
+}
 
-        auto touchEvent = inputEventIndication.mutable_touch_event();
-        touchEvent->set_touch_action(event.type);
+void InputService::sendTouchEvent(const projection::TouchEvent& event, std::chrono::microseconds timestamp, InputLatencyMonitor::TimePoint eventTime)
+{
+    inputEventIndication_.Clear();
+    inputEventIndication_.set_timestamp(timestamp.count());
+
+    auto touchEvent = inputEventIndication_.mutable_touch_event();
+    touchEvent->set_touch_action(event.type);
+    touchEvent->set_action_index(event.actionIndex);
+
+    for(const auto& pointer : event.pointers)
+    {
         auto touchLocation = touchEvent->add_touch_location();
-        touchLocation->set_x(event.x);
-        touchLocation->set_y(event.y);
-        touchLocation->set_pointer_id(0);
+        touchLocation->set_x(pointer.x);
+        touchLocation->set_y(pointer.y);
+        touchLocation->set_pointer_id(pointer.pointerId);
+    }
 
-        auto promise = aasdk::channel::SendPromise::defer(strand_);
-        promise->then([]() {}, std::bind(&InputService::onChannelError, this->shared_from_this(), std::placeholders::_1));
-        channel_->sendInputEventIndication(inputEventIndication, std::move(promise));
-    });
+    ++touchEventsSent_;
+    this->sendInputEventIndication(eventTime);
+}
+
+void InputService::sendInputEventIndication(InputLatencyMonitor::TimePoint eventTime)
+{
+    auto message = inputEventMessages_.acquire();
+    message->insertPayload(inputEventIndication_);
+
+    // the completion still holds the service, it runs after the messenger may have dropped the promise
+    auto promise = sendPromises_.defer(strand_, this->shared_from_this());
+    promise->then([this, self = this->shared_from_this(), eventTime]() {
+                      latencyMonitor_->onSendComplete(eventTime, std::chrono::steady_clock::now());
+                  },
+                  [](const aasdk::error::Error& e) {
+                      OPENAUTO_LOG(error) << "[InputService] channel error: " << e.what();
+                  });
+    messenger_->enqueueSend(std::move(message), std::move(promise));
+}
+
+InputLatencyMonitor::TimePoint InputService::getEventTime(InputLatencyMonitor::TimePoint timestamp)
+{
+    // sources that cannot stamp their events are measured from here
+    return timestamp != InputLatencyMonitor::TimePoint() ? timestamp : std::chrono::steady_clock::now();
 }
 
 }
@@ -29,7 +29,7 @@ namespace service
 {
 
 MediaAudioService::MediaAudioService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, projection::IAudioOutput::Pointer audioOutput)
-    : AudioService(ioService, std::make_shared<aasdk::channel::av::MediaAudioServiceChannel>(strand_, std::move(messenger)), std::move(audioOutput))
+    : AudioService(ioService, messenger, std::make_shared<aasdk::channel::av::MediaAudioServiceChannel>(strand_, messenger), std::move(audioOutput))
 {
 
 }
@@ -0,0 +1,64 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/autoapp/Service/MessageArena.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+MessageArena::MessageArena(size_t initialBlockSize)
+    : initialBlockSize_(initialBlockSize)
+    , initialBlock_(new char[initialBlockSize])
+    , arena_(createOptions(initialBlock_.get(), initialBlockSize))
+    , overflowCount_(0)
+{
+
+}
+
+void MessageArena::reset()
+{
+    // Reset() returns the bytes used, blocks beyond the initial one go back to the heap
+    if(arena_.Reset() > initialBlockSize_)
+    {
+        ++overflowCount_;
+    }
+}
+
+uint64_t MessageArena::getOverflowCount() const
+{
+    return overflowCount_;
+}
+
+google::protobuf::ArenaOptions MessageArena::createOptions(char* initialBlock, size_t initialBlockSize)
+{
+    google::protobuf::ArenaOptions options;
+    options.initial_block = initialBlock;
+    options.initial_block_size = initialBlockSize;
+    return options;
+}
+
+}
+}
+}
+}
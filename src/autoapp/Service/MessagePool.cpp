@@ -0,0 +1,94 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <atomic>
+#include <f1x/aasdk/Messenger/MessageId.hpp>
+#include <f1x/openauto/autoapp/Service/MessagePool.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+constexpr size_t MessagePool::cSize;
+
+MessagePool::MessagePool(aasdk::messenger::ChannelId channelId, uint16_t messageId)
+    : channelId_(channelId)
+    , messageId_(aasdk::messenger::MessageId(messageId).getData())
+    , next_(0)
+    , overflowCount_(0)
+{
+
+}
+
+aasdk::messenger::Message::Pointer MessagePool::acquire()
+{
+    for(size_t i = 0; i < cSize; ++i)
+    {
+        auto& message = messages_[(next_ + i) % cSize];
+
+        if(message == nullptr)
+        {
+            message = this->create();
+        }
+        else if(message.use_count() == 1)
+        {
+            // the messenger dropped its reference on another thread, see its last read of the payload
+            std::atomic_thread_fence(std::memory_order_acquire);
+            auto& payload = message->getPayload();
+            payload.assign(messageId_.begin(), messageId_.end());
+        }
+        else
+        {
+            continue;
+        }
+
+        next_ = (next_ + i + 1) % cSize;
+        return message;
+    }
+
+    ++overflowCount_;
+    return this->create();
+}
+
+uint64_t MessagePool::getOverflowCount() const
+{
+    return overflowCount_;
+}
+
+void MessagePool::serialize(const google::protobuf::Message& message, aasdk::common::Data& data)
+{
+    data.resize(message.ByteSize());
+    message.SerializeToArray(data.data(), static_cast<int>(data.size()));
+}
+
+aasdk::messenger::Message::Pointer MessagePool::create() const
+{
+    auto message(std::make_shared<aasdk::messenger::Message>(channelId_, aasdk::messenger::EncryptionType::ENCRYPTED, aasdk::messenger::MessageType::SPECIFIC));
+    message->insertPayload(messageId_);
+    return message;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,136 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/autoapp/Service/SendPromisePool.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+constexpr size_t SendPromisePool::cBlockSize;
+constexpr size_t SendPromisePool::cBlockCount;
+
+template<typename T>
+class SendPromisePool::Allocator
+{
+public:
+    typedef T value_type;
+
+    Allocator(SendPromisePool& pool, std::shared_ptr<void> owner)
+        : pool_(&pool)
+        , owner_(std::move(owner))
+    {
+
+    }
+
+    template<typename U>
+    Allocator(const Allocator<U>& other)
+        : pool_(other.pool_)
+        , owner_(other.owner_)
+    {
+
+    }
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(pool_->allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t)
+    {
+        pool_->deallocate(pointer);
+    }
+
+    template<typename U>
+    bool operator==(const Allocator<U>& other) const
+    {
+        return pool_ == other.pool_;
+    }
+
+    template<typename U>
+    bool operator!=(const Allocator<U>& other) const
+    {
+        return pool_ != other.pool_;
+    }
+
+private:
+    template<typename U>
+    friend class Allocator;
+
+    SendPromisePool* pool_;
+    std::shared_ptr<void> owner_;
+};
+
+SendPromisePool::SendPromisePool()
+    : freeCount_(cBlockCount)
+    , overflowCount_(0)
+{
+    for(size_t i = 0; i < cBlockCount; ++i)
+    {
+        freeBlocks_[i] = &blocks_[i];
+    }
+}
+
+aasdk::channel::SendPromise::Pointer SendPromisePool::defer(boost::asio::io_service::strand& strand, std::shared_ptr<void> owner)
+{
+    return std::allocate_shared<aasdk::channel::SendPromise>(Allocator<aasdk::channel::SendPromise>(*this, std::move(owner)), strand);
+}
+
+uint64_t SendPromisePool::getOverflowCount() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return overflowCount_;
+}
+
+void* SendPromisePool::allocate(size_t size)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(size <= cBlockSize && freeCount_ > 0)
+    {
+        return freeBlocks_[--freeCount_];
+    }
+
+    // more sends in flight than blocks, e.g. while the transport is stalled
+    ++overflowCount_;
+    return ::operator new(size);
+}
+
+void SendPromisePool::deallocate(void* pointer)
+{
+    auto* block = static_cast<Block*>(pointer);
+
+    if(block < blocks_.data() || block >= blocks_.data() + cBlockCount)
+    {
+        ::operator delete(pointer);
+        return;
+    }
+
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    freeBlocks_[freeCount_++] = block;
+}
+
+}
+}
+}
+}
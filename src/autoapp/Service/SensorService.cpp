@@ -17,6 +17,7 @@
 */
 
 #include <aasdk_proto/DrivingStatusEnum.pb.h>
+#include <aasdk_proto/SensorChannelMessageIdsEnum.pb.h>
 #include <f1x/openauto/Common/Log.hpp>
 #include <f1x/openauto/autoapp/Service/SensorService.hpp>
 #include <fstream>
@@ -34,7 +35,9 @@ namespace service
 SensorService::SensorService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger)
     : strand_(ioService),
       timer_(ioService),
-      channel_(std::make_shared<aasdk::channel::sensor::SensorServiceChannel>(strand_, std::move(messenger)))
+      messenger_(messenger),
+      channel_(std::make_shared<aasdk::channel::sensor::SensorServiceChannel>(strand_, std::move(messenger))),
+      sensorEventMessages_(aasdk::messenger::ChannelId::SENSOR, aasdk::proto::ids::SensorChannelMessage::SENSOR_EVENT_INDICATION)
 {
 
 }
@@ -153,29 +156,24 @@ void SensorService::onSensorStartRequest(const aasdk::proto::messages::SensorSta
 
 void SensorService::sendDrivingStatusUnrestricted()
 {
-    aasdk::proto::messages::SensorEventIndication indication;
-    indication.add_driving_status()->set_status(aasdk::proto::enums::DrivingStatus::UNRESTRICTED);
-
-    auto promise = aasdk::channel::SendPromise::defer(strand_);
-    promise->then([]() {}, std::bind(&SensorService::onChannelError, this->shared_from_this(), std::placeholders::_1));
-    channel_->sendSensorEventIndication(indication, std::move(promise));
+    sensorEventIndication_.Clear();
+    sensorEventIndication_.add_driving_status()->set_status(aasdk::proto::enums::DrivingStatus::UNRESTRICTED);
+    this->sendSensorEventIndication();
 }
 
 void SensorService::sendNightData()
 {
-    aasdk::proto::messages::SensorEventIndication indication;
+    sensorEventIndication_.Clear();
 
     if (SensorService::isNight) {
         OPENAUTO_LOG(info) << "[SensorService] Mode night triggered";
-        indication.add_night_mode()->set_is_night(true);
+        sensorEventIndication_.add_night_mode()->set_is_night(true);
     } else {
         OPENAUTO_LOG(info) << "[SensorService] Mode day triggered";
-        indication.add_night_mode()->set_is_night(false);
+        sensorEventIndication_.add_night_mode()->set_is_night(false);
     }
 
-    auto promise = aasdk::channel::SendPromise::defer(strand_);
-    promise->then([]() {}, std::bind(&SensorService::onChannelError, this->shared_from_this(), std::placeholders::_1));
-    channel_->sendSensorEventIndication(indication, std::move(promise));
+    this->sendSensorEventIndication();
     if (this->firstRun) {
         this->firstRun = false;
         this->previous = this->isNight;
@@ -184,8 +182,8 @@ void SensorService::sendNightData()
 
 void SensorService::sendGPSLocationData()
 {
-    aasdk::proto::messages::SensorEventIndication indication;
-    auto * locInd = indication.add_gps_location();
+    sensorEventIndication_.Clear();
+    auto * locInd = sensorEventIndication_.add_gps_location();
 
     // epoch seconds
     locInd->set_timestamp(this->gpsData_.fix.time * 1e3);
@@ -212,9 +210,19 @@ void SensorService::sendGPSLocationData()
         locInd->set_bearing(this->gpsData_.fix.track * 1e6);
     }
 
-    auto promise = aasdk::channel::SendPromise::defer(strand_);
-    promise->then([]() {}, std::bind(&SensorService::onChannelError, this->shared_from_this(), std::placeholders::_1));
-    channel_->sendSensorEventIndication(indication, std::move(promise));
+    this->sendSensorEventIndication();
+}
+
+void SensorService::sendSensorEventIndication()
+{
+    auto message = sensorEventMessages_.acquire();
+    message->insertPayload(sensorEventIndication_);
+
+    auto promise = sendPromises_.defer(strand_, this->shared_from_this());
+    promise->then([]() {}, [](const aasdk::error::Error& e) {
+        OPENAUTO_LOG(error) << "[SensorService] channel error: " << e.what();
+    });
+    messenger_->enqueueSend(std::move(message), std::move(promise));
 }
 
 void SensorService::sensorPolling()
@@ -36,6 +36,8 @@
 #include <f1x/openauto/autoapp/Projection/QtAudioOutput.hpp>
 #include <f1x/openauto/autoapp/Projection/QtAudioInput.hpp>
 #include <f1x/openauto/autoapp/Projection/InputDevice.hpp>
+#include <f1x/openauto/autoapp/Projection/EvdevInputDevice.hpp>
+#include <f1x/openauto/autoapp/Projection/ControlInputDevice.hpp>
 #include <f1x/openauto/autoapp/Projection/LocalBluetoothDevice.hpp>
 #include <f1x/openauto/autoapp/Projection/RemoteBluetoothDevice.hpp>
 #include <f1x/openauto/autoapp/Projection/DummyBluetoothDevice.hpp>
@@ -65,22 +67,30 @@ ServiceList ServiceFactory::create(aasdk::messenger::IMessenger::Pointer messeng
     serviceList.emplace_back(std::make_shared<AudioInputService>(ioService_, messenger, std::move(audioInput)));
     this->createAudioServices(serviceList, messenger);
     serviceList.emplace_back(std::make_shared<SensorService>(ioService_, messenger));
-    serviceList.emplace_back(this->createVideoService(messenger));
+    // the video service provides the surface the input service captures from
+    // and the frames that close the input latency measurement
+    auto latencyMonitor = std::make_shared<InputLatencyMonitor>();
+    QObject* inputSurface = QApplication::instance();
+    serviceList.emplace_back(this->createVideoService(messenger, latencyMonitor, inputSurface));
     serviceList.emplace_back(this->createBluetoothService(messenger));
-    serviceList.emplace_back(this->createInputService(messenger));
+    serviceList.emplace_back(this->createInputService(messenger, latencyMonitor, *inputSurface));
     serviceList.emplace_back(std::make_shared<WifiService>(configuration_));
 
     return serviceList;
 }
 
-IService::Pointer ServiceFactory::createVideoService(aasdk::messenger::IMessenger::Pointer messenger)
+IService::Pointer ServiceFactory::createVideoService(aasdk::messenger::IMessenger::Pointer messenger, InputLatencyMonitor::Pointer latencyMonitor, QObject*& inputSurface)
 {
 #ifdef USE_OMX
     auto videoOutput(std::make_shared<projection::OMXVideoOutput>(configuration_));
+    // OMX draws on its own layer, input keeps arriving at whichever launcher window has focus
+    inputSurface = QApplication::instance();
 #else
-    projection::IVideoOutput::Pointer videoOutput(new projection::QtVideoOutput(configuration_), std::bind(&QObject::deleteLater, std::placeholders::_1));
+    auto qtVideoOutput = new projection::QtVideoOutput(configuration_);
+    inputSurface = qtVideoOutput->getVideoWidget();
+    projection::IVideoOutput::Pointer videoOutput(qtVideoOutput, std::bind(&QObject::deleteLater, std::placeholders::_1));
 #endif
-    return std::make_shared<VideoService>(ioService_, messenger, std::move(videoOutput));
+    return std::make_shared<VideoService>(ioService_, messenger, std::move(videoOutput), std::move(latencyMonitor));
 }
 
 IService::Pointer ServiceFactory::createBluetoothService(aasdk::messenger::IMessenger::Pointer messenger)
@@ -104,7 +114,7 @@ IService::Pointer ServiceFactory::createBluetoothService(aasdk::messenger::IMess
     return std::make_shared<BluetoothService>(ioService_, messenger, std::move(bluetoothDevice));
 }
 
-IService::Pointer ServiceFactory::createInputService(aasdk::messenger::IMessenger::Pointer messenger)
+IService::Pointer ServiceFactory::createInputService(aasdk::messenger::IMessenger::Pointer messenger, InputLatencyMonitor::Pointer latencyMonitor, QObject& inputSurface)
 {
     QRect videoGeometry;
     switch(configuration_->getVideoResolution())
@@ -124,38 +134,58 @@ IService::Pointer ServiceFactory::createInputService(aasdk::messenger::IMessenge
 
     QScreen* screen = QGuiApplication::primaryScreen();
     QRect screenGeometry = screen == nullptr ? QRect(0, 0, 1, 1) : screen->geometry();
-    projection::IInputDevice::Pointer inputDevice(std::make_shared<projection::InputDevice>(*QApplication::instance(), configuration_, std::move(screenGeometry), std::move(videoGeometry)));
+    auto keyMap(std::make_shared<projection::KeyMap>());
+    keyMap->load(projection::KeyMap::cFileName);
 
-    return std::make_shared<InputService>(ioService_, messenger, std::move(inputDevice));
+    auto inputDevice(std::make_shared<projection::InputDevice>(inputSurface, configuration_, keyMap, screenGeometry, videoGeometry));
+    configuration_->addListener(inputDevice);
+
+    projection::IInputDevice::Pointer device = inputDevice;
+
+    if(configuration_->getTouchscreenBackendType() == configuration::TouchscreenBackendType::EVDEV)
+    {
+        device = std::make_shared<projection::EvdevInputDevice>(ioService_, configuration_, std::move(device), screenGeometry, videoGeometry);
+    }
+
+    if(!configuration_->getControlDevices().empty() || !configuration_->getRotaryGpioChip().empty())
+    {
+        device = std::make_shared<projection::ControlInputDevice>(ioService_, configuration_, keyMap, std::move(device));
+    }
+
+    return std::make_shared<InputService>(ioService_, messenger, configuration_, std::move(keyMap), std::move(device), std::move(latencyMonitor));
 }
 
 void ServiceFactory::createAudioServices(ServiceList& serviceList, aasdk::messenger::IMessenger::Pointer messenger)
 {
     if(configuration_->musicAudioChannelEnabled())
     {
-        auto mediaAudioOutput = configuration_->getAudioOutputBackendType() == configuration::AudioOutputBackendType::RTAUDIO ?
-                    std::make_shared<projection::RtAudioOutput>(2, 16, 48000) :
-                    projection::IAudioOutput::Pointer(new projection::QtAudioOutput(2, 16, 48000), std::bind(&QObject::deleteLater, std::placeholders::_1));
+        auto mediaAudioOutput = this->createAudioOutput(2, 16, 48000);
 
         serviceList.emplace_back(std::make_shared<MediaAudioService>(ioService_, messenger, std::move(mediaAudioOutput)));
     }
 
     if(configuration_->speechAudioChannelEnabled())
     {
-        auto speechAudioOutput = configuration_->getAudioOutputBackendType() == configuration::AudioOutputBackendType::RTAUDIO ?
-                    std::make_shared<projection::RtAudioOutput>(1, 16, 16000) :
-                    projection::IAudioOutput::Pointer(new projection::QtAudioOutput(1, 16, 16000), std::bind(&QObject::deleteLater, std::placeholders::_1));
+        auto speechAudioOutput = this->createAudioOutput(1, 16, 16000);
 
         serviceList.emplace_back(std::make_shared<SpeechAudioService>(ioService_, messenger, std::move(speechAudioOutput)));
     }
 
-    auto systemAudioOutput = configuration_->getAudioOutputBackendType() == configuration::AudioOutputBackendType::RTAUDIO ?
-                std::make_shared<projection::RtAudioOutput>(1, 16, 16000) :
-                projection::IAudioOutput::Pointer(new projection::QtAudioOutput(1, 16, 16000), std::bind(&QObject::deleteLater, std::placeholders::_1));
+    auto systemAudioOutput = this->createAudioOutput(1, 16, 16000);
 
     serviceList.emplace_back(std::make_shared<SystemAudioService>(ioService_, messenger, std::move(systemAudioOutput)));
 }
 
+projection::IAudioOutput::Pointer ServiceFactory::createAudioOutput(uint32_t channelCount, uint32_t sampleSize, uint32_t sampleRate)
+{
+    if(configuration_->getAudioOutputBackendType() == configuration::AudioOutputBackendType::RTAUDIO)
+    {
+        return std::make_shared<projection::RtAudioOutput>(channelCount, sampleSize, sampleRate);
+    }
+
+    return projection::IAudioOutput::Pointer(new projection::QtAudioOutput(channelCount, sampleSize, sampleRate), std::bind(&QObject::deleteLater, std::placeholders::_1));
+}
+
 }
 }
 }
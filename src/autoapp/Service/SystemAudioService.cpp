@@ -29,7 +29,7 @@ namespace service
 {
 
 SystemAudioService::SystemAudioService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, projection::IAudioOutput::Pointer audioOutput)
-    : AudioService(ioService, std::make_shared<aasdk::channel::av::SystemAudioServiceChannel>(strand_, std::move(messenger)), std::move(audioOutput))
+    : AudioService(ioService, messenger, std::make_shared<aasdk::channel::av::SystemAudioServiceChannel>(strand_, messenger), std::move(audioOutput))
 {
 
 }
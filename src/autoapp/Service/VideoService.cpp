@@ -16,6 +16,7 @@
 *  along with openauto. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
 #include <f1x/openauto/Common/Log.hpp>
 #include <f1x/openauto/autoapp/Service/VideoService.hpp>
 #include <fstream>
@@ -29,13 +30,17 @@ namespace autoapp
 namespace service
 {
 
-VideoService::VideoService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, projection::IVideoOutput::Pointer videoOutput)
+VideoService::VideoService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, projection::IVideoOutput::Pointer videoOutput,
+                           InputLatencyMonitor::Pointer latencyMonitor)
     : strand_(ioService)
+    , messenger_(messenger)
     , channel_(std::make_shared<aasdk::channel::av::VideoServiceChannel>(strand_, std::move(messenger)))
     , videoOutput_(std::move(videoOutput))
+    , latencyMonitor_(std::move(latencyMonitor))
     , session_(-1)
+    , ackMessages_(channel_->getId(), aasdk::proto::ids::AVChannelMessage::AV_MEDIA_ACK_INDICATION)
 {
-
+    this->setSession(-1);
 }
 
 void VideoService::start()
@@ -105,7 +110,7 @@ void VideoService::onAVChannelSetupRequest(const aasdk::proto::messages::AVChann
 void VideoService::onAVChannelStartIndication(const aasdk::proto::messages::AVChannelStartIndication& indication)
 {
     OPENAUTO_LOG(info) << "[VideoService] start indication, session: " << indication.session();
-    session_ = indication.session();
+    this->setSession(indication.session());
 
     channel_->receive(this->shared_from_this());
 }
@@ -119,32 +124,45 @@ void VideoService::onAVChannelStopIndication(const aasdk::proto::messages::AVCha
 
 void VideoService::onAVMediaWithTimestampIndication(aasdk::messenger::Timestamp::ValueType timestamp, const aasdk::common::DataConstBuffer& buffer)
 {
+    latencyMonitor_->onVideoFrame();
     videoOutput_->write(timestamp, buffer);
 
-    aasdk::proto::messages::AVMediaAckIndication indication;
-    indication.set_session(session_);
-    indication.set_value(1);
-
-    auto promise = aasdk::channel::SendPromise::defer(strand_);
-    promise->then([]() {}, std::bind(&VideoService::onChannelError, this->shared_from_this(), std::placeholders::_1));
-    channel_->sendAVMediaAckIndication(indication, std::move(promise));
+    this->sendAVMediaAckIndication();
 
     channel_->receive(this->shared_from_this());
 }
 
 void VideoService::onAVMediaIndication(const aasdk::common::DataConstBuffer& buffer)
 {
+    latencyMonitor_->onVideoFrame();
     videoOutput_->write(0, buffer);
 
+    this->sendAVMediaAckIndication();
+
+    channel_->receive(this->shared_from_this());
+}
+
+void VideoService::setSession(int32_t session)
+{
+    session_ = session;
+
     aasdk::proto::messages::AVMediaAckIndication indication;
     indication.set_session(session_);
     indication.set_value(1);
+    MessagePool::serialize(indication, ackIndication_);
+}
 
-    auto promise = aasdk::channel::SendPromise::defer(strand_);
-    promise->then([]() {}, std::bind(&VideoService::onChannelError, this->shared_from_this(), std::placeholders::_1));
-    channel_->sendAVMediaAckIndication(indication, std::move(promise));
+void VideoService::sendAVMediaAckIndication()
+{
+    auto message = ackMessages_.acquire();
+    message->insertPayload(ackIndication_);
 
-    channel_->receive(this->shared_from_this());
+    // the pool keeps this service alive while the send is pending, the handlers need no capture
+    auto promise = sendPromises_.defer(strand_, this->shared_from_this());
+    promise->then([]() {}, [](const aasdk::error::Error& e) {
+        OPENAUTO_LOG(error) << "[VideoService] channel error: " << e.what();
+    });
+    messenger_->enqueueSend(std::move(message), std::move(promise));
 }
 
 void VideoService::onChannelError(const aasdk::error::Error& e)
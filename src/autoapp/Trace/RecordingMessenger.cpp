@@ -0,0 +1,67 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/autoapp/Trace/RecordingMessenger.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace trace
+{
+
+RecordingMessenger::RecordingMessenger(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, SessionRecorder::Pointer recorder)
+    : strand_(ioService)
+    , messenger_(std::move(messenger))
+    , recorder_(std::move(recorder))
+{
+
+}
+
+void RecordingMessenger::enqueueReceive(aasdk::messenger::ChannelId channelId, ReceivePromise::Pointer promise)
+{
+    auto interceptor = ReceivePromise::defer(strand_);
+    interceptor->then([this, self = this->shared_from_this(), promise](aasdk::messenger::Message::Pointer message) {
+            recorder_->record(Direction::INBOUND, *message);
+            promise->resolve(std::move(message));
+        },
+        [promise](const aasdk::error::Error& e) {
+            promise->reject(e);
+        });
+
+    messenger_->enqueueReceive(channelId, std::move(interceptor));
+}
+
+void RecordingMessenger::enqueueSend(aasdk::messenger::Message::Pointer message, SendPromise::Pointer promise)
+{
+    recorder_->record(Direction::OUTBOUND, *message);
+    messenger_->enqueueSend(std::move(message), std::move(promise));
+}
+
+void RecordingMessenger::stop()
+{
+    messenger_->stop();
+    recorder_->stop();
+}
+
+}
+}
+}
+}
@@ -0,0 +1,277 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <ctime>
+#include <cstdio>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Trace/SessionRecorder.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace trace
+{
+
+namespace
+{
+
+template<typename T>
+void appendLittleEndian(std::vector<uint8_t>& buffer, T value)
+{
+    for(size_t i = 0; i < sizeof(T); ++i)
+    {
+        buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+}
+
+// a stalled disk must not grow the process without bound, records beyond this are dropped
+const size_t SessionRecorder::cMaxPendingSize = 32 * 1024 * 1024;
+
+SessionRecorder::SessionRecorder(configuration::TraceMode mode, std::string directory, bool compress, size_t ringSize)
+    : mode_(mode)
+    , directory_(std::move(directory))
+    , compress_(compress)
+    , ringSize_(ringSize)
+    , startTime_(std::chrono::steady_clock::now())
+    , startTimestamp_(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
+    , ringBytes_(0)
+    , droppedRecords_(0)
+    , stopped_(false)
+#ifdef USE_ZSTD
+    , zstd_(nullptr)
+#endif
+{
+#ifndef USE_ZSTD
+    if(compress_)
+    {
+        OPENAUTO_LOG(warning) << "[SessionRecorder] built without zstd, writing an uncompressed trace.";
+        compress_ = false;
+    }
+#endif
+
+    thread_ = std::thread(&SessionRecorder::run, this);
+}
+
+SessionRecorder::~SessionRecorder()
+{
+    this->stop();
+    thread_.join();
+}
+
+void SessionRecorder::record(Direction direction, const aasdk::messenger::Message& message)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if(stopped_)
+    {
+        return;
+    }
+
+    if(mode_ == configuration::TraceMode::RING)
+    {
+        Buffer buffer;
+        this->encode(buffer, direction, message);
+        ringBytes_ += buffer.size();
+        ring_.push_back(std::move(buffer));
+
+        while(ringBytes_ > ringSize_ && ring_.size() > 1)
+        {
+            ringBytes_ -= ring_.front().size();
+            ring_.pop_front();
+        }
+    }
+    else if(pending_.size() < cMaxPendingSize)
+    {
+        this->encode(pending_, direction, message);
+        condition_.notify_one();
+    }
+    else
+    {
+        ++droppedRecords_;
+    }
+}
+
+void SessionRecorder::stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+    condition_.notify_one();
+}
+
+void SessionRecorder::encode(Buffer& buffer, Direction direction, const aasdk::messenger::Message& message) const
+{
+    const auto& payload = message.getPayload();
+    const uint64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime_).count();
+
+    buffer.reserve(buffer.size() + 4 + cRecordHeaderSize + payload.size());
+    appendLittleEndian<uint32_t>(buffer, cRecordHeaderSize + payload.size());
+    appendLittleEndian<uint64_t>(buffer, timestamp);
+    buffer.push_back(static_cast<uint8_t>(direction));
+    buffer.push_back(static_cast<uint8_t>(message.getChannelId()));
+    buffer.push_back(static_cast<uint8_t>(message.getEncryptionType()));
+    buffer.push_back(static_cast<uint8_t>(message.getType()));
+    buffer.insert(buffer.end(), payload.begin(), payload.end());
+}
+
+void SessionRecorder::run()
+{
+    if(mode_ == configuration::TraceMode::RING)
+    {
+        std::deque<Buffer> ring;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() { return stopped_; });
+            ring.swap(ring_);
+            ringBytes_ = 0;
+        }
+
+        // replace the previous dump only once the new one is complete
+        const std::string fileName = directory_ + "/openauto-last.trace";
+        if(this->open(fileName + ".tmp"))
+        {
+            for(const auto& record : ring)
+            {
+                this->write(record, false);
+            }
+            this->write(Buffer(), true);
+            this->close();
+            std::rename((fileName + ".tmp").c_str(), fileName.c_str());
+        }
+        return;
+    }
+
+    char timestamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+    this->open(directory_ + "/openauto-" + timestamp + ".trace");
+
+    Buffer buffer;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while(true)
+    {
+        condition_.wait(lock, [this]() { return stopped_ || !pending_.empty(); });
+        buffer.clear();
+        buffer.swap(pending_);
+        const bool finish = stopped_;
+
+        lock.unlock();
+        this->write(buffer, finish);
+        lock.lock();
+
+        if(finish)
+        {
+            break;
+        }
+    }
+    lock.unlock();
+
+    this->close();
+}
+
+bool SessionRecorder::open(const std::string& fileName)
+{
+    file_.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!file_.is_open())
+    {
+        OPENAUTO_LOG(error) << "[SessionRecorder] unable to open " << fileName;
+        return false;
+    }
+    fileName_ = fileName;
+
+    Buffer header(cTraceMagic, cTraceMagic + sizeof(cTraceMagic));
+    appendLittleEndian<uint32_t>(header, cTraceVersion);
+    appendLittleEndian<uint32_t>(header, compress_ ? cFlagZstd : 0);
+    appendLittleEndian<uint64_t>(header, startTimestamp_);
+    file_.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+#ifdef USE_ZSTD
+    if(compress_)
+    {
+        zstd_ = ZSTD_createCCtx();
+        ZSTD_CCtx_setParameter(zstd_, ZSTD_c_compressionLevel, 3);
+        compressed_.resize(ZSTD_CStreamOutSize());
+    }
+#endif
+
+    OPENAUTO_LOG(info) << "[SessionRecorder] recording to " << fileName;
+    return true;
+}
+
+void SessionRecorder::write(const Buffer& buffer, bool finish)
+{
+    if(!file_.is_open())
+    {
+        return;
+    }
+
+#ifdef USE_ZSTD
+    if(zstd_ != nullptr)
+    {
+        ZSTD_inBuffer input = {buffer.data(), buffer.size(), 0};
+        const ZSTD_EndDirective directive = finish ? ZSTD_e_end : ZSTD_e_continue;
+
+        while(true)
+        {
+            ZSTD_outBuffer output = {compressed_.data(), compressed_.size(), 0};
+            const size_t remaining = ZSTD_compressStream2(zstd_, &output, &input, directive);
+            if(ZSTD_isError(remaining))
+            {
+                OPENAUTO_LOG(error) << "[SessionRecorder] compression failed: " << ZSTD_getErrorName(remaining);
+                file_.close();
+                return;
+            }
+
+            file_.write(reinterpret_cast<const char*>(compressed_.data()), output.pos);
+            if(finish ? remaining == 0 : input.pos == input.size)
+            {
+                break;
+            }
+        }
+        return;
+    }
+#endif
+
+    file_.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+}
+
+void SessionRecorder::close()
+{
+#ifdef USE_ZSTD
+    if(zstd_ != nullptr)
+    {
+        ZSTD_freeCCtx(zstd_);
+        zstd_ = nullptr;
+    }
+#endif
+
+    if(file_.is_open())
+    {
+        file_.close();
+        OPENAUTO_LOG(info) << "[SessionRecorder] closed " << fileName_ << ", dropped records: " << droppedRecords_;
+    }
+}
+
+}
+}
+}
+}
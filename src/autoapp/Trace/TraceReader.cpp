@@ -0,0 +1,213 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Trace/TraceReader.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace trace
+{
+
+namespace
+{
+
+template<typename T>
+T readLittleEndian(const uint8_t* data)
+{
+    T value = 0;
+    for(size_t i = 0; i < sizeof(T); ++i)
+    {
+        value |= static_cast<T>(data[i]) << (i * 8);
+    }
+    return value;
+}
+
+}
+
+constexpr size_t TraceReader::cChunkSize;
+constexpr size_t TraceReader::cMaxRecordSize;
+
+TraceReader::TraceReader(std::string fileName)
+    : fileName_(std::move(fileName))
+    , startTimestamp_(0)
+    , position_(0)
+#ifdef USE_ZSTD
+    , zstd_(nullptr)
+    , inputPosition_(0)
+#endif
+{
+
+}
+
+TraceReader::~TraceReader()
+{
+#ifdef USE_ZSTD
+    if(zstd_ != nullptr)
+    {
+        ZSTD_freeDCtx(zstd_);
+    }
+#endif
+}
+
+bool TraceReader::open()
+{
+    file_.open(fileName_, std::ios::in | std::ios::binary);
+    if(!file_.is_open())
+    {
+        OPENAUTO_LOG(error) << "[TraceReader] unable to open " << fileName_;
+        return false;
+    }
+
+    uint8_t header[cFileHeaderSize];
+    file_.read(reinterpret_cast<char*>(header), sizeof(header));
+    if(file_.gcount() != sizeof(header) || std::memcmp(header, cTraceMagic, sizeof(cTraceMagic)) != 0)
+    {
+        OPENAUTO_LOG(error) << "[TraceReader] " << fileName_ << " is not a session trace.";
+        return false;
+    }
+
+    const uint32_t version = readLittleEndian<uint32_t>(header + 8);
+    const uint32_t flags = readLittleEndian<uint32_t>(header + 12);
+    startTimestamp_ = readLittleEndian<uint64_t>(header + 16);
+
+    if(version != cTraceVersion)
+    {
+        OPENAUTO_LOG(error) << "[TraceReader] unsupported trace version " << version;
+        return false;
+    }
+
+    if((flags & cFlagZstd) != 0)
+    {
+#ifdef USE_ZSTD
+        zstd_ = ZSTD_createDCtx();
+#else
+        OPENAUTO_LOG(error) << "[TraceReader] " << fileName_ << " is zstd compressed, rebuild with zstd to read it.";
+        return false;
+#endif
+    }
+
+    return true;
+}
+
+bool TraceReader::read(Record& record)
+{
+    if(!this->fill(4))
+    {
+        return false;
+    }
+
+    const uint32_t length = readLittleEndian<uint32_t>(buffer_.data() + position_);
+    if(length < cRecordHeaderSize || length > cMaxRecordSize)
+    {
+        OPENAUTO_LOG(error) << "[TraceReader] corrupted record length " << length;
+        return false;
+    }
+
+    if(!this->fill(4 + length))
+    {
+        OPENAUTO_LOG(warning) << "[TraceReader] " << fileName_ << " ends in a truncated record.";
+        return false;
+    }
+
+    const uint8_t* data = buffer_.data() + position_ + 4;
+    record.timestamp = readLittleEndian<uint64_t>(data);
+    record.direction = static_cast<Direction>(data[8]);
+    record.channelId = data[9];
+    record.encryptionType = data[10];
+    record.messageType = data[11];
+    record.payload.assign(data + cRecordHeaderSize, data + length);
+
+    position_ += 4 + length;
+    return true;
+}
+
+uint64_t TraceReader::getStartTimestamp() const
+{
+    return startTimestamp_;
+}
+
+bool TraceReader::fill(size_t size)
+{
+    if(position_ >= cChunkSize)
+    {
+        buffer_.erase(buffer_.begin(), buffer_.begin() + position_);
+        position_ = 0;
+    }
+
+    while(buffer_.size() - position_ < size)
+    {
+#ifdef USE_ZSTD
+        if(zstd_ != nullptr)
+        {
+            if(inputPosition_ == input_.size())
+            {
+                if(!this->readChunk(input_))
+                {
+                    return false;
+                }
+                inputPosition_ = 0;
+            }
+
+            const size_t offset = buffer_.size();
+            buffer_.resize(offset + ZSTD_DStreamOutSize());
+
+            ZSTD_inBuffer input = {input_.data(), input_.size(), inputPosition_};
+            ZSTD_outBuffer output = {buffer_.data() + offset, ZSTD_DStreamOutSize(), 0};
+            const size_t result = ZSTD_decompressStream(zstd_, &output, &input);
+
+            inputPosition_ = input.pos;
+            buffer_.resize(offset + output.pos);
+
+            if(ZSTD_isError(result))
+            {
+                OPENAUTO_LOG(error) << "[TraceReader] decompression failed: " << ZSTD_getErrorName(result);
+                return false;
+            }
+            continue;
+        }
+#endif
+
+        Buffer chunk;
+        if(!this->readChunk(chunk))
+        {
+            return false;
+        }
+        buffer_.insert(buffer_.end(), chunk.begin(), chunk.end());
+    }
+
+    return true;
+}
+
+bool TraceReader::readChunk(Buffer& chunk)
+{
+    chunk.resize(cChunkSize);
+    file_.read(reinterpret_cast<char*>(chunk.data()), chunk.size());
+    chunk.resize(file_.gcount());
+    return !chunk.empty();
+}
+
+}
+}
+}
+}
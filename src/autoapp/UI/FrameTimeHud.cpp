@@ -0,0 +1,74 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/UI/FrameTimeHud.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+FrameTimeHud::FrameTimeHud(QWidget* parent)
+    : QLabel(parent)
+    , frames_(0)
+    , totalNsecs_(0)
+    , maxNsecs_(0)
+{
+    this->setAttribute(Qt::WA_TransparentForMouseEvents);
+    this->setStyleSheet("background-color: rgba(0, 0, 0, 160); color: rgb(0, 255, 0); padding: 2px;");
+    this->setText("-- fps");
+    this->adjustSize();
+
+    connect(&timer_, &QTimer::timeout, this, &FrameTimeHud::report);
+    timer_.start(1000);
+}
+
+void FrameTimeHud::addFrame(qint64 nsecs)
+{
+    ++frames_;
+    totalNsecs_ += nsecs;
+    maxNsecs_ = std::max(maxNsecs_, nsecs);
+}
+
+void FrameTimeHud::report()
+{
+    const double average = frames_ > 0 ? totalNsecs_ / frames_ / 1000000.0 : 0.0;
+    const double maximum = maxNsecs_ / 1000000.0;
+    const QString text = QString("%1 fps | avg %2 ms | max %3 ms").arg(frames_).arg(average, 0, 'f', 2).arg(maximum, 0, 'f', 2);
+
+    OPENAUTO_LOG(debug) << "[FrameTimeHud] " << text.toStdString();
+
+    frames_ = 0;
+    totalNsecs_ = 0;
+    maxNsecs_ = 0;
+
+    this->setText(text);
+    this->adjustSize();
+    this->raise();
+}
+
+}
+}
+}
+}
@@ -32,6 +32,9 @@
 #include <QVideoWidget>
 #include <QNetworkInterface>
 #include <QStandardItemModel>
+#include <QSignalBlocker>
+#include <QElapsedTimer>
+#include <QPainter>
 #include <iostream>
 #include <fstream>
 #include <cstdio>
@@ -52,6 +55,17 @@ MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWi
     , ui_(new Ui::MainWindow)
     , localDevice(new QBluetoothLocalDevice)
 {
+    // decode the wallpapers in the background while the rest of the window is set up
+    QScreen* screen = QGuiApplication::primaryScreen();
+    this->wallpaperCache_ = new WallpaperCache(screen == nullptr ? QSize() : screen->geometry().size(), this);
+    if (configuration->openGLRendering()) {
+        // optional GPU composition, the surface stays below every other child of the window
+        this->wallpaperSurface_ = new WallpaperSurface(this->wallpaperCache_, this);
+        this->wallpaperSurface_->lower();
+    } else {
+        connect(this->wallpaperCache_, &WallpaperCache::loaded, this, static_cast<void (QWidget::*)()>(&QWidget::update));
+    }
+
     // set default bg color to black
     this->setStyleSheet("QMainWindow {background-color: rgb(0,0,0);}");
 
@@ -61,6 +75,13 @@ MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWi
     QFont _font(family, 11);
     qApp->setFont(_font);
 
+    // fonts and covers used on every track change, registered and loaded only once
+    this->playingFontLarge = QFont(family, 16, QFont::Bold);
+    this->playingFontLarge.setItalic(true);
+    this->playingFontSmall = QFont(family, 12, QFont::Bold);
+    this->playingFontSmall.setItalic(true);
+    this->defaultCover = QPixmap("://coverlogo.png");
+
     this->configuration_ = configuration;
 
     // trigger files
@@ -87,6 +108,12 @@ MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWi
 
     ui_->setupUi(this);
 
+    if (configuration->showFrameTimes()) {
+        this->frameTimeHud_ = new FrameTimeHud(this);
+        this->frameTimeHud_->move(0, 0);
+        this->frameTimeHud_->raise();
+    }
+
     connect(ui_->pushButtonSettings, &QPushButton::clicked, this, &MainWindow::openSettings);
     connect(ui_->pushButtonSettings2, &QPushButton::clicked, this, &MainWindow::openSettings);
     connect(ui_->pushButtonUpdate, &QPushButton::clicked, this, &MainWindow::openUpdateDialog);
@@ -415,7 +442,7 @@ MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWi
     }
 
     // read param file
-    if (std::ifstream("/boot/crankshaft/volume")) {
+    if (configuration_->getFileStore()->exists("/boot/crankshaft/volume")) {
         // init volume
         QString vol=QString::number(configuration_->readFileContent("/boot/crankshaft/volume").toInt());
         ui_->volumeValueLabel->setText(vol+"%");
@@ -434,6 +461,8 @@ MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWi
     }
 
     // set bg's on startup
+    themeEngine_.setCustomButtonColors(QStringList() << this->custom_button_color_c1 << this->custom_button_color_c2 << this->custom_button_color_c3
+                                                     << this->custom_button_color_c4 << this->custom_button_color_c5 << this->custom_button_color_c6);
     MainWindow::updateBG();
     if (!this->nightModeEnabled) {
         ui_->pushButtonDay->hide();
@@ -509,6 +538,12 @@ MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWi
     // Hide recordings button
     ui_->pushButtonRecordings->hide();
 
+    nowPlaying = new NowPlaying(this);
+    connect(nowPlaying, &NowPlaying::titleChanged, ui_->labelCurrentPlaying, &QLabel::setText);
+    connect(nowPlaying, &NowPlaying::trackChanged, ui_->labelTrack, &QLabel::setText);
+    connect(nowPlaying, &NowPlaying::trackCountChanged, ui_->labelTrackCount, &QLabel::setText);
+    connect(nowPlaying, &NowPlaying::coverChanged, this, [this](const QPixmap& cover) { ui_->pushButtonBack->setIcon(cover); });
+
     player = new QMediaPlayer(this);
     playlist = new QMediaPlaylist(this);
     connect(player, &QMediaPlayer::positionChanged, this, &MainWindow::on_positionChanged);
@@ -553,6 +588,9 @@ MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWi
     watcher->addPath("/media/USBDRIVES");
     connect(watcher, &QFileSystemWatcher::directoryChanged, this, &MainWindow::setTrigger);
 
+    // count layout passes of the whole window, reported once per second by showTime
+    ui_->centralWidget->installEventFilter(this);
+
     watcher_tmp = new QFileSystemWatcher(this);
     watcher_tmp->addPath("/tmp");
     connect(watcher_tmp, &QFileSystemWatcher::directoryChanged, this, &MainWindow::tmpChanged);
@@ -563,8 +601,20 @@ MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWi
     connect(localDevice, SIGNAL(hostModeStateChanged(QBluetoothLocalDevice::HostMode)),
             this, SLOT(hostModeStateChanged(QBluetoothLocalDevice::HostMode)));
 
+    // track connections through BlueZ notifications, connectedDevices() is a blocking D-Bus call
+    connect(localDevice, &QBluetoothLocalDevice::deviceConnected, this, &MainWindow::bluetoothDeviceConnected);
+    connect(localDevice, &QBluetoothLocalDevice::deviceDisconnected, this, &MainWindow::bluetoothDeviceDisconnected);
+    if (localDevice->isValid()) {
+        for (const auto& address : localDevice->connectedDevices()) {
+            this->connectedBluetoothDevices.insert(address.toString());
+        }
+        this->updateBluetoothDevice();
+    }
+
     hostModeStateChanged(localDevice->hostMode());
     updateNetworkInfo();
+
+    connect(configuration_->getFileStore().get(), &configuration::FileStore::fileChanged, this, &MainWindow::onFileChanged);
 }
 
 MainWindow::~MainWindow()
@@ -595,6 +645,21 @@ void f1x::openauto::autoapp::ui::MainWindow::hostModeStateChanged(QBluetoothLoca
     }
 }
 
+void f1x::openauto::autoapp::ui::MainWindow::onFileChanged(const QString& fileName)
+{
+    if (fileName == "/boot/crankshaft/volume") {
+        if (configuration_->getFileStore()->exists(fileName)) {
+            int vol = configuration_->readFileContent(fileName).toInt();
+            // volume file is written by autoapp_helper in response to the slider, don't echo it back
+            QSignalBlocker blocker(ui_->horizontalSliderVolume);
+            ui_->horizontalSliderVolume->setValue(vol);
+            ui_->volumeValueLabel->setText(QString::number(vol) + "%");
+        }
+    } else if (fileName == "/tmp/btdevice") {
+        this->updateBluetoothDevice();
+    }
+}
+
 void f1x::openauto::autoapp::ui::MainWindow::updateNetworkInfo()
 {
     QNetworkInterface wlan0if = QNetworkInterface::interfaceFromName("wlan0");
@@ -605,7 +670,7 @@ void f1x::openauto::autoapp::ui::MainWindow::updateNetworkInfo()
             //qDebug() << "wlan0: " << wlan0.ip();
             ui_->value_ip->setText(wlan0.ip().toString().simplified());
             ui_->value_mask->setText(wlan0.netmask().toString().simplified());
-            if (std::ifstream("/tmp/hotspot_active")) {
+            if (configuration_->getFileStore()->exists("/tmp/hotspot_active")) {
                 ui_->value_ssid->setText(configuration_->getParamFromFile("/etc/hostapd/hostapd.conf","ssid"));
             } else {
                 ui_->value_ssid->setText(configuration_->readFileContent("/tmp/wifi_ssid"));
@@ -774,62 +839,80 @@ void f1x::openauto::autoapp::ui::MainWindow::on_horizontalSliderVolume_valueChan
 
 void f1x::openauto::autoapp::ui::MainWindow::updateAlpha()
 {
-    int value = configuration_->getAlphaTrans();
-    //int n = snprintf(this->alpha_str, 5, "%d", value);
-
-    if (value != this->alpha_current_str) {
-        this->alpha_current_str = value;
-        double alpha = value/100.0;
-        QString alp=QString::number(alpha);
-        ui_->pushButtonExit->setStyleSheet( "QPushButton{background-color: rgba(164, 0, 0, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonShutdown->setStyleSheet( "QPushButton{background-color: rgba(239, 41, 41, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonReboot->setStyleSheet( "QPushButton{background-color: rgba(252, 175, 62, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonCancel->setStyleSheet( "QPushButton{background-color: rgba(32, 74, 135, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonBrightness->setStyleSheet( "QPushButton{background-color: rgba(245, 121, 0, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonVolume->setStyleSheet( "QPushButton{background-color: rgba(64, 191, 191, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonLock->setStyleSheet( "QPushButton{background-color: rgba(15, 54, 5, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonSettings->setStyleSheet( "QPushButton{background-color: rgba(138, 226, 52, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonDay->setStyleSheet( "QPushButton{background: rgba(252, 233, 79, " + alp + " );  outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonNight->setStyleSheet( "QPushButton{background-color: rgba(114, 159, 207, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonCameraShow->setStyleSheet( "QPushButton{background-color: rgba(100, 62, 4, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonWifi->setStyleSheet( "QPushButton{background-color: rgba(252, 175, 62, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonToggleGUI->setStyleSheet( "QPushButton{background-color: rgba(237, 164, 255, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButton_c1->setStyleSheet( "QPushButton{background-color: rgba(" + this->custom_button_color_c1 + ", " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButton_c2->setStyleSheet( "QPushButton{background-color: rgba(" + this->custom_button_color_c2 + ", " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButton_c3->setStyleSheet( "QPushButton{background-color: rgba(" + this->custom_button_color_c3 + ", " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButton_c4->setStyleSheet( "QPushButton{background-color: rgba(" + this->custom_button_color_c4 + ", " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButton_c5->setStyleSheet( "QPushButton{background-color: rgba(" + this->custom_button_color_c5 + ", " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButton_c6->setStyleSheet( "QPushButton{background-color: rgba(" + this->custom_button_color_c6 + ", " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonDummy1->setStyleSheet( "QPushButton{background-color: rgba(186, 189, 182, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonDummy2->setStyleSheet( "QPushButton{background-color: rgba(186, 189, 182, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonDummy3->setStyleSheet( "QPushButton{background-color: rgba(186, 189, 182, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonDebug->setStyleSheet( "QPushButton{background-color: rgba(85, 87, 83, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonMusic->setStyleSheet( "QPushButton{background-color: rgba(78, 154, 6, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255);} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->pushButtonAndroidAuto->setStyleSheet( "QPushButton{background-color: rgba(48, 140, 198, " + alp + " ); outline-style: dotted; outline-color: #92a8d1; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255); border-bottom: 0px; border-top: 0px;} QPushButton:focus {border: 2px solid rgba(125,125,125,0.5);}");
-        ui_->labelAndroidAutoBottom->setStyleSheet( "background-color: rgba(48, 140, 198, " + alp + " ); border-bottom-left-radius: 4px; border-bottom-right-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255); border-top: 0px;");
-        ui_->labelAndroidAutoTop->setStyleSheet( "background-color: rgba(48, 140, 198, " + alp + " ); border-top-left-radius: 4px; border-top-right-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255); border-bottom: 0px;");
-        ui_->pushButtonNoDevice->setStyleSheet( "background-color: rgba(48, 140, 198, " + alp + " ); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255);");
-        ui_->pushButtonNoWiFiDevice->setStyleSheet( "background-color: rgba(252, 175, 62, " + alp + " ); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255);");
-        // old style
-        ui_->pushButtonSettings2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonLock2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonMusic2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonBrightness2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonToggleGUI2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonExit2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonShutdown2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonReboot2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonCancel2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonAndroidAuto2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonNoDevice2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonWifi2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonNoWiFiDevice2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonDay2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonNight2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonCameraShow2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonVolume2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
-        ui_->pushButtonDebug2->setStyleSheet( "background-color: rgba(136, 138, 133, " + alp + " ); color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);");
+    this->applyTheme();
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::applyTheme()
+{
+    const int alpha = configuration_->getAlphaTrans();
+
+    if (alpha == this->alpha_current_str) {
+        return;
+    }
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    this->setStyleSheet(themeEngine_.getStyleSheet(alpha));
+    this->alpha_current_str = alpha;
+
+    OPENAUTO_LOG(debug) << "[MainWindow] theme applied in " << elapsed.nsecsElapsed() / 1000 << " us";
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::setWallpaper(WallpaperCache::Wallpaper wallpaper)
+{
+    if (wallpaper != this->currentWallpaper_) {
+        this->currentWallpaper_ = wallpaper;
+        if (this->wallpaperSurface_ != nullptr) {
+            this->wallpaperSurface_->setWallpaper(wallpaper);
+        } else {
+            this->update();
+        }
+    }
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::paintEvent(QPaintEvent *event)
+{
+    QMainWindow::paintEvent(event);
+    if (this->wallpaperSurface_ != nullptr) {
+        return;
+    }
+
+    const QPixmap& wallpaper = wallpaperCache_->get(this->currentWallpaper_);
+    if (!wallpaper.isNull()) {
+        QPainter painter(this);
+        painter.drawPixmap((this->width() - wallpaper.width()) / 2, (this->height() - wallpaper.height()) / 2, wallpaper);
+    }
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::resizeEvent(QResizeEvent *event)
+{
+    QMainWindow::resizeEvent(event);
+    if (this->wallpaperSurface_ != nullptr) {
+        this->wallpaperSurface_->setGeometry(this->rect());
+    }
+}
+
+bool f1x::openauto::autoapp::ui::MainWindow::event(QEvent *event)
+{
+    // an UpdateRequest paints every dirty widget and flushes the window, that is one frame
+    if (this->frameTimeHud_ == nullptr || event->type() != QEvent::UpdateRequest) {
+        return QMainWindow::event(event);
+    }
+
+    QElapsedTimer frameTimer;
+    frameTimer.start();
+    const bool result = QMainWindow::event(event);
+    this->frameTimeHud_->addFrame(frameTimer.nsecsElapsed());
+    return result;
+}
+
+bool f1x::openauto::autoapp::ui::MainWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == ui_->centralWidget && event->type() == QEvent::LayoutRequest) {
+        ++this->layoutRequests_;
     }
+    return QMainWindow::eventFilter(watched, event);
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::switchGuiToNight()
@@ -899,11 +982,7 @@ void f1x::openauto::autoapp::ui::MainWindow::cameraControlShow()
 
 void f1x::openauto::autoapp::ui::MainWindow::playerShow()
 {
-    if (this->wallpaperEQFileExists) {
-        this->setStyleSheet("QMainWindow { background: url(wallpaper-eq.png); background-repeat: no-repeat; background-position: center; }");
-    } else {
-        this->setStyleSheet("QMainWindow { background: url(:/black.png); background-repeat: no-repeat; background-position: center; }");
-    }
+    this->setWallpaper(this->wallpaperEQFileExists ? WallpaperCache::Wallpaper::EQ : WallpaperCache::Wallpaper::NONE);
 
     if (!this->oldGUIStyle) {
         ui_->menuWidget->hide();
@@ -1010,59 +1089,40 @@ void f1x::openauto::autoapp::ui::MainWindow::toggleGUI()
 
 void f1x::openauto::autoapp::ui::MainWindow::updateBG()
 {
-    if (this->date_text == "12/24") {
-        this->setStyleSheet("QMainWindow { background: url(:/wallpaper-christmas.png); background-repeat: no-repeat; background-position: center; }");
-        this->holidaybg = true;
-    }
-    else if (this->date_text == "12/31") {
-        this->setStyleSheet("QMainWindow { background: url(:/wallpaper-firework.png); background-repeat: no-repeat; background-position: center; }");
-        this->holidaybg = true;
-    }
-    if (!this->nightModeEnabled) {
-        if (ui_->mediaWidget->isVisible() == true) {
-            if (this->wallpaperEQFileExists) {
-                this->setStyleSheet("QMainWindow { background: url(wallpaper-eq.png); background-repeat: no-repeat; background-position: center; }");
-            } else {
-                this->setStyleSheet("QMainWindow { background: url(:/black.png); background-repeat: repeat; background-position: center; }");
+    WallpaperCache::Wallpaper wallpaper = WallpaperCache::Wallpaper::NONE;
+    this->holidaybg = (this->date_text == "12/24" || this->date_text == "12/31");
+
+    if (ui_->mediaWidget->isVisible() == true) {
+        if (this->wallpaperEQFileExists) {
+            wallpaper = WallpaperCache::Wallpaper::EQ;
+        }
+    } else if (this->date_text == "12/24") {
+        wallpaper = WallpaperCache::Wallpaper::CHRISTMAS;
+    } else if (this->date_text == "12/31") {
+        wallpaper = WallpaperCache::Wallpaper::FIREWORK;
+    } else if (!this->nightModeEnabled) {
+        if (this->oldGUIStyle) {
+            if (this->wallpaperClassicDayFileExists) {
+                wallpaper = WallpaperCache::Wallpaper::CLASSIC_DAY;
             }
         } else {
-            if (this->oldGUIStyle) {
-                if (this->wallpaperClassicDayFileExists) {
-                    this->setStyleSheet("QMainWindow { background: url(wallpaper-classic.png); background-repeat: no-repeat; background-position: center; }");
-                } else {
-                    this->setStyleSheet("QMainWindow { background: url(:/black.png); background-repeat: repeat; background-position: center; }");
-                }
-            } else {
-                if (this->wallpaperDayFileExists) {
-                    this->setStyleSheet("QMainWindow { background: url(wallpaper.png); background-repeat: no-repeat; background-position: center; }");
-                } else {
-                    this->setStyleSheet("QMainWindow { background: url(:/black.png); background-repeat: repeat; background-position: center; }");
-                }
+            if (this->wallpaperDayFileExists) {
+                wallpaper = WallpaperCache::Wallpaper::DAY;
             }
         }
     } else {
-        if (ui_->mediaWidget->isVisible() == true) {
-            if (this->wallpaperEQFileExists) {
-                this->setStyleSheet("QMainWindow { background: url(wallpaper-eq.png); background-repeat: no-repeat; background-position: center; }");
-            } else {
-                this->setStyleSheet("QMainWindow { background: url(:/black.png); background-repeat: repeat; background-position: center; }");
+        if (this->oldGUIStyle) {
+            if (this->wallpaperClassicNightFileExists) {
+                wallpaper = WallpaperCache::Wallpaper::CLASSIC_NIGHT;
             }
         } else {
-            if (this->oldGUIStyle) {
-                if (this->wallpaperClassicNightFileExists) {
-                    this->setStyleSheet( "QMainWindow { background: url(wallpaper-classic-night.png); background-repeat: no-repeat; background-position: center; }");
-                } else {
-                    this->setStyleSheet("QMainWindow { background: url(:/black.png); background-repeat: repeat; background-position: center; }");
-                }
-            } else {
-                if (this->wallpaperNightFileExists) {
-                    this->setStyleSheet("QMainWindow { background: url(wallpaper-night.png) stretch stretch; background-repeat: no-repeat; background-position: center; }");
-                } else {
-                    this->setStyleSheet("QMainWindow { background: url(:/black.png); background-repeat: repeat; background-position: center; }");
-                }
+            if (this->wallpaperNightFileExists) {
+                wallpaper = WallpaperCache::Wallpaper::NIGHT;
             }
         }
     }
+
+    this->setWallpaper(wallpaper);
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::createDebuglog()
@@ -1088,51 +1148,63 @@ void f1x::openauto::autoapp::ui::MainWindow::setUnMute()
 void f1x::openauto::autoapp::ui::MainWindow::showTime()
 {
     QTime time=QTime::currentTime();
-    QDate date=QDate::currentDate();
     QString time_text=time.toString("hh : mm : ss");
-    this->date_text=date.toString("MM/dd");
 
     if ((time.second() % 2) == 0) {
         time_text[3] = ' ';
         time_text[8] = ' ';
     }
 
-    ui_->Digital_clock->setText(time_text);
-    ui_->bigClock->setText(time_text);
-    ui_->bigClock2->setText(time_text);
+    // the tick is only a clock, skip relayouting the labels if nothing changed
+    if (time_text != this->clock_text) {
+        this->clock_text = time_text;
+        ui_->Digital_clock->setText(time_text);
+        ui_->bigClock->setText(time_text);
+        ui_->bigClock2->setText(time_text);
+    }
 
-    if (!this->holidaybg) {
-        if (this->date_text == "12/24") {
-            MainWindow::updateBG();
-        }
-        else if (this->date_text == "12/31") {
+    const QString date_text = QDate::currentDate().toString("MM/dd");
+    if (date_text != this->date_text) {
+        this->date_text = date_text;
+
+        // switch to and back from the holiday wallpaper when the date rolls over
+        if (this->holidaybg != (this->date_text == "12/24" || this->date_text == "12/31")) {
             MainWindow::updateBG();
         }
     }
 
-    // check connected devices
-    if (localDevice->isValid()) {
-        QString localDeviceName = localDevice->name();
-        QString localDeviceAddress = localDevice->address().toString();
-        QList<QBluetoothAddress> btdevices;
-        btdevices = localDevice->connectedDevices();
-
-        int count = btdevices.count();
-        if (count > 0) {
-            //QBluetoothAddress btdevice = btdevices[0];
-            //QString btmac = btdevice.toString();
-            //ui_->btDeviceCount->setText(QString::number(count));
-            if (ui_->btDevice->isVisible() == false) {
-                ui_->btDevice->show();
-            }
-            if (std::ifstream("/tmp/btdevice")) {
-                ui_->btDevice->setText(configuration_->readFileContent("/tmp/btdevice"));
-            }
-        } else {
-            if (ui_->btDevice->isVisible() == true) {
-                ui_->btDevice->hide();
-                ui_->btDevice->setText("BT-Device");
-            }
+    if (this->layoutRequests_ > 0 || this->reconcilePasses_ > 0) {
+        OPENAUTO_LOG(debug) << "[MainWindow] " << this->layoutRequests_ << " relayouts, " << this->reconcilePasses_ << " state changes in the last second";
+        this->layoutRequests_ = 0;
+        this->reconcilePasses_ = 0;
+    }
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::bluetoothDeviceConnected(const QBluetoothAddress& address)
+{
+    this->connectedBluetoothDevices.insert(address.toString());
+    this->updateBluetoothDevice();
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::bluetoothDeviceDisconnected(const QBluetoothAddress& address)
+{
+    this->connectedBluetoothDevices.remove(address.toString());
+    this->updateBluetoothDevice();
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::updateBluetoothDevice()
+{
+    if (!this->connectedBluetoothDevices.isEmpty()) {
+        if (ui_->btDevice->isVisible() == false) {
+            ui_->btDevice->show();
+        }
+        if (configuration_->getFileStore()->exists("/tmp/btdevice")) {
+            ui_->btDevice->setText(configuration_->readFileContent("/tmp/btdevice"));
+        }
+    } else {
+        if (ui_->btDevice->isVisible() == true) {
+            ui_->btDevice->hide();
+            ui_->btDevice->setText("BT-Device");
         }
     }
 }
@@ -1173,7 +1245,7 @@ void f1x::openauto::autoapp::ui::MainWindow::on_pushButtonPlayerStop_clicked()
 {
     ui_->mp3List->setCurrentRow(playlist->currentIndex());
     player->stop();
-    ui_->pushButtonBack->setIcon(QPixmap("://coverlogo.png"));
+    nowPlaying->setCover(this->defaultCover);
     ui_->pushButtonPlayerPause->setStyleSheet( "background-color: rgb(233, 185, 110); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(0,0,0);");
     ui_->mp3selectWidget->show();
     ui_->PlayerPlayingWidget->hide();
@@ -1183,8 +1255,8 @@ void f1x::openauto::autoapp::ui::MainWindow::on_pushButtonPlayerStop_clicked()
     ui_->pushButtonList->hide();
     ui_->pushButtonPlayerPause->hide();
     ui_->playerPositionTime->setText("00:00 / 00:00");
-    ui_->labelCurrentPlaying->setText("");
-    ui_->labelTrack->setText("");
+    nowPlaying->setTitle("");
+    nowPlaying->setTrack("");
     ui_->Info->hide();
     ui_->horizontalSliderProgressPlayer->hide();
 
@@ -1264,21 +1336,14 @@ void f1x::openauto::autoapp::ui::MainWindow::metaDataChanged()
     QString filename = QFileInfo(fullpathplaying).fileName();
 
     QImage img = player->metaData(QMediaMetaData::CoverArtImage).value<QImage>();
-    QImage imgscaled = img.scaled(270,270,Qt::IgnoreAspectRatio);
-    if (!imgscaled.isNull()) {
-        ui_->pushButtonBack->setIcon(QPixmap::fromImage(imgscaled));
+    if (!img.isNull()) {
+        nowPlaying->setCover(QPixmap::fromImage(img.scaled(270,270,Qt::IgnoreAspectRatio)));
     } else {
         if (playlist->currentIndex() != -1 && fullpathplaying != "") {
             QString filename = ui_->mp3List->item(playlist->currentIndex())->text();
-            QString cover = this->musicfolder + "/" + this->albumfolder + "/" + filename + ".png";
-            if (check_file_exist(cover.toStdString().c_str())) {
-                QPixmap img = cover;
-                ui_->pushButtonBack->setIcon(img.scaled(270,270,Qt::KeepAspectRatio));
-            } else {
-                ui_->pushButtonBack->setIcon(QPixmap("://coverlogo.png"));
-            }
+            nowPlaying->setCover(findCover(QStringList() << this->musicfolder + "/" + this->albumfolder + "/" + filename + ".png"));
         } else {
-            ui_->pushButtonBack->setIcon(QPixmap("://coverlogo.png"));
+            nowPlaying->setCover(this->defaultCover);
         }
     }
 
@@ -1286,20 +1351,11 @@ void f1x::openauto::autoapp::ui::MainWindow::metaDataChanged()
         // use metadata from mp3list widget (prescanned id3 by taglib)
         if (playlist->currentIndex() != -1 && fullpathplaying != "") {
             QString currentsong = ui_->mp3List->item(playlist->currentIndex())->text();
-            ui_->labelCurrentPlaying->setText(currentsong);
-            if (currentsong.length() > 48) {
-                int id = QFontDatabase::addApplicationFont(":/Roboto-Regular.ttf");
-                QString family = QFontDatabase::applicationFontFamilies(id).at(0);
-                QFont _font(family, 12, QFont::Bold);
-                _font.setItalic(true);
-                ui_->labelCurrentPlaying->setFont(_font);
-            } else {
-                int id = QFontDatabase::addApplicationFont(":/Roboto-Regular.ttf");
-                QString family = QFontDatabase::applicationFontFamilies(id).at(0);
-                QFont _font(family, 16, QFont::Bold);
-                _font.setItalic(true);
-                ui_->labelCurrentPlaying->setFont(_font);
+            const QFont& font = currentsong.length() > 48 ? this->playingFontSmall : this->playingFontLarge;
+            if (ui_->labelCurrentPlaying->font() != font) {
+                ui_->labelCurrentPlaying->setFont(font);
             }
+            nowPlaying->setTitle(currentsong);
         }
     } catch (...) {
         // use metadata from player
@@ -1320,34 +1376,19 @@ void f1x::openauto::autoapp::ui::MainWindow::metaDataChanged()
         if (Title != "") {
             currentPlaying.append(Title);
         }
-        ui_->labelCurrentPlaying->setText(currentPlaying);
+        nowPlaying->setTitle(currentPlaying);
     }
-    ui_->labelTrack->setText(QString::number(playlist->currentIndex()+1));
-    ui_->labelTrackCount->setText(QString::number(playlist->mediaCount()));
+    nowPlaying->setTrack(QString::number(playlist->currentIndex()+1));
+    nowPlaying->setTrackCount(QString::number(playlist->mediaCount()));
 
     if (playlist->currentIndex() == -1) {
         // check for folder icon
-        QString coverpng = this->musicfolder + "/" + this->albumfolder + "/folder.png";
-        QString coverjpg = this->musicfolder + "/" + this->albumfolder + "/folder.jpg";
-        QString coverpngcs = "/media/USBDRIVES/CSSTORAGE/COVERCACHE/" + this->albumfolder + ".png";
-        QString coverjpgcs = "/media/USBDRIVES/CSSTORAGE/COVERCACHE/" + this->albumfolder + ".jpg";
-
-        if (check_file_exist(coverpng.toStdString().c_str())) {
-            QPixmap img = coverpng;
-            ui_->pushButtonBack->setIcon(img.scaled(270,270,Qt::KeepAspectRatio));
-        } else if (check_file_exist(coverjpg.toStdString().c_str())) {
-            QPixmap img = coverjpg;
-            ui_->pushButtonBack->setIcon(img.scaled(270,270,Qt::KeepAspectRatio));
-        } else if (check_file_exist(coverpngcs.toStdString().c_str())) {
-            QPixmap img = coverpngcs;
-            ui_->pushButtonBack->setIcon(img.scaled(270,270,Qt::KeepAspectRatio));
-        } else if (check_file_exist(coverjpgcs.toStdString().c_str())) {
-            QPixmap img = coverjpgcs;
-            ui_->pushButtonBack->setIcon(img.scaled(270,270,Qt::KeepAspectRatio));
-        } else {
-            ui_->pushButtonBack->setIcon(QPixmap("://coverlogo.png"));
-        }
-        ui_->labelCurrentPlaying->setText(ui_->comboBoxAlbum->currentText());
+        nowPlaying->setCover(findCover(QStringList()
+                                       << this->musicfolder + "/" + this->albumfolder + "/folder.png"
+                                       << this->musicfolder + "/" + this->albumfolder + "/folder.jpg"
+                                       << "/media/USBDRIVES/CSSTORAGE/COVERCACHE/" + this->albumfolder + ".png"
+                                       << "/media/USBDRIVES/CSSTORAGE/COVERCACHE/" + this->albumfolder + ".jpg"));
+        nowPlaying->setTitle(ui_->comboBoxAlbum->currentText());
         ui_->pushButtonPlayerStop->hide();
         ui_->pushButtonPlayerPause->hide();
         ui_->pushButtonPlayerPlayList->show();
@@ -1359,12 +1400,32 @@ void f1x::openauto::autoapp::ui::MainWindow::metaDataChanged()
     this->configuration_->save();
 }
 
+QPixmap f1x::openauto::autoapp::ui::MainWindow::findCover(const QStringList& fileNames)
+{
+    for (const auto& fileName : fileNames) {
+        QPixmap* cover = this->coverCache.object(fileName);
+        if (cover == nullptr) {
+            // missing files are cached as null pixmaps so they are not probed again
+            QPixmap img;
+            if (check_file_exist(fileName.toStdString().c_str())) {
+                img = QPixmap(fileName).scaled(270,270,Qt::KeepAspectRatio);
+            }
+            cover = new QPixmap(img);
+            this->coverCache.insert(fileName, cover);
+        }
+        if (!cover->isNull()) {
+            return *cover;
+        }
+    }
+    return this->defaultCover;
+}
+
 void f1x::openauto::autoapp::ui::MainWindow::on_pushButtonPlayerPlayList_clicked()
 {
     player->setPlaylist(this->playlist);
     playlist->setCurrentIndex(this->currentPlaylistIndex);
     player->play();
-    ui_->pushButtonBack->setIcon(QPixmap("://coverlogo.png"));
+    nowPlaying->setCover(this->defaultCover);
     ui_->mp3selectWidget->hide();
     ui_->PlayerPlayingWidget->show();
     ui_->pushButtonPlayerPlayList->hide();
@@ -1399,7 +1460,7 @@ void f1x::openauto::autoapp::ui::MainWindow::on_comboBoxAlbum_currentIndexChange
     ui_->pushButtonPlayerStop->hide();
     ui_->pushButtonList->hide();
     ui_->pushButtonBackToPlayer->hide();
-    ui_->labelCurrentPlaying->setText("");
+    nowPlaying->setTitle("");
     ui_->playerPositionTime->setText("");
 
     if (this->playlist->mediaCount() < 2) {
@@ -1438,6 +1499,7 @@ void f1x::openauto::autoapp::ui::MainWindow::scanFolders()
     try {
         if (this->mediacontentchanged == true) {
             this->mediacontentchanged = false;
+            this->coverCache.clear();
             int cleaner = ui_->comboBoxAlbum->count();
             while (cleaner > -1) {
                 ui_->comboBoxAlbum->removeItem(cleaner);
@@ -1739,117 +1801,6 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
         OPENAUTO_LOG(error) << "[OpenAuto] Error in entityexit";
     }
 
-    // check if system is in display off mode (tap2wake)
-    if (std::ifstream("/tmp/blankscreen")) {
-        if (ui_->centralWidget->isVisible() == true) {
-            CloseAllDialogs();
-            ui_->centralWidget->hide();
-        }
-    } else {
-        if (ui_->centralWidget->isVisible() == false) {
-            ui_->centralWidget->show();
-        }
-    }
-
-    // check if system is in display off mode (tap2wake/screensaver)
-    if (std::ifstream("/tmp/screensaver")) {
-        if (ui_->menuWidget->isVisible() == true) {
-            ui_->menuWidget->hide();
-        }
-        if (ui_->oldmenuWidget->isVisible() == true) {
-            ui_->oldmenuWidget->hide();
-        }
-        if (ui_->headerWidget->isVisible() == true) {
-            ui_->headerWidget->hide();
-            CloseAllDialogs();
-        }
-        if (ui_->mediaWidget->isVisible() == true) {
-            ui_->mediaWidget->hide();
-        }
-        if (ui_->cameraWidget->isVisible() == true) {
-            ui_->cameraWidget->hide();
-        }
-        if (ui_->VolumeSliderControlPlayer->isVisible() == true) {
-            ui_->VolumeSliderControlPlayer->hide();
-        }
-        if (ui_->VolumeSliderControl->isVisible() == true) {
-            ui_->VolumeSliderControl->hide();
-        }
-        if (ui_->BrightnessSliderControl->isVisible() == true) {
-            ui_->BrightnessSliderControl->hide();
-        }
-        cameraHide();
-        if (ui_->clockOnlyWidget->isVisible() == false) {
-            ui_->clockOnlyWidget->show();
-        }
-    } else {
-        if (ui_->headerWidget->isVisible() == false) {
-            ui_->headerWidget->show();
-        }
-        if (ui_->VolumeSliderControl->isVisible() == false) {
-            if (ui_->mediaWidget->isVisible() == false) {
-                ui_->VolumeSliderControl->show();
-            }
-        }
-        if (ui_->clockOnlyWidget->isVisible() == true) {
-            ui_->clockOnlyWidget->hide();
-            toggleGUI();
-            toggleGUI();
-            updateBG();
-        }
-    }
-
-    // check if custom command needs black background
-    if (std::ifstream("/tmp/blackscreen")) {
-        if (ui_->centralWidget->isVisible() == true) {
-            ui_->centralWidget->hide();
-            this->setStyleSheet("QMainWindow {background-color: rgb(0,0,0);}");
-            this->background_set = false;
-        }
-    } else {
-        if (this->background_set == false) {
-            f1x::openauto::autoapp::ui::MainWindow::updateBG();
-            this->background_set = true;
-        }
-    }
-
-    // check if phone is conencted to usb
-    if (std::ifstream("/tmp/android_device")) {
-        if (ui_->ButtonAndroidAuto->isVisible() == false) {
-            ui_->ButtonAndroidAuto->show();
-            ui_->pushButtonNoDevice->hide();
-        }
-        if (ui_->pushButtonAndroidAuto2->isVisible() == false) {
-            ui_->pushButtonAndroidAuto2->show();
-            ui_->pushButtonNoDevice2->hide();
-        }
-        try {
-            QFile deviceData(QString("/tmp/android_device"));
-            deviceData.open(QIODevice::ReadOnly);
-            QTextStream data_date(&deviceData);
-            data_date.readLine();
-            // wait for second line to be written
-            QString linedate;
-            while (linedate.isNull()) {
-                linedate = data_date.readLine();
-            }
-            deviceData.close();
-            ui_->labelAndroidAutoBottom->setText(linedate.simplified().replace("_"," "));
-        } catch (...) {
-            ui_->labelAndroidAutoBottom->setText("");
-        }
-    } else {
-        if (ui_->ButtonAndroidAuto->isVisible() == true) {
-            ui_->pushButtonNoDevice->show();
-            ui_->ButtonAndroidAuto->hide();
-        }
-        if (ui_->pushButtonAndroidAuto2->isVisible() == true) {
-            ui_->pushButtonNoDevice2->show();
-            ui_->pushButtonAndroidAuto2->hide();
-        }
-        ui_->labelAndroidAutoBottom->setText("");
-    }
-
     // check if bluetooth pairable
     if (this->bluetoothEnabled) {
         if (std::ifstream("/tmp/bluetooth_pairable")) {
@@ -1970,55 +1921,6 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
         f1x::openauto::autoapp::ui::MainWindow::MainWindow::exit();
     }
 
-    this->hotspotActive = check_file_exist("/tmp/hotspot_active");
-
-    // hide wifi if hotspot disabled and force wifi unselected
-    if (!this->hotspotActive && !std::ifstream("/tmp/mobile_hotspot_detected")) {
-        if ((ui_->AAWIFIWidget->isVisible() == true) || (ui_->AAWIFIWidget2->isVisible() == true)){
-            ui_->AAWIFIWidget->hide();
-            ui_->AAWIFIWidget2->hide();
-            ui_->AAUSBWidget->show();
-            ui_->AAUSBWidget2->show();
-        }
-    } else {
-        if ((ui_->AAWIFIWidget->isVisible() == false) || (ui_->AAWIFIWidget2->isVisible() == false)) {
-            ui_->AAWIFIWidget->show();
-            ui_->AAWIFIWidget2->show();
-            ui_->AAUSBWidget->hide();
-            ui_->AAUSBWidget2->hide();
-        }
-    }
-
-    if (std::ifstream("/tmp/temp_recent_list") || std::ifstream("/tmp/mobile_hotspot_detected")) {
-        if (ui_->pushButtonWifi->isVisible() == false) {
-            ui_->pushButtonWifi->show();
-            ui_->pushButtonWifi->setFocus();
-        }
-        if (ui_->pushButtonNoWiFiDevice->isVisible() == true) {
-            ui_->pushButtonNoWiFiDevice->hide();
-        }
-        if (ui_->pushButtonWifi2->isVisible() == false) {
-            ui_->pushButtonWifi2->show();
-            ui_->pushButtonWifi2->setFocus();
-        }
-        if (ui_->pushButtonNoWiFiDevice2->isVisible() == true) {
-            ui_->pushButtonNoWiFiDevice2->hide();
-        }
-    } else {
-        if (ui_->pushButtonWifi->isVisible() == true) {
-            ui_->pushButtonWifi->hide();
-        }
-        if (ui_->pushButtonNoWiFiDevice->isVisible() == false) {
-            ui_->pushButtonNoWiFiDevice->show();
-        }
-        if (ui_->pushButtonWifi2->isVisible() == true) {
-            ui_->pushButtonWifi2->hide();
-        }
-        if (ui_->pushButtonNoWiFiDevice2->isVisible() == false) {
-            ui_->pushButtonNoWiFiDevice2->show();
-        }
-    }
-
     // handle dummys in classic menu
     int button_count = 0;
     if (ui_->pushButtonCameraShow2->isVisible() == true) {
@@ -2120,14 +2022,15 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
     }
 
     // read value from tsl2561
-    if (std::ifstream("/tmp/tsl2561") && this->configuration_->showLux()) {
+    if (this->configuration_->showLux() && configuration_->getFileStore()->exists("/tmp/tsl2561")) {
         if (ui_->label_left->isVisible() == false) {
             ui_->label_left->show();
             ui_->label_right->show();
         }
         ui_->label_left->setText("Lux: " + configuration_->readFileContent("/tmp/tsl2561"));
     } else {
-        if (ui_->label_left->isVisible() == true) {
+        // the update notification shares these labels, the reconciler owns them while it is shown
+        if (ui_->label_left->isVisible() == true && !this->screenState_.updateAvailable) {
             ui_->label_left->hide();
             ui_->label_right->hide();
             ui_->label_left->setText("");
@@ -2142,9 +2045,130 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
     this->openautoupdate = check_file_exist("/tmp/openauto_update_available");
     this->systemupdate = check_file_exist("/tmp/system_update_available");
 
-    if (this->csmtupdate || this->udevupdate || this->openautoupdate || this->systemupdate) {
-        if (ui_->pushButtonUpdate->isVisible() == false) {
-            ui_->pushButtonUpdate->show();
+    this->hotspotActive = check_file_exist("/tmp/hotspot_active");
+
+    this->reconcile(this->readScreenState());
+    updateNetworkInfo();
+}
+
+f1x::openauto::autoapp::ui::ScreenState f1x::openauto::autoapp::ui::MainWindow::readScreenState()
+{
+    ScreenState state;
+    state.blank = check_file_exist("/tmp/blankscreen");
+    state.screensaver = check_file_exist("/tmp/screensaver");
+    state.blackscreen = check_file_exist("/tmp/blackscreen");
+    state.androidDevice = check_file_exist("/tmp/android_device");
+
+    bool mobileHotspot = check_file_exist("/tmp/mobile_hotspot_detected");
+    state.hotspot = this->hotspotActive || mobileHotspot;
+    state.wifiDevice = mobileHotspot || check_file_exist("/tmp/temp_recent_list");
+
+    state.updateAvailable = this->csmtupdate || this->udevupdate || this->openautoupdate || this->systemupdate;
+    state.locked = check_file_exist("/tmp/btdevice") || check_file_exist("/tmp/media_playing") || check_file_exist("/tmp/dev_mode_enabled") || state.androidDevice;
+    return state;
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::reconcile(const ScreenState& state)
+{
+    // the first pass applies everything, later passes only what differs from the last applied state
+    const bool all = !this->screenStateValid_;
+    const ScreenState& last = this->screenState_;
+    if (!all && state == last) {
+        return;
+    }
+
+    // one repaint for the whole batch instead of one per show()/hide()
+    this->setUpdatesEnabled(false);
+
+    if (all || state.blank != last.blank || state.blackscreen != last.blackscreen) {
+        if (state.blank && (all || !last.blank)) {
+            CloseAllDialogs();
+        }
+        ui_->centralWidget->setVisible(!state.blank && !state.blackscreen);
+    }
+
+    if (all || state.screensaver != last.screensaver) {
+        if (state.screensaver) {
+            ui_->menuWidget->hide();
+            ui_->oldmenuWidget->hide();
+            ui_->headerWidget->hide();
+            CloseAllDialogs();
+            ui_->mediaWidget->hide();
+            ui_->cameraWidget->hide();
+            ui_->VolumeSliderControlPlayer->hide();
+            ui_->VolumeSliderControl->hide();
+            ui_->BrightnessSliderControl->hide();
+            cameraHide();
+            ui_->clockOnlyWidget->show();
+        } else {
+            ui_->headerWidget->show();
+            if (ui_->mediaWidget->isVisible() == false) {
+                ui_->VolumeSliderControl->show();
+            }
+            if (ui_->clockOnlyWidget->isVisible() == true) {
+                ui_->clockOnlyWidget->hide();
+                this->restoreMenu();
+            }
+        }
+    }
+
+    if (all || state.blackscreen != last.blackscreen) {
+        if (state.blackscreen) {
+            this->setWallpaper(WallpaperCache::Wallpaper::NONE);
+            this->background_set = false;
+        } else if (this->background_set == false) {
+            f1x::openauto::autoapp::ui::MainWindow::updateBG();
+            this->background_set = true;
+        }
+    }
+
+    if (all || state.androidDevice != last.androidDevice) {
+        ui_->ButtonAndroidAuto->setVisible(state.androidDevice);
+        ui_->pushButtonNoDevice->setVisible(!state.androidDevice);
+        ui_->pushButtonAndroidAuto2->setVisible(state.androidDevice);
+        ui_->pushButtonNoDevice2->setVisible(!state.androidDevice);
+        ui_->labelAndroidAutoBottom->setText("");
+        if (state.androidDevice) {
+            try {
+                QFile deviceData(QString("/tmp/android_device"));
+                deviceData.open(QIODevice::ReadOnly);
+                QTextStream data_date(&deviceData);
+                data_date.readLine();
+                // wait for second line to be written
+                QString linedate;
+                while (linedate.isNull()) {
+                    linedate = data_date.readLine();
+                }
+                deviceData.close();
+                ui_->labelAndroidAutoBottom->setText(linedate.simplified().replace("_"," "));
+            } catch (...) {
+                ui_->labelAndroidAutoBottom->setText("");
+            }
+        }
+    }
+
+    // hide wifi if hotspot disabled and force wifi unselected
+    if (all || state.hotspot != last.hotspot) {
+        ui_->AAWIFIWidget->setVisible(state.hotspot);
+        ui_->AAWIFIWidget2->setVisible(state.hotspot);
+        ui_->AAUSBWidget->setVisible(!state.hotspot);
+        ui_->AAUSBWidget2->setVisible(!state.hotspot);
+    }
+
+    if (all || state.wifiDevice != last.wifiDevice) {
+        ui_->pushButtonWifi->setVisible(state.wifiDevice);
+        ui_->pushButtonNoWiFiDevice->setVisible(!state.wifiDevice);
+        ui_->pushButtonWifi2->setVisible(state.wifiDevice);
+        ui_->pushButtonNoWiFiDevice2->setVisible(!state.wifiDevice);
+        if (state.wifiDevice) {
+            ui_->pushButtonWifi->setFocus();
+            ui_->pushButtonWifi2->setFocus();
+        }
+    }
+
+    if (all || state.updateAvailable != last.updateAvailable) {
+        ui_->pushButtonUpdate->setVisible(state.updateAvailable);
+        if (state.updateAvailable) {
             ui_->label_left->show();
             ui_->label_right->show();
             if (this->devModeEnabled) {
@@ -2152,10 +2176,7 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
             } else {
                 ui_->label_dummy_right->show();
             }
-        }
-    } else {
-        if (ui_->pushButtonUpdate->isVisible() == true) {
-            ui_->pushButtonUpdate->hide();
+        } else if (!all) {
             ui_->label_left->hide();
             ui_->label_right->hide();
             ui_->label_dummy_right->hide();
@@ -2165,16 +2186,36 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
         }
     }
 
-    if (std::ifstream("/tmp/btdevice") || std::ifstream("/tmp/media_playing") || std::ifstream("/tmp/dev_mode_enabled") || std::ifstream("/tmp/android_device")) {
-        if (ui_->labelLock->isVisible() == false) {
-            ui_->labelLock->show();
-            ui_->labelLockDummy->show();
+    if (all || state.locked != last.locked) {
+        ui_->labelLock->setVisible(state.locked);
+        ui_->labelLockDummy->setVisible(state.locked);
+    }
+
+    this->setUpdatesEnabled(true);
+
+    this->screenState_ = state;
+    this->screenStateValid_ = true;
+    ++this->reconcilePasses_;
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::restoreMenu()
+{
+    // bring back the menu of the active style, like toggling the gui twice did before
+    if (this->oldGUIStyle) {
+        ui_->oldmenuWidget->show();
+        ui_->menuWidget->hide();
+        if (!this->NoClock) {
+            ui_->Digital_clock->setVisible(!this->UseBigClock);
+            ui_->bigClock->setVisible(this->UseBigClock);
+            ui_->oldmenuDummy->setVisible(!this->UseBigClock);
         }
+        MainWindow::on_pushButtonVolume_clicked();
     } else {
-        if (ui_->labelLock->isVisible() == true) {
-            ui_->labelLock->hide();
-            ui_->labelLockDummy->hide();
+        ui_->menuWidget->show();
+        ui_->oldmenuWidget->hide();
+        if (!this->NoClock) {
+            ui_->Digital_clock->show();
         }
     }
-    updateNetworkInfo();
+    f1x::openauto::autoapp::ui::MainWindow::updateBG();
 }
@@ -0,0 +1,77 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/autoapp/UI/NowPlaying.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+NowPlaying::NowPlaying(QObject* parent)
+    : QObject(parent)
+    , coverKey_(0)
+{
+
+}
+
+void NowPlaying::setTitle(const QString& title)
+{
+    if(title != title_)
+    {
+        title_ = title;
+        emit titleChanged(title_);
+    }
+}
+
+void NowPlaying::setTrack(const QString& track)
+{
+    if(track != track_)
+    {
+        track_ = track;
+        emit trackChanged(track_);
+    }
+}
+
+void NowPlaying::setTrackCount(const QString& trackCount)
+{
+    if(trackCount != trackCount_)
+    {
+        trackCount_ = trackCount;
+        emit trackCountChanged(trackCount_);
+    }
+}
+
+void NowPlaying::setCover(const QPixmap& cover)
+{
+    // copies of a cached pixmap share its cache key
+    if(cover.cacheKey() != coverKey_)
+    {
+        coverKey_ = cover.cacheKey();
+        emit coverChanged(cover);
+    }
+}
+
+}
+}
+}
+}
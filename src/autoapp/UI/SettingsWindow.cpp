@@ -28,7 +28,6 @@
 #include <QNetworkInterface>
 #include <fstream>
 #include <QStorageInfo>
-#include <QProcess>
 
 namespace f1x
 {
@@ -43,8 +42,18 @@ SettingsWindow::SettingsWindow(configuration::IConfiguration::Pointer configurat
     : QWidget(parent)
     , ui_(new Ui::SettingsWindow)
     , configuration_(std::move(configuration))
+    , systemInfoCollector_(new SystemInfoCollector())
+    , systemInfoPending_(false)
+    , systemValuesAvailable_(false)
+    , currentTab_(1)
 {
     ui_->setupUi(this);
+
+    systemInfoCollector_->moveToThread(&systemInfoThread_);
+    connect(&systemInfoThread_, &QThread::finished, systemInfoCollector_, &QObject::deleteLater);
+    connect(systemInfoCollector_, &SystemInfoCollector::collected, this, &SettingsWindow::onSystemInfoCollected);
+    systemInfoThread_.start(QThread::LowPriority);
+
     connect(ui_->pushButtonCancel, &QPushButton::clicked, this, &SettingsWindow::close);
     connect(ui_->pushButtonSave, &QPushButton::clicked, this, &SettingsWindow::onSave);
     connect(ui_->pushButtonUnpair , &QPushButton::clicked, this, &SettingsWindow::unpairAll);
@@ -86,6 +95,9 @@ SettingsWindow::SettingsWindow(configuration::IConfiguration::Pointer configurat
     connect(ui_->pushButtonSambaStart, &QPushButton::clicked, [&]() { system("/usr/local/bin/crankshaft samba start &");});
     connect(ui_->pushButtonSambaStop, &QPushButton::clicked, [&]() { system("/usr/local/bin/crankshaft samba stop &");});
 
+    // nothing to load until loadSystemValues() is requested when the window opens
+    systemValuesLoaded_.set();
+
     // menu
     ui_->tab1->show();
     ui_->tab2->hide();
@@ -180,6 +192,8 @@ SettingsWindow::SettingsWindow(configuration::IConfiguration::Pointer configurat
 
 SettingsWindow::~SettingsWindow()
 {
+    systemInfoThread_.quit();
+    systemInfoThread_.wait();
     delete ui_;
 }
 
@@ -195,6 +209,11 @@ void SettingsWindow::updateInfo()
 
 void SettingsWindow::onSave()
 {
+    // tabs that were never opened still have to carry the current system values into the param string
+    for (int tab = 1; tab <= cTabCount; ++tab) {
+        this->loadTabValues(tab);
+    }
+
     configuration_->setHandednessOfTrafficType(ui_->radioButtonLeftHandDrive->isChecked() ? configuration::HandednessOfTrafficType::LEFT_HAND_DRIVE : configuration::HandednessOfTrafficType::RIGHT_HAND_DRIVE);
 
     configuration_->showClock(ui_->checkBoxShowClock->isChecked());
@@ -257,6 +276,7 @@ void SettingsWindow::onSave()
     configuration_->setAudioOutputBackendType(ui_->radioButtonRtAudio->isChecked() ? configuration::AudioOutputBackendType::RTAUDIO : configuration::AudioOutputBackendType::QT);
 
     configuration_->save();
+    configuration_->flush();
 
     // generate param string for autoapp_helper
     std::string params;
@@ -533,17 +553,6 @@ void SettingsWindow::load()
     ui_->radioButtonQtAudio->setChecked(audioOutputBackendType == configuration::AudioOutputBackendType::QT);
 
     ui_->checkBoxHardwareSave->setChecked(false);
-    QStorageInfo storage("/media/USBDRIVES/CSSTORAGE");
-    storage.refresh();
-    if (storage.isValid() && storage.isReady()) {
-        if (storage.isReadOnly()) {
-            ui_->labelStorage->setText("Storage is read only!  (" + storage.device() + ") - This can be caused by demaged filesystem on CSSTORAGE. Try a reboot.");
-        } else {
-            ui_->labelStorage->setText("Device: " + storage.device() + " Label: " + storage.displayName() + " Total: " + QString::number(storage.bytesTotal()/1024/1024/1024) + "GB Free: " + QString::number(storage.bytesFree()/1024/1024/1024) + "GB (" + storage.fileSystemType() + ")");
-        }
-    } else {
-        ui_->labelStorage->setText("Storage is not ready or missing!");
-    }
 }
 
 void SettingsWindow::loadButtonCheckBoxes()
@@ -723,6 +732,79 @@ void SettingsWindow::syncNTPTime()
 }
 
 void SettingsWindow::loadSystemValues()
+{
+    // tabs pick up their system values when shown, the rest are filled in while the window is idle
+    systemValuesLoaded_.reset();
+    systemValuesAvailable_ = std::ifstream("/tmp/return_value").good();
+    systemParams_.clear();
+
+    if (systemValuesAvailable_) {
+        systemParams_ = configuration_->readFileContent("/tmp/return_value").split("#");
+
+        // set lightsensor
+        if (std::ifstream("/etc/cs_lightsensor")) {
+            ui_->comboBoxLS->setCurrentIndex(1);
+            ui_->groupBoxSliderDay->hide();
+            ui_->groupBoxSliderNight->hide();
+        } else {
+            ui_->comboBoxLS->setCurrentIndex(0);
+            ui_->pushButtonTab9->hide();
+            ui_->groupBoxSliderDay->show();
+            ui_->groupBoxSliderNight->show();
+        }
+    }
+
+    this->loadTabValues(currentTab_);
+    QTimer::singleShot(0, this, &SettingsWindow::loadPendingSystemValues);
+}
+
+void SettingsWindow::loadPendingSystemValues()
+{
+    // one tab per event loop pass so the window stays responsive while opening
+    for (int tab = 1; tab <= cTabCount; ++tab) {
+        if (!systemValuesLoaded_.test(tab - 1)) {
+            this->loadTabValues(tab);
+            QTimer::singleShot(0, this, &SettingsWindow::loadPendingSystemValues);
+            return;
+        }
+    }
+}
+
+void SettingsWindow::loadTabValues(int tab)
+{
+    if (systemValuesLoaded_.test(tab - 1)) {
+        return;
+    }
+    systemValuesLoaded_.set(tab - 1);
+
+    switch (tab) {
+    case 1:
+        this->loadDisplayValues();
+        break;
+    case 3:
+        this->loadAudioValues();
+        break;
+    case 5:
+        this->loadNetworkValues();
+        break;
+    case 6:
+        this->loadSystemInfoValues();
+        break;
+    case 7:
+        this->loadGPIOValues();
+        break;
+    case 8:
+        this->loadHardwareValues();
+        break;
+    case 9:
+        this->loadLightSensorValues();
+        break;
+    default:
+        break;
+    }
+}
+
+void SettingsWindow::loadDisplayValues()
 {
     // set brightness slider attribs
     ui_->horizontalSliderDay->setMinimum(configuration_->getCSValue("BR_MIN").toInt());
@@ -736,240 +818,66 @@ void SettingsWindow::loadSystemValues()
     ui_->horizontalSliderNight->setSingleStep(configuration_->getCSValue("BR_STEP").toInt());
     ui_->horizontalSliderNight->setTickInterval(configuration_->getCSValue("BR_STEP").toInt());
     ui_->horizontalSliderNight->setValue(configuration_->getCSValue("BR_NIGHT").toInt());
+}
 
-    ui_->horizontalSliderBrightness1->setMinimum(configuration_->getCSValue("BR_MIN").toInt());
-    ui_->horizontalSliderBrightness1->setMaximum(configuration_->getCSValue("BR_MAX").toInt());
-    ui_->horizontalSliderBrightness1->setSingleStep(configuration_->getCSValue("BR_STEP").toInt());
-    ui_->horizontalSliderBrightness1->setTickInterval(configuration_->getCSValue("BR_STEP").toInt());
-
-    ui_->horizontalSliderBrightness2->setMinimum(configuration_->getCSValue("BR_MIN").toInt());
-    ui_->horizontalSliderBrightness2->setMaximum(configuration_->getCSValue("BR_MAX").toInt());
-    ui_->horizontalSliderBrightness2->setSingleStep(configuration_->getCSValue("BR_STEP").toInt());
-    ui_->horizontalSliderBrightness2->setTickInterval(configuration_->getCSValue("BR_STEP").toInt());
-
-    ui_->horizontalSliderBrightness3->setMinimum(configuration_->getCSValue("BR_MIN").toInt());
-    ui_->horizontalSliderBrightness3->setMaximum(configuration_->getCSValue("BR_MAX").toInt());
-    ui_->horizontalSliderBrightness3->setSingleStep(configuration_->getCSValue("BR_STEP").toInt());
-    ui_->horizontalSliderBrightness3->setTickInterval(configuration_->getCSValue("BR_STEP").toInt());
-
-    ui_->horizontalSliderBrightness4->setMinimum(configuration_->getCSValue("BR_MIN").toInt());
-    ui_->horizontalSliderBrightness4->setMaximum(configuration_->getCSValue("BR_MAX").toInt());
-    ui_->horizontalSliderBrightness4->setSingleStep(configuration_->getCSValue("BR_STEP").toInt());
-    ui_->horizontalSliderBrightness4->setTickInterval(configuration_->getCSValue("BR_STEP").toInt());
-
-    ui_->horizontalSliderBrightness5->setMinimum(configuration_->getCSValue("BR_MIN").toInt());
-    ui_->horizontalSliderBrightness5->setMaximum(configuration_->getCSValue("BR_MAX").toInt());
-    ui_->horizontalSliderBrightness5->setSingleStep(configuration_->getCSValue("BR_STEP").toInt());
-    ui_->horizontalSliderBrightness5->setTickInterval(configuration_->getCSValue("BR_STEP").toInt());
-
-    // set tsl2561 slider attribs
-    ui_->horizontalSliderLux1->setValue(configuration_->getCSValue("LUX_LEVEL_1").toInt());
-    ui_->horizontalSliderBrightness1->setValue(configuration_->getCSValue("DISP_BRIGHTNESS_1").toInt());
-    ui_->horizontalSliderLux2->setValue(configuration_->getCSValue("LUX_LEVEL_2").toInt());
-    ui_->horizontalSliderBrightness2->setValue(configuration_->getCSValue("DISP_BRIGHTNESS_2").toInt());
-    ui_->horizontalSliderLux3->setValue(configuration_->getCSValue("LUX_LEVEL_3").toInt());
-    ui_->horizontalSliderBrightness3->setValue(configuration_->getCSValue("DISP_BRIGHTNESS_3").toInt());
-    ui_->horizontalSliderLux4->setValue(configuration_->getCSValue("LUX_LEVEL_4").toInt());
-    ui_->horizontalSliderBrightness4->setValue(configuration_->getCSValue("DISP_BRIGHTNESS_4").toInt());
-    ui_->horizontalSliderLux5->setValue(configuration_->getCSValue("LUX_LEVEL_5").toInt());
-    ui_->horizontalSliderBrightness5->setValue(configuration_->getCSValue("DISP_BRIGHTNESS_5").toInt());
-    ui_->comboBoxCheckInterval->setCurrentText(configuration_->getCSValue("TSL2561_CHECK_INTERVAL"));
-    ui_->comboBoxNightmodeStep->setCurrentText(configuration_->getCSValue("TSL2561_DAYNIGHT_ON_STEP"));
-
-    if (std::ifstream("/tmp/return_value")) {
-        QString return_values = configuration_->readFileContent("/tmp/return_value");
-        QStringList getparams = return_values.split("#");
-
-        // version string
-        ui_->valueSystemVersion->setText(configuration_->readFileContent("/etc/crankshaft.build"));
-        // date string
-        ui_->valueSystemBuildDate->setText(configuration_->readFileContent("/etc/crankshaft.date"));
-        // set volume
-        ui_->labelSystemVolumeValue->setText(configuration_->readFileContent("/boot/crankshaft/volume"));
-        ui_->horizontalSliderSystemVolume->setValue(configuration_->readFileContent("/boot/crankshaft/volume").toInt());
-        // set cap volume
-        ui_->labelSystemCaptureValue->setText(configuration_->readFileContent("/boot/crankshaft/capvolume"));
-        ui_->horizontalSliderSystemCapture->setValue(configuration_->readFileContent("/boot/crankshaft/capvolume").toInt());
-        // set shutdown
-        ui_->valueShutdownTimer->setText("- - -");
-        ui_->spinBoxShutdown->setValue(configuration_->getCSValue("DISCONNECTION_POWEROFF_MINS").toInt());
-        // set disconnect
-        ui_->valueDisconnectTimer->setText("- - -");
-        ui_->spinBoxDisconnect->setValue(configuration_->getCSValue("DISCONNECTION_SCREEN_POWEROFF_SECS").toInt());
-        // set day/night
-        ui_->spinBoxDay->setValue(configuration_->getCSValue("RTC_DAY_START").toInt());
-        ui_->spinBoxNight->setValue(configuration_->getCSValue("RTC_NIGHT_START").toInt());
-        // set gpios
-        if (configuration_->getCSValue("ENABLE_GPIO") == "1") {
-           ui_->checkBoxGPIO->setChecked(true);
-        } else {
-            ui_->checkBoxGPIO->setChecked(false);
-        }
-        ui_->comboBoxDevMode->setCurrentText(configuration_->getCSValue("DEV_PIN"));
-        ui_->comboBoxInvert->setCurrentText(configuration_->getCSValue("INVERT_PIN"));
-        ui_->comboBoxX11->setCurrentText(configuration_->getCSValue("X11_PIN"));
-        ui_->comboBoxRearcam->setCurrentText(configuration_->getCSValue("REARCAM_PIN"));
-        ui_->comboBoxAndroid->setCurrentText(configuration_->getCSValue("ANDROID_PIN"));
-        // set mode
-        if (configuration_->getCSValue("START_X11") == "0") {
-            ui_->radioButtonEGL->setChecked(true);
-        } else {
-            ui_->radioButtonX11->setChecked(true);
-        }
-        // set rotation
-        if (configuration_->getCSValue("FLIP_SCREEN") == "0") {
-            ui_->radioButtonScreenNormal->setChecked(true);
-        } else {
-            ui_->radioButtonScreenRotated->setChecked(true);
-        }
-
-        if (std::ifstream("/tmp/get_inputs")) {
-            QFile inputsFile(QString("/tmp/get_inputs"));
-            inputsFile.open(QIODevice::ReadOnly);
-            QTextStream data_return(&inputsFile);
-            QStringList inputs = data_return.readAll().split("\n");
-            inputsFile.close();
-            int cleaner = ui_->comboBoxPulseInput->count();
-            while (cleaner > -1) {
-                ui_->comboBoxPulseInput->removeItem(cleaner);
-                cleaner--;
-            }
-            int indexin = inputs.count();
-            int countin = 0;
-            while (countin < indexin-1) {
-                ui_->comboBoxPulseInput->addItem(inputs[countin]);
-                countin++;
-            }
-        }
-
-        if (std::ifstream("/tmp/get_outputs")) {
-            QFile outputsFile(QString("/tmp/get_outputs"));
-            outputsFile.open(QIODevice::ReadOnly);
-            QTextStream data_return(&outputsFile);
-            QStringList outputs = data_return.readAll().split("\n");
-            outputsFile.close();
-            int cleaner = ui_->comboBoxPulseOutput->count();
-            while (cleaner > -1) {
-                ui_->comboBoxPulseOutput->removeItem(cleaner);
-                cleaner--;
-            }
-            int indexout = outputs.count();
-            int countout = 0;
-            while (countout < indexout-1) {
-                ui_->comboBoxPulseOutput->addItem(outputs[countout]);
-                countout++;
-            }
-        }
-
-        ui_->comboBoxPulseOutput->setCurrentText(configuration_->readFileContent("/tmp/get_default_output"));
-        ui_->comboBoxPulseInput->setCurrentText(configuration_->readFileContent("/tmp/get_default_input"));
-
-        if (std::ifstream("/tmp/timezone_listing")) {
-            QFile zoneFile(QString("/tmp/timezone_listing"));
-            zoneFile.open(QIODevice::ReadOnly);
-            QTextStream data_return(&zoneFile);
-            QStringList zones = data_return.readAll().split("\n");
-            zoneFile.close();
-            int cleaner = ui_->comboBoxTZ->count();
-            while (cleaner > 0) {
-                ui_->comboBoxTZ->removeItem(cleaner);
-                cleaner--;
-            }
-            int indexout = zones.count();
-            int countzone = 0;
-            while (countzone < indexout-1) {
-                ui_->comboBoxTZ->addItem(zones[countzone]);
-                countzone++;
-            }
-        }
-
-        // set rtc
-        QString rtcstring = configuration_->getParamFromFile("/boot/config.txt","dtoverlay=i2c-rtc");
-        if (rtcstring != "") {
-            QStringList rtc = rtcstring.split(",");
-            ui_->comboBoxHardwareRTC->setCurrentText(rtc[1].trimmed());
-            // set timezone
-            ui_->comboBoxTZ->setCurrentText(configuration_->readFileContent("/etc/timezone"));
-        } else {
-            ui_->comboBoxHardwareRTC->setCurrentText("none");
-            ui_->comboBoxTZ->setCurrentText(configuration_->readFileContent("/etc/timezone"));
-        }
+void SettingsWindow::loadAudioValues()
+{
+    if (!systemValuesAvailable_) {
+        return;
+    }
 
-        // set dac
-        QString dac = "Custom";
-        if (getparams[4] == "allo-boss-dac-pcm512x-audio") {
-            dac = "Allo - Boss";
-        }
-        if (getparams[4] == "allo-piano-dac-pcm512x-audio") {
-            dac = "Allo - Piano";
-        }
-        if (getparams[4] == "iqaudio-dacplus") {
-            dac = "IQaudIO - Pi-DAC Plus/Pro/Zero";
-        }
-        if (getparams[4] == "iqaudio-dacplus,unmute_amp") {
-            dac = "IQaudIO - Pi-Digi Amp Plus";
+    // set volume
+    ui_->labelSystemVolumeValue->setText(configuration_->readFileContent("/boot/crankshaft/volume"));
+    ui_->horizontalSliderSystemVolume->setValue(configuration_->readFileContent("/boot/crankshaft/volume").toInt());
+    // set cap volume
+    ui_->labelSystemCaptureValue->setText(configuration_->readFileContent("/boot/crankshaft/capvolume"));
+    ui_->horizontalSliderSystemCapture->setValue(configuration_->readFileContent("/boot/crankshaft/capvolume").toInt());
+
+    if (std::ifstream("/tmp/get_inputs")) {
+        QFile inputsFile(QString("/tmp/get_inputs"));
+        inputsFile.open(QIODevice::ReadOnly);
+        QTextStream data_return(&inputsFile);
+        QStringList inputs = data_return.readAll().split("\n");
+        inputsFile.close();
+        int cleaner = ui_->comboBoxPulseInput->count();
+        while (cleaner > -1) {
+            ui_->comboBoxPulseInput->removeItem(cleaner);
+            cleaner--;
         }
-        if (getparams[4] == "iqaudio-dacplus,auto_mute_amp") {
-            dac = "IQaudIO - Pi-Digi Amp Plus - Automute";
-        }
-        if (getparams[4] == "iqaudio-digi-wm8804-audio") {
-            dac = "IQaudIO - Pi-Digi Plus";
-        }
-        if (getparams[4] == "audioinjector-wm8731-audio") {
-            dac = "Audioinjector - Zero/Stereo";
-        }
-        if (getparams[4] == "hifiberry-dac") {
-            dac = "Hifiberry - DAC";
-        }
-        if (getparams[4] == "hifiberry-dacplus") {
-            dac = "Hifiberry - DAC Plus";
-        }
-        if (getparams[4] == "hifiberry-digi") {
-            dac = "Hifiberry - Digi";
-        }
-        if (getparams[4] == "hifiberry-digi-pro") {
-            dac = "Hifiberry - Digi Pro";
-        }
-        if (getparams[4] == "hifiberry-amp") {
-            dac = "Hifiberry - DAC Amp";
-        }
-        if (getparams[4] == "audio") {
-            dac = "Raspberry Pi - Onboard";
-        }
-        ui_->comboBoxHardwareDAC->setCurrentText(dac);
-
-        // set shutdown disable
-        if (configuration_->getCSValue("DISCONNECTION_POWEROFF_DISABLE") == "1") {
-            ui_->checkBoxDisableShutdown->setChecked(true);
-        } else {
-            ui_->checkBoxDisableShutdown->setChecked(false);
-        }
-
-        // set screen off disable
-        if (configuration_->getCSValue("DISCONNECTION_SCREEN_POWEROFF_DISABLE") == "1") {
-            ui_->checkBoxDisableScreenOff->setChecked(true);
-        } else {
-            ui_->checkBoxDisableScreenOff->setChecked(false);
+        int indexin = inputs.count();
+        int countin = 0;
+        while (countin < indexin-1) {
+            ui_->comboBoxPulseInput->addItem(inputs[countin]);
+            countin++;
         }
+    }
 
-        // set custom brightness command
-        if (configuration_->getCSValue("CUSTOM_BRIGHTNESS_COMMAND") != "") {
-            ui_->labelCustomBrightnessCommand->setText(configuration_->getCSValue("CUSTOM_BRIGHTNESS_COMMAND") + " brvalue");
-        } else {
-            ui_->labelCustomBrightnessCommand->setText("Disabled");
+    if (std::ifstream("/tmp/get_outputs")) {
+        QFile outputsFile(QString("/tmp/get_outputs"));
+        outputsFile.open(QIODevice::ReadOnly);
+        QTextStream data_return(&outputsFile);
+        QStringList outputs = data_return.readAll().split("\n");
+        outputsFile.close();
+        int cleaner = ui_->comboBoxPulseOutput->count();
+        while (cleaner > -1) {
+            ui_->comboBoxPulseOutput->removeItem(cleaner);
+            cleaner--;
         }
-
-        // set debug mode
-        if (configuration_->getCSValue("DEBUG_MODE") == "1") {
-            ui_->radioButtonDebugmodeEnabled->setChecked(true);
-        } else {
-            ui_->radioButtonDebugmodeDisabled->setChecked(true);
+        int indexout = outputs.count();
+        int countout = 0;
+        while (countout < indexout-1) {
+            ui_->comboBoxPulseOutput->addItem(outputs[countout]);
+            countout++;
         }
+    }
 
-        // GPIO based shutdown
-        ui_->comboBoxGPIOShutdown->setCurrentText(configuration_->getCSValue("IGNITION_PIN"));
-        ui_->spinBoxGPIOShutdownDelay->setValue(configuration_->getCSValue("IGNITION_DELAY").toInt());
+    ui_->comboBoxPulseOutput->setCurrentText(configuration_->readFileContent("/tmp/get_default_output"));
+    ui_->comboBoxPulseInput->setCurrentText(configuration_->readFileContent("/tmp/get_default_input"));
+}
 
+void SettingsWindow::loadNetworkValues()
+{
+    if (systemValuesAvailable_) {
         // Wifi Hotspot
         if (configuration_->getCSValue("ENABLE_HOTSPOT") == "1") {
             ui_->checkBoxHotspot->setChecked(true);
@@ -977,57 +885,6 @@ void SettingsWindow::loadSystemValues()
             ui_->checkBoxHotspot->setChecked(false);
         }
 
-        // set cam
-        if (configuration_->getParamFromFile("/boot/config.txt","start_x") == "1") {
-            ui_->comboBoxCam->setCurrentText("enabled");
-        } else {
-            ui_->comboBoxCam->setCurrentText("disabled");
-        }
-        if (configuration_->getCSValue("RPICAM_HFLIP") == "1") {
-            ui_->checkBoxFlipX->setChecked(true);
-        } else {
-            ui_->checkBoxFlipX->setChecked(false);
-        }
-        if (configuration_->getCSValue("RPICAM_VFLIP") == "1") {
-            ui_->checkBoxFlipY->setChecked(true);
-        } else {
-            ui_->checkBoxFlipY->setChecked(false);
-        }
-        ui_->comboBoxRotation->setCurrentText(configuration_->getCSValue("RPICAM_ROTATION"));
-        ui_->comboBoxResolution->setCurrentText(configuration_->getCSValue("RPICAM_RESOLUTION"));
-        ui_->comboBoxFPS->setCurrentText(configuration_->getCSValue("RPICAM_FPS"));
-        ui_->comboBoxAWB->setCurrentText(configuration_->getCSValue("RPICAM_AWB"));
-        ui_->comboBoxEXP->setCurrentText(configuration_->getCSValue("RPICAM_EXP"));
-        ui_->comboBoxLoopTime->setCurrentText(configuration_->getCSValue("RPICAM_LOOPTIME"));
-        ui_->comboBoxLoopCount->setCurrentText(configuration_->getCSValue("RPICAM_LOOPCOUNT"));
-
-        if (configuration_->getCSValue("RPICAM_AUTORECORDING") == "1") {
-            ui_->checkBoxAutoRecording->setChecked(true);
-        } else {
-            ui_->checkBoxAutoRecording->setChecked(false);
-        }
-
-        if (configuration_->getCSValue("USBCAM_USE") == "1") {
-            ui_->comboBoxUSBCam->setCurrentText("enabled");
-        } else {
-            ui_->comboBoxUSBCam->setCurrentText("none");
-        }
-        if (configuration_->getCSValue("USBCAM_ROTATION") == "1") {
-            ui_->comboBoxUSBRotation->setCurrentText("180");
-        } else {
-            ui_->comboBoxUSBRotation->setCurrentText("0");
-        }
-        if (configuration_->getCSValue("USBCAM_HFLIP") == "1") {
-            ui_->checkBoxFlipXUSB->setChecked(true);
-        } else {
-            ui_->checkBoxFlipXUSB->setChecked(false);
-        }
-        if (configuration_->getCSValue("USBCAM_VFLIP") == "1") {
-            ui_->checkBoxFlipYUSB->setChecked(true);
-        } else {
-            ui_->checkBoxFlipYUSB->setChecked(false);
-        }
-
         // set bluetooth
         if (configuration_->getCSValue("ENABLE_BLUETOOTH") == "1") {
             // check external bluetooth enabled
@@ -1037,7 +894,7 @@ void SettingsWindow::loadSystemValues()
                 ui_->radioButtonUseLocalBluetoothAdapter->setChecked(true);
             }
             // mac
-            //ui_->lineEditExternalBluetoothAdapterAddress->setText(getparams[37]);
+            //ui_->lineEditExternalBluetoothAdapterAddress->setText(systemParams_[37]);
         } else {
             ui_->radioButtonDisableBluetooth->setChecked(true);
             ui_->lineEditExternalBluetoothAdapterAddress->setText("");
@@ -1047,56 +904,317 @@ void SettingsWindow::loadSystemValues()
         } else {
             ui_->checkBoxBluetoothAutoPair->setChecked(false);
         }
-        // set bluetooth type
-        if (configuration_->getCSValue("ENABLE_BLUETOOTH") == "1") {
-            QString bt = configuration_->getParamFromFile("/boot/config.txt","dtoverlay=pi3-disable-bt");
-            if (bt.contains("pi3-disable-bt")) {
-                ui_->comboBoxBluetooth->setCurrentText("external");
-            } else {
-                ui_->comboBoxBluetooth->setCurrentText("builtin");
-            }
-        } else {
-            ui_->comboBoxBluetooth->setCurrentText("none");
-        }
+        // wifi country code
+        ui_->comboBoxCountryCode->setCurrentIndex(ui_->comboBoxCountryCode->findText(configuration_->getCSValue("WIFI_COUNTRY"), Qt::MatchFlag::MatchStartsWith));
+    }
+    // update network info
+    updateNetworkInfo();
+}
 
-        // set lightsensor
-        if (std::ifstream("/etc/cs_lightsensor")) {
-            ui_->comboBoxLS->setCurrentIndex(1);
-            ui_->groupBoxSliderDay->hide();
-            ui_->groupBoxSliderNight->hide();
-        } else {
-            ui_->comboBoxLS->setCurrentIndex(0);
-            ui_->pushButtonTab9->hide();
-            ui_->groupBoxSliderDay->show();
-            ui_->groupBoxSliderNight->show();
-        }
-        ui_->comboBoxDayNight->setCurrentText(configuration_->getCSValue("DAYNIGHT_PIN"));
-        if (configuration_->getCSValue("RTC_DAYNIGHT") == "1") {
-            ui_->checkBoxDisableDayNightRTC->setChecked(false);
+void SettingsWindow::loadSystemInfoValues()
+{
+    QStorageInfo storage("/media/USBDRIVES/CSSTORAGE");
+    storage.refresh();
+    if (storage.isValid() && storage.isReady()) {
+        if (storage.isReadOnly()) {
+            ui_->labelStorage->setText("Storage is read only!  (" + storage.device() + ") - This can be caused by demaged filesystem on CSSTORAGE. Try a reboot.");
         } else {
-            ui_->checkBoxDisableDayNightRTC->setChecked(true);
-        }
-        QString theme = configuration_->getParamFromFile("/etc/plymouth/plymouthd.conf","Theme");
-        if (theme == "csnganimation") {
-            ui_->radioButtonAnimatedCSNG->setChecked(true);
+            ui_->labelStorage->setText("Device: " + storage.device() + " Label: " + storage.displayName() + " Total: " + QString::number(storage.bytesTotal()/1024/1024/1024) + "GB Free: " + QString::number(storage.bytesFree()/1024/1024/1024) + "GB (" + storage.fileSystemType() + ")");
         }
-        else if (theme == "crankshaft") {
-            ui_->radioButtonCSNG->setChecked(true);
+    } else {
+        ui_->labelStorage->setText("Storage is not ready or missing!");
+    }
+
+    if (!systemValuesAvailable_) {
+        return;
+    }
+
+    // version string
+    ui_->valueSystemVersion->setText(configuration_->readFileContent("/etc/crankshaft.build"));
+    // date string
+    ui_->valueSystemBuildDate->setText(configuration_->readFileContent("/etc/crankshaft.date"));
+    // set shutdown
+    ui_->valueShutdownTimer->setText("- - -");
+    ui_->spinBoxShutdown->setValue(configuration_->getCSValue("DISCONNECTION_POWEROFF_MINS").toInt());
+    // set disconnect
+    ui_->valueDisconnectTimer->setText("- - -");
+    ui_->spinBoxDisconnect->setValue(configuration_->getCSValue("DISCONNECTION_SCREEN_POWEROFF_SECS").toInt());
+    // set mode
+    if (configuration_->getCSValue("START_X11") == "0") {
+        ui_->radioButtonEGL->setChecked(true);
+    } else {
+        ui_->radioButtonX11->setChecked(true);
+    }
+    // set rotation
+    if (configuration_->getCSValue("FLIP_SCREEN") == "0") {
+        ui_->radioButtonScreenNormal->setChecked(true);
+    } else {
+        ui_->radioButtonScreenRotated->setChecked(true);
+    }
+
+    // set shutdown disable
+    if (configuration_->getCSValue("DISCONNECTION_POWEROFF_DISABLE") == "1") {
+        ui_->checkBoxDisableShutdown->setChecked(true);
+    } else {
+        ui_->checkBoxDisableShutdown->setChecked(false);
+    }
+
+    // set screen off disable
+    if (configuration_->getCSValue("DISCONNECTION_SCREEN_POWEROFF_DISABLE") == "1") {
+        ui_->checkBoxDisableScreenOff->setChecked(true);
+    } else {
+        ui_->checkBoxDisableScreenOff->setChecked(false);
+    }
+
+    QString theme = configuration_->getParamFromFile("/etc/plymouth/plymouthd.conf","Theme");
+    if (theme == "csnganimation") {
+        ui_->radioButtonAnimatedCSNG->setChecked(true);
+    }
+    else if (theme == "crankshaft") {
+        ui_->radioButtonCSNG->setChecked(true);
+    }
+    else if (theme == "custom") {
+        ui_->radioButtonCustom->setChecked(true);
+    }
+    // set screen blank instead off
+    if (configuration_->getCSValue("SCREEN_POWEROFF_OVERRIDE") == "1") {
+        ui_->checkBoxBlankOnly->setChecked(true);
+    } else {
+        ui_->checkBoxBlankOnly->setChecked(false);
+    }
+}
+
+void SettingsWindow::loadGPIOValues()
+{
+    if (!systemValuesAvailable_) {
+        return;
+    }
+
+    // set day/night
+    ui_->spinBoxDay->setValue(configuration_->getCSValue("RTC_DAY_START").toInt());
+    ui_->spinBoxNight->setValue(configuration_->getCSValue("RTC_NIGHT_START").toInt());
+    // set gpios
+    if (configuration_->getCSValue("ENABLE_GPIO") == "1") {
+       ui_->checkBoxGPIO->setChecked(true);
+    } else {
+        ui_->checkBoxGPIO->setChecked(false);
+    }
+    ui_->comboBoxDevMode->setCurrentText(configuration_->getCSValue("DEV_PIN"));
+    ui_->comboBoxInvert->setCurrentText(configuration_->getCSValue("INVERT_PIN"));
+    ui_->comboBoxX11->setCurrentText(configuration_->getCSValue("X11_PIN"));
+    ui_->comboBoxRearcam->setCurrentText(configuration_->getCSValue("REARCAM_PIN"));
+    ui_->comboBoxAndroid->setCurrentText(configuration_->getCSValue("ANDROID_PIN"));
+    // set custom brightness command
+    if (configuration_->getCSValue("CUSTOM_BRIGHTNESS_COMMAND") != "") {
+        ui_->labelCustomBrightnessCommand->setText(configuration_->getCSValue("CUSTOM_BRIGHTNESS_COMMAND") + " brvalue");
+    } else {
+        ui_->labelCustomBrightnessCommand->setText("Disabled");
+    }
+
+    // set debug mode
+    if (configuration_->getCSValue("DEBUG_MODE") == "1") {
+        ui_->radioButtonDebugmodeEnabled->setChecked(true);
+    } else {
+        ui_->radioButtonDebugmodeDisabled->setChecked(true);
+    }
+
+    // GPIO based shutdown
+    ui_->comboBoxGPIOShutdown->setCurrentText(configuration_->getCSValue("IGNITION_PIN"));
+    ui_->spinBoxGPIOShutdownDelay->setValue(configuration_->getCSValue("IGNITION_DELAY").toInt());
+
+    ui_->comboBoxDayNight->setCurrentText(configuration_->getCSValue("DAYNIGHT_PIN"));
+    if (configuration_->getCSValue("RTC_DAYNIGHT") == "1") {
+        ui_->checkBoxDisableDayNightRTC->setChecked(false);
+    } else {
+        ui_->checkBoxDisableDayNightRTC->setChecked(true);
+    }
+}
+
+void SettingsWindow::loadHardwareValues()
+{
+    if (!systemValuesAvailable_) {
+        return;
+    }
+
+    if (std::ifstream("/tmp/timezone_listing")) {
+        QFile zoneFile(QString("/tmp/timezone_listing"));
+        zoneFile.open(QIODevice::ReadOnly);
+        QTextStream data_return(&zoneFile);
+        QStringList zones = data_return.readAll().split("\n");
+        zoneFile.close();
+        int cleaner = ui_->comboBoxTZ->count();
+        while (cleaner > 0) {
+            ui_->comboBoxTZ->removeItem(cleaner);
+            cleaner--;
         }
-        else if (theme == "custom") {
-            ui_->radioButtonCustom->setChecked(true);
+        int indexout = zones.count();
+        int countzone = 0;
+        while (countzone < indexout-1) {
+            ui_->comboBoxTZ->addItem(zones[countzone]);
+            countzone++;
         }
-        // wifi country code
-        ui_->comboBoxCountryCode->setCurrentIndex(ui_->comboBoxCountryCode->findText(configuration_->getCSValue("WIFI_COUNTRY"), Qt::MatchFlag::MatchStartsWith));
-        // set screen blank instead off
-        if (configuration_->getCSValue("SCREEN_POWEROFF_OVERRIDE") == "1") {
-            ui_->checkBoxBlankOnly->setChecked(true);
+    }
+
+    // set rtc
+    QString rtcstring = configuration_->getParamFromFile("/boot/config.txt","dtoverlay=i2c-rtc");
+    if (rtcstring != "") {
+        QStringList rtc = rtcstring.split(",");
+        ui_->comboBoxHardwareRTC->setCurrentText(rtc[1].trimmed());
+        // set timezone
+        ui_->comboBoxTZ->setCurrentText(configuration_->readFileContent("/etc/timezone"));
+    } else {
+        ui_->comboBoxHardwareRTC->setCurrentText("none");
+        ui_->comboBoxTZ->setCurrentText(configuration_->readFileContent("/etc/timezone"));
+    }
+
+    // set dac, the overlay is the fifth value of the system query and may be missing from a short answer
+    const QString dacOverlay = systemParams_.size() > 4 ? systemParams_[4] : QString();
+    QString dac = "Custom";
+    if (dacOverlay == "allo-boss-dac-pcm512x-audio") {
+        dac = "Allo - Boss";
+    }
+    if (dacOverlay == "allo-piano-dac-pcm512x-audio") {
+        dac = "Allo - Piano";
+    }
+    if (dacOverlay == "iqaudio-dacplus") {
+        dac = "IQaudIO - Pi-DAC Plus/Pro/Zero";
+    }
+    if (dacOverlay == "iqaudio-dacplus,unmute_amp") {
+        dac = "IQaudIO - Pi-Digi Amp Plus";
+    }
+    if (dacOverlay == "iqaudio-dacplus,auto_mute_amp") {
+        dac = "IQaudIO - Pi-Digi Amp Plus - Automute";
+    }
+    if (dacOverlay == "iqaudio-digi-wm8804-audio") {
+        dac = "IQaudIO - Pi-Digi Plus";
+    }
+    if (dacOverlay == "audioinjector-wm8731-audio") {
+        dac = "Audioinjector - Zero/Stereo";
+    }
+    if (dacOverlay == "hifiberry-dac") {
+        dac = "Hifiberry - DAC";
+    }
+    if (dacOverlay == "hifiberry-dacplus") {
+        dac = "Hifiberry - DAC Plus";
+    }
+    if (dacOverlay == "hifiberry-digi") {
+        dac = "Hifiberry - Digi";
+    }
+    if (dacOverlay == "hifiberry-digi-pro") {
+        dac = "Hifiberry - Digi Pro";
+    }
+    if (dacOverlay == "hifiberry-amp") {
+        dac = "Hifiberry - DAC Amp";
+    }
+    if (dacOverlay == "audio") {
+        dac = "Raspberry Pi - Onboard";
+    }
+    ui_->comboBoxHardwareDAC->setCurrentText(dac);
+
+    // set cam
+    if (configuration_->getParamFromFile("/boot/config.txt","start_x") == "1") {
+        ui_->comboBoxCam->setCurrentText("enabled");
+    } else {
+        ui_->comboBoxCam->setCurrentText("disabled");
+    }
+    if (configuration_->getCSValue("RPICAM_HFLIP") == "1") {
+        ui_->checkBoxFlipX->setChecked(true);
+    } else {
+        ui_->checkBoxFlipX->setChecked(false);
+    }
+    if (configuration_->getCSValue("RPICAM_VFLIP") == "1") {
+        ui_->checkBoxFlipY->setChecked(true);
+    } else {
+        ui_->checkBoxFlipY->setChecked(false);
+    }
+    ui_->comboBoxRotation->setCurrentText(configuration_->getCSValue("RPICAM_ROTATION"));
+    ui_->comboBoxResolution->setCurrentText(configuration_->getCSValue("RPICAM_RESOLUTION"));
+    ui_->comboBoxFPS->setCurrentText(configuration_->getCSValue("RPICAM_FPS"));
+    ui_->comboBoxAWB->setCurrentText(configuration_->getCSValue("RPICAM_AWB"));
+    ui_->comboBoxEXP->setCurrentText(configuration_->getCSValue("RPICAM_EXP"));
+    ui_->comboBoxLoopTime->setCurrentText(configuration_->getCSValue("RPICAM_LOOPTIME"));
+    ui_->comboBoxLoopCount->setCurrentText(configuration_->getCSValue("RPICAM_LOOPCOUNT"));
+
+    if (configuration_->getCSValue("RPICAM_AUTORECORDING") == "1") {
+        ui_->checkBoxAutoRecording->setChecked(true);
+    } else {
+        ui_->checkBoxAutoRecording->setChecked(false);
+    }
+
+    if (configuration_->getCSValue("USBCAM_USE") == "1") {
+        ui_->comboBoxUSBCam->setCurrentText("enabled");
+    } else {
+        ui_->comboBoxUSBCam->setCurrentText("none");
+    }
+    if (configuration_->getCSValue("USBCAM_ROTATION") == "1") {
+        ui_->comboBoxUSBRotation->setCurrentText("180");
+    } else {
+        ui_->comboBoxUSBRotation->setCurrentText("0");
+    }
+    if (configuration_->getCSValue("USBCAM_HFLIP") == "1") {
+        ui_->checkBoxFlipXUSB->setChecked(true);
+    } else {
+        ui_->checkBoxFlipXUSB->setChecked(false);
+    }
+    if (configuration_->getCSValue("USBCAM_VFLIP") == "1") {
+        ui_->checkBoxFlipYUSB->setChecked(true);
+    } else {
+        ui_->checkBoxFlipYUSB->setChecked(false);
+    }
+
+    // set bluetooth type
+    if (configuration_->getCSValue("ENABLE_BLUETOOTH") == "1") {
+        QString bt = configuration_->getParamFromFile("/boot/config.txt","dtoverlay=pi3-disable-bt");
+        if (bt.contains("pi3-disable-bt")) {
+            ui_->comboBoxBluetooth->setCurrentText("external");
         } else {
-            ui_->checkBoxBlankOnly->setChecked(false);
+            ui_->comboBoxBluetooth->setCurrentText("builtin");
         }
+    } else {
+        ui_->comboBoxBluetooth->setCurrentText("none");
     }
-    // update network info
-    updateNetworkInfo();
+}
+
+void SettingsWindow::loadLightSensorValues()
+{
+    ui_->horizontalSliderBrightness1->setMinimum(configuration_->getCSValue("BR_MIN").toInt());
+    ui_->horizontalSliderBrightness1->setMaximum(configuration_->getCSValue("BR_MAX").toInt());
+    ui_->horizontalSliderBrightness1->setSingleStep(configuration_->getCSValue("BR_STEP").toInt());
+    ui_->horizontalSliderBrightness1->setTickInterval(configuration_->getCSValue("BR_STEP").toInt());
+
+    ui_->horizontalSliderBrightness2->setMinimum(configuration_->getCSValue("BR_MIN").toInt());
+    ui_->horizontalSliderBrightness2->setMaximum(configuration_->getCSValue("BR_MAX").toInt());
+    ui_->horizontalSliderBrightness2->setSingleStep(configuration_->getCSValue("BR_STEP").toInt());
+    ui_->horizontalSliderBrightness2->setTickInterval(configuration_->getCSValue("BR_STEP").toInt());
+
+    ui_->horizontalSliderBrightness3->setMinimum(configuration_->getCSValue("BR_MIN").toInt());
+    ui_->horizontalSliderBrightness3->setMaximum(configuration_->getCSValue("BR_MAX").toInt());
+    ui_->horizontalSliderBrightness3->setSingleStep(configuration_->getCSValue("BR_STEP").toInt());
+    ui_->horizontalSliderBrightness3->setTickInterval(configuration_->getCSValue("BR_STEP").toInt());
+
+    ui_->horizontalSliderBrightness4->setMinimum(configuration_->getCSValue("BR_MIN").toInt());
+    ui_->horizontalSliderBrightness4->setMaximum(configuration_->getCSValue("BR_MAX").toInt());
+    ui_->horizontalSliderBrightness4->setSingleStep(configuration_->getCSValue("BR_STEP").toInt());
+    ui_->horizontalSliderBrightness4->setTickInterval(configuration_->getCSValue("BR_STEP").toInt());
+
+    ui_->horizontalSliderBrightness5->setMinimum(configuration_->getCSValue("BR_MIN").toInt());
+    ui_->horizontalSliderBrightness5->setMaximum(configuration_->getCSValue("BR_MAX").toInt());
+    ui_->horizontalSliderBrightness5->setSingleStep(configuration_->getCSValue("BR_STEP").toInt());
+    ui_->horizontalSliderBrightness5->setTickInterval(configuration_->getCSValue("BR_STEP").toInt());
+
+    // set tsl2561 slider attribs
+    ui_->horizontalSliderLux1->setValue(configuration_->getCSValue("LUX_LEVEL_1").toInt());
+    ui_->horizontalSliderBrightness1->setValue(configuration_->getCSValue("DISP_BRIGHTNESS_1").toInt());
+    ui_->horizontalSliderLux2->setValue(configuration_->getCSValue("LUX_LEVEL_2").toInt());
+    ui_->horizontalSliderBrightness2->setValue(configuration_->getCSValue("DISP_BRIGHTNESS_2").toInt());
+    ui_->horizontalSliderLux3->setValue(configuration_->getCSValue("LUX_LEVEL_3").toInt());
+    ui_->horizontalSliderBrightness3->setValue(configuration_->getCSValue("DISP_BRIGHTNESS_3").toInt());
+    ui_->horizontalSliderLux4->setValue(configuration_->getCSValue("LUX_LEVEL_4").toInt());
+    ui_->horizontalSliderBrightness4->setValue(configuration_->getCSValue("DISP_BRIGHTNESS_4").toInt());
+    ui_->horizontalSliderLux5->setValue(configuration_->getCSValue("LUX_LEVEL_5").toInt());
+    ui_->horizontalSliderBrightness5->setValue(configuration_->getCSValue("DISP_BRIGHTNESS_5").toInt());
+    ui_->comboBoxCheckInterval->setCurrentText(configuration_->getCSValue("TSL2561_CHECK_INTERVAL"));
+    ui_->comboBoxNightmodeStep->setCurrentText(configuration_->getCSValue("TSL2561_DAYNIGHT_ON_STEP"));
 }
 
 void SettingsWindow::onStartHotspot()
@@ -1132,167 +1250,85 @@ void SettingsWindow::onStopHotspot()
 
 void SettingsWindow::updateSystemInfo()
 {
-    // free ram
-    struct sysinfo info;
-    sysinfo(&info);
-    ui_->valueSystemFreeMem->setText(QString::number(info.freeram/1024/1024) + " MB");
-    // current cpu speed
-    QString freq = configuration_->readFileContent("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_cur_freq");
-    int currentfreq = freq.toInt()/1000;
-    ui_->valueSystemCPUFreq->setText(QString::number(currentfreq) + "MHz");
-    // current cpu temp
-    QString temp = configuration_->readFileContent("/sys/class/thermal/thermal_zone0/temp");
-    int currenttemp = temp.toInt()/1000;
-    ui_->valueSystemCPUTemp->setText(QString::number(currenttemp) + "°C");
-    // get remaining times
-    QProcess process;
-    process.start("/bin/bash", QStringList() << "-c" << "systemctl list-timers -all | grep disconnect | awk {'print $1'}");
-    process.waitForFinished(-1);
-    QString stdout = process.readAllStandardOutput();
-    if (stdout.simplified() != "n/a") {
-        process.start("/bin/bash", QStringList() << "-c" << "systemctl list-timers -all | grep disconnect | awk {'print $5\" \"$6'}");
-        process.waitForFinished(-1);
-        QString stdout = process.readAllStandardOutput();
-        if (stdout.simplified() != "") {
-            ui_->valueDisconnectTimer->setText(stdout.simplified());
-        } else {
-            ui_->valueDisconnectTimer->setText("Stopped");
-        }
-    } else {
-        ui_->valueDisconnectTimer->setText("Stopped");
-    }
-    process.start("/bin/bash", QStringList() << "-c" << "systemctl list-timers -all | grep shutdown | awk {'print $1'}");
-    process.waitForFinished(-1);
-    stdout = process.readAllStandardOutput();
-    if (stdout.simplified() != "n/a") {
-        process.start("/bin/bash", QStringList() << "-c" << "systemctl list-timers -all | grep shutdown | awk {'print $5\" \"$6'}");
-        process.waitForFinished(-1);
-        QString stdout = process.readAllStandardOutput();
-        if (stdout.simplified() != "") {
-            ui_->valueShutdownTimer->setText(stdout.simplified());
-        } else {
-            ui_->valueShutdownTimer->setText("Stopped");
-        }
-    } else {
-        ui_->valueShutdownTimer->setText("Stopped");
+    // a collection still in flight will refresh the tab anyway
+    if(systemInfoPending_)
+    {
+        return;
     }
+
+    systemInfoPending_ = true;
+    QMetaObject::invokeMethod(systemInfoCollector_, "collect", Qt::QueuedConnection);
+}
+
+void SettingsWindow::onSystemInfoCollected(const QString& freeMemory, const QString& cpuFrequency, const QString& cpuTemperature,
+                                           const QString& disconnectTimer, const QString& shutdownTimer)
+{
+    systemInfoPending_ = false;
+
+    ui_->valueSystemFreeMem->setText(freeMemory);
+    ui_->valueSystemCPUFreq->setText(cpuFrequency);
+    ui_->valueSystemCPUTemp->setText(cpuTemperature);
+    ui_->valueDisconnectTimer->setText(disconnectTimer);
+    ui_->valueShutdownTimer->setText(shutdownTimer);
 }
 
 void SettingsWindow::show_tab1()
 {
-    ui_->tab2->hide();
-    ui_->tab3->hide();
-    ui_->tab4->hide();
-    ui_->tab5->hide();
-    ui_->tab6->hide();
-    ui_->tab7->hide();
-    ui_->tab8->hide();
-    ui_->tab9->hide();
-    ui_->tab1->show();
+    this->showTab(1);
 }
 
 void SettingsWindow::show_tab2()
 {
-    ui_->tab1->hide();
-    ui_->tab3->hide();
-    ui_->tab4->hide();
-    ui_->tab5->hide();
-    ui_->tab6->hide();
-    ui_->tab7->hide();
-    ui_->tab8->hide();
-    ui_->tab9->hide();
-    ui_->tab2->show();
+    this->showTab(2);
 }
 
 void SettingsWindow::show_tab3()
 {
-    ui_->tab1->hide();
-    ui_->tab2->hide();
-    ui_->tab4->hide();
-    ui_->tab5->hide();
-    ui_->tab6->hide();
-    ui_->tab7->hide();
-    ui_->tab8->hide();
-    ui_->tab9->hide();
-    ui_->tab3->show();
+    this->showTab(3);
 }
 
 void SettingsWindow::show_tab4()
 {
-    ui_->tab1->hide();
-    ui_->tab2->hide();
-    ui_->tab3->hide();
-    ui_->tab5->hide();
-    ui_->tab6->hide();
-    ui_->tab7->hide();
-    ui_->tab8->hide();
-    ui_->tab9->hide();
-    ui_->tab4->show();
+    this->showTab(4);
 }
 
 void SettingsWindow::show_tab5()
 {
-    ui_->tab1->hide();
-    ui_->tab2->hide();
-    ui_->tab3->hide();
-    ui_->tab4->hide();
-    ui_->tab6->hide();
-    ui_->tab7->hide();
-    ui_->tab8->hide();
-    ui_->tab9->hide();
-    ui_->tab5->show();
+    this->showTab(5);
 }
 
 void SettingsWindow::show_tab6()
 {
-    ui_->tab1->hide();
-    ui_->tab2->hide();
-    ui_->tab3->hide();
-    ui_->tab4->hide();
-    ui_->tab5->hide();
-    ui_->tab7->hide();
-    ui_->tab8->hide();
-    ui_->tab9->hide();
-    ui_->tab6->show();
+    this->showTab(6);
 }
 
 void SettingsWindow::show_tab7()
 {
-    ui_->tab1->hide();
-    ui_->tab2->hide();
-    ui_->tab3->hide();
-    ui_->tab4->hide();
-    ui_->tab5->hide();
-    ui_->tab6->hide();
-    ui_->tab8->hide();
-    ui_->tab9->hide();
-    ui_->tab7->show();
+    this->showTab(7);
 }
 
 void SettingsWindow::show_tab8()
 {
-    ui_->tab1->hide();
-    ui_->tab2->hide();
-    ui_->tab3->hide();
-    ui_->tab4->hide();
-    ui_->tab5->hide();
-    ui_->tab6->hide();
-    ui_->tab7->hide();
-    ui_->tab9->hide();
-    ui_->tab8->show();
+    this->showTab(8);
 }
 
 void SettingsWindow::show_tab9()
 {
-    ui_->tab1->hide();
-    ui_->tab2->hide();
-    ui_->tab3->hide();
-    ui_->tab4->hide();
-    ui_->tab5->hide();
-    ui_->tab6->hide();
-    ui_->tab7->hide();
-    ui_->tab8->hide();
-    ui_->tab9->show();
+    this->showTab(9);
+}
+
+void SettingsWindow::showTab(int tab)
+{
+    QWidget* tabs[cTabCount] = {ui_->tab1, ui_->tab2, ui_->tab3, ui_->tab4, ui_->tab5, ui_->tab6, ui_->tab7, ui_->tab8, ui_->tab9};
+
+    currentTab_ = tab;
+    for (int index = 0; index < cTabCount; ++index) {
+        if (index != tab - 1) {
+            tabs[index]->hide();
+        }
+    }
+    this->loadTabValues(tab);
+    tabs[tab - 1]->show();
 }
 
 }
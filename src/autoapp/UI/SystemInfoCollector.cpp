@@ -0,0 +1,133 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QProcess>
+#include <QStringList>
+#include <sys/sysinfo.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <f1x/openauto/autoapp/UI/SystemInfoCollector.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+const char* SystemInfoCollector::cCpuFrequencyFileName = "/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_cur_freq";
+const char* SystemInfoCollector::cCpuTemperatureFileName = "/sys/class/thermal/thermal_zone0/temp";
+
+SystemInfoCollector::SystemInfoCollector(QObject* parent)
+    : QObject(parent)
+    , cpuFrequencyFd_(-1)
+    , cpuTemperatureFd_(-1)
+{
+
+}
+
+SystemInfoCollector::~SystemInfoCollector()
+{
+    if(cpuFrequencyFd_ >= 0)
+    {
+        ::close(cpuFrequencyFd_);
+    }
+
+    if(cpuTemperatureFd_ >= 0)
+    {
+        ::close(cpuTemperatureFd_);
+    }
+}
+
+void SystemInfoCollector::collect()
+{
+    struct sysinfo info;
+    sysinfo(&info);
+    const auto freeMemory = QString::number(info.freeram / 1024 / 1024) + " MB";
+    const auto cpuFrequency = QString::number(this->readValue(cpuFrequencyFd_, cCpuFrequencyFileName) / 1000) + "MHz";
+    const auto cpuTemperature = QString::number(this->readValue(cpuTemperatureFd_, cCpuTemperatureFileName) / 1000) + "°C";
+
+    QString disconnectTimer;
+    QString shutdownTimer;
+    this->readTimers(disconnectTimer, shutdownTimer);
+
+    emit collected(freeMemory, cpuFrequency, cpuTemperature, disconnectTimer, shutdownTimer);
+}
+
+int SystemInfoCollector::readValue(int& fd, const char* fileName)
+{
+    // sysfs attributes are regenerated on every read from offset 0, so the descriptor is opened once and kept
+    if(fd < 0)
+    {
+        fd = ::open(fileName, O_RDONLY | O_CLOEXEC);
+        if(fd < 0)
+        {
+            return 0;
+        }
+    }
+
+    char buffer[32];
+    const auto size = ::pread(fd, buffer, sizeof(buffer) - 1, 0);
+    if(size <= 0)
+    {
+        return 0;
+    }
+
+    buffer[size] = '\0';
+    return std::atoi(buffer);
+}
+
+void SystemInfoCollector::readTimers(QString& disconnectTimer, QString& shutdownTimer)
+{
+    disconnectTimer = "Stopped";
+    shutdownTimer = "Stopped";
+
+    QProcess process;
+    process.start("systemctl", QStringList() << "list-timers" << "--all" << "--no-legend" << "--no-pager");
+    if(!process.waitForFinished(5000))
+    {
+        process.kill();
+        process.waitForFinished();
+        return;
+    }
+
+    // columns: NEXT (4 fields or n/a), LEFT (2 fields), LAST, PASSED, UNIT, ACTIVATES
+    const auto lines = QString::fromLocal8Bit(process.readAllStandardOutput()).split('\n', QString::SkipEmptyParts);
+    for(const auto& line : lines)
+    {
+        QString* target = line.contains("disconnect") ? &disconnectTimer : (line.contains("shutdown") ? &shutdownTimer : nullptr);
+        if(target == nullptr || *target != "Stopped")
+        {
+            continue;
+        }
+
+        const auto fields = line.simplified().split(' ');
+        if(fields.size() > 5 && fields[0] != "n/a")
+        {
+            *target = fields[4] + " " + fields[5];
+        }
+    }
+}
+
+}
+}
+}
+}
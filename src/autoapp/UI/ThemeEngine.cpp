@@ -0,0 +1,154 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/autoapp/UI/ThemeEngine.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+namespace
+{
+
+struct ButtonStyle
+{
+    const char* objectName;
+    const char* color;
+    const char* declarations;
+    bool focusable;
+};
+
+const char* const cMenuButton = "outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);";
+const char* const cMenuButtonWhite = "outline-style: dotted; outline-color: #92a8d1; border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255);";
+const char* const cOldMenuButton = "color: rgb(255, 255, 255); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5);";
+const char* const cFocusRule = "border: 2px solid rgba(125,125,125,0.5);";
+
+const ButtonStyle cButtonStyles[] = {
+    {"pushButtonExit", "164, 0, 0", cMenuButton, true},
+    {"pushButtonShutdown", "239, 41, 41", cMenuButton, true},
+    {"pushButtonReboot", "252, 175, 62", cMenuButton, true},
+    {"pushButtonCancel", "32, 74, 135", cMenuButton, true},
+    {"pushButtonBrightness", "245, 121, 0", cMenuButton, true},
+    {"pushButtonVolume", "64, 191, 191", cMenuButton, true},
+    {"pushButtonLock", "15, 54, 5", cMenuButton, true},
+    {"pushButtonSettings", "138, 226, 52", cMenuButton, true},
+    {"pushButtonDay", "252, 233, 79", cMenuButton, true},
+    {"pushButtonNight", "114, 159, 207", cMenuButton, true},
+    {"pushButtonCameraShow", "100, 62, 4", cMenuButton, true},
+    {"pushButtonWifi", "252, 175, 62", cMenuButton, true},
+    {"pushButtonToggleGUI", "237, 164, 255", cMenuButton, true},
+    {"pushButtonDummy1", "186, 189, 182", cMenuButton, true},
+    {"pushButtonDummy2", "186, 189, 182", cMenuButton, true},
+    {"pushButtonDummy3", "186, 189, 182", cMenuButton, true},
+    {"pushButtonDebug", "85, 87, 83", cMenuButton, true},
+    {"pushButtonMusic", "78, 154, 6", cMenuButtonWhite, true},
+    {"pushButtonAndroidAuto", "48, 140, 198", "outline-style: dotted; outline-color: #92a8d1; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255); border-bottom: 0px; border-top: 0px;", true},
+    {"labelAndroidAutoBottom", "48, 140, 198", "border-bottom-left-radius: 4px; border-bottom-right-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255); border-top: 0px;", false},
+    {"labelAndroidAutoTop", "48, 140, 198", "border-top-left-radius: 4px; border-top-right-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255); border-bottom: 0px;", false},
+    {"pushButtonNoDevice", "48, 140, 198", "border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255);", false},
+    {"pushButtonNoWiFiDevice", "252, 175, 62", "border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(255,255,255);", false},
+    // old style
+    {"pushButtonSettings2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonLock2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonMusic2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonBrightness2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonToggleGUI2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonExit2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonShutdown2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonReboot2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonCancel2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonAndroidAuto2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonNoDevice2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonWifi2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonNoWiFiDevice2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonDay2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonNight2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonCameraShow2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonVolume2", "136, 138, 133", cOldMenuButton, false},
+    {"pushButtonDebug2", "136, 138, 133", cOldMenuButton, false}
+};
+
+QString buildRule(const QString& objectName, const QString& color, const QString& alpha, const QString& declarations, bool focusable)
+{
+    QString rule = "#" + objectName + " { background-color: rgba(" + color + ", " + alpha + "); " + declarations + " }\n";
+    if(focusable)
+    {
+        rule += "#" + objectName + ":focus { " + cFocusRule + " }\n";
+    }
+    return rule;
+}
+
+}
+
+ThemeEngine::ThemeEngine()
+{
+    for(int i = 0; i < 6; ++i)
+    {
+        customButtonColors_ << "186,189,192";
+    }
+}
+
+void ThemeEngine::setCustomButtonColors(const QStringList& colors)
+{
+    if(colors != customButtonColors_)
+    {
+        customButtonColors_ = colors;
+        cache_.clear();
+    }
+}
+
+const QString& ThemeEngine::getStyleSheet(int alpha)
+{
+    auto it = cache_.find(alpha);
+
+    if(it == cache_.end())
+    {
+        // the wallpaper is painted by MainWindow itself on top of this
+        it = cache_.emplace(alpha, "QMainWindow { background-color: rgb(0,0,0); }\n#menuWidget { outline: none; }\n" + this->buildButtonRules(alpha)).first;
+    }
+
+    return it->second;
+}
+
+QString ThemeEngine::buildButtonRules(int alpha) const
+{
+    const auto alphaValue = QString::number(alpha / 100.0);
+    QString rules;
+
+    for(const auto& style : cButtonStyles)
+    {
+        rules += buildRule(style.objectName, style.color, alphaValue, style.declarations, style.focusable);
+    }
+
+    for(int i = 0; i < customButtonColors_.size(); ++i)
+    {
+        rules += buildRule("pushButton_c" + QString::number(i + 1), customButtonColors_[i], alphaValue, cMenuButtonWhite, true);
+    }
+
+    return rules;
+}
+
+}
+}
+}
+}
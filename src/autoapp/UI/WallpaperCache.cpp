@@ -0,0 +1,99 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QMetaObject>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/UI/WallpaperCache.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+namespace
+{
+
+const std::pair<WallpaperCache::Wallpaper, const char*> cWallpaperFiles[] = {
+    {WallpaperCache::Wallpaper::DAY, "wallpaper.png"},
+    {WallpaperCache::Wallpaper::NIGHT, "wallpaper-night.png"},
+    {WallpaperCache::Wallpaper::CLASSIC_DAY, "wallpaper-classic.png"},
+    {WallpaperCache::Wallpaper::CLASSIC_NIGHT, "wallpaper-classic-night.png"},
+    {WallpaperCache::Wallpaper::EQ, "wallpaper-eq.png"},
+    {WallpaperCache::Wallpaper::CHRISTMAS, ":/wallpaper-christmas.png"},
+    {WallpaperCache::Wallpaper::FIREWORK, ":/wallpaper-firework.png"}
+};
+
+}
+
+WallpaperCache::WallpaperCache(const QSize& size, QObject* parent)
+    : QObject(parent)
+    , thread_(&WallpaperCache::loadImages, this, size)
+{
+
+}
+
+WallpaperCache::~WallpaperCache()
+{
+    thread_.join();
+}
+
+const QPixmap& WallpaperCache::get(Wallpaper wallpaper) const
+{
+    auto it = pixmaps_.find(wallpaper);
+    return it != pixmaps_.end() ? it->second : empty_;
+}
+
+void WallpaperCache::onImageLoaded(int wallpaper, const QImage& image)
+{
+    // QPixmap has to be created on the GUI thread
+    pixmaps_[static_cast<Wallpaper>(wallpaper)] = QPixmap::fromImage(image);
+    emit loaded();
+}
+
+void WallpaperCache::loadImages(QSize size)
+{
+    for(const auto& wallpaperFile : cWallpaperFiles)
+    {
+        QImage image(wallpaperFile.second);
+        if(image.isNull())
+        {
+            continue;
+        }
+
+        if(size.isValid() && image.size() != size)
+        {
+            image = image.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+        }
+
+        // the raster paint engine blits premultiplied ARGB without a conversion pass
+        image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+        OPENAUTO_LOG(debug) << "[WallpaperCache] loaded " << wallpaperFile.second;
+        QMetaObject::invokeMethod(this, "onImageLoaded", Qt::QueuedConnection,
+                                  Q_ARG(int, static_cast<int>(wallpaperFile.first)), Q_ARG(QImage, image));
+    }
+}
+
+}
+}
+}
+}
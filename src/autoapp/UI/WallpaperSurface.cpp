@@ -0,0 +1,78 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QPainter>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/UI/WallpaperSurface.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+WallpaperSurface::WallpaperSurface(WallpaperCache* wallpaperCache, QWidget* parent)
+    : QOpenGLWidget(parent)
+    , wallpaperCache_(wallpaperCache)
+    , wallpaper_(WallpaperCache::Wallpaper::NONE)
+{
+    this->setAttribute(Qt::WA_TransparentForMouseEvents);
+    connect(wallpaperCache_, &WallpaperCache::loaded, this, static_cast<void (QWidget::*)()>(&QWidget::update));
+}
+
+void WallpaperSurface::setWallpaper(WallpaperCache::Wallpaper wallpaper)
+{
+    if(wallpaper != wallpaper_)
+    {
+        wallpaper_ = wallpaper;
+        this->update();
+    }
+}
+
+void WallpaperSurface::initializeGL()
+{
+    // a broken context answers with null instead of a string
+    auto functions = this->context()->functions();
+    const auto* renderer = reinterpret_cast<const char*>(functions->glGetString(GL_RENDERER));
+    const auto* version = reinterpret_cast<const char*>(functions->glGetString(GL_VERSION));
+    OPENAUTO_LOG(info) << "[WallpaperSurface] OpenGL renderer: " << (renderer != nullptr ? renderer : "unknown")
+                       << ", version: " << (version != nullptr ? version : "unknown");
+}
+
+void WallpaperSurface::paintGL()
+{
+    // the pixmap is uploaded once and kept in the context's texture cache by its cacheKey
+    QPainter painter(this);
+    painter.fillRect(this->rect(), Qt::black);
+
+    const QPixmap& wallpaper = wallpaperCache_->get(wallpaper_);
+    if(!wallpaper.isNull())
+    {
+        painter.drawPixmap((this->width() - wallpaper.width()) / 2, (this->height() - wallpaper.height()) / 2, wallpaper);
+    }
+}
+
+}
+}
+}
+}
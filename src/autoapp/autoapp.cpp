@@ -17,6 +17,7 @@
 */
 
 #include <thread>
+#include <memory>
 #include <QApplication>
 #include <QDesktopWidget>
 #include <f1x/aasdk/USB/USBHub.hpp>
@@ -97,11 +98,8 @@ int main(int argc, char* argv[])
     autoapp::ui::MainWindow mainWindow(configuration);
     //mainWindow.setWindowFlags(Qt::WindowStaysOnTopHint);
 
-    autoapp::ui::SettingsWindow settingsWindow(configuration);
-    //settingsWindow.setWindowFlags(Qt::WindowStaysOnTopHint);
-
-    settingsWindow.setFixedSize(width, height);
-    settingsWindow.adjustSize();
+    // most drives never open the settings, the window is built on first use
+    std::unique_ptr<autoapp::ui::SettingsWindow> settingsWindow;
 
     autoapp::configuration::RecentAddressesList recentAddressesList(7);
     recentAddressesList.read();
@@ -120,11 +118,19 @@ int main(int argc, char* argv[])
     updatedialog.setFixedSize(500, 260);
     updatedialog.move((width - 500)/2,(height-260)/2);
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::exit, []() { system("touch /tmp/shutdown"); std::exit(0); });
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::reboot, []() { system("touch /tmp/reboot"); std::exit(0); });
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::openSettings, &settingsWindow, &autoapp::ui::SettingsWindow::showFullScreen);
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::openSettings, &settingsWindow, &autoapp::ui::SettingsWindow::show_tab1);
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::openSettings, &settingsWindow, &autoapp::ui::SettingsWindow::loadSystemValues);
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::exit, [&configuration]() { configuration->flush(); system("touch /tmp/shutdown"); std::exit(0); });
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::reboot, [&configuration]() { configuration->flush(); system("touch /tmp/reboot"); std::exit(0); });
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::openSettings, [&settingsWindow, &configuration, width, height]() {
+        if (settingsWindow == nullptr) {
+            settingsWindow = std::make_unique<autoapp::ui::SettingsWindow>(configuration);
+            //settingsWindow->setWindowFlags(Qt::WindowStaysOnTopHint);
+            settingsWindow->setFixedSize(width, height);
+            settingsWindow->adjustSize();
+        }
+        settingsWindow->showFullScreen();
+        settingsWindow->show_tab1();
+        settingsWindow->loadSystemValues();
+    });
     QObject::connect(&mainWindow, &autoapp::ui::MainWindow::openConnectDialog, &connectdialog, &autoapp::ui::ConnectDialog::loadClientList);
     QObject::connect(&mainWindow, &autoapp::ui::MainWindow::openConnectDialog, &connectdialog, &autoapp::ui::ConnectDialog::exec);
     QObject::connect(&mainWindow, &autoapp::ui::MainWindow::openUpdateDialog, &updatedialog, &autoapp::ui::UpdateDialog::updateCheck);
@@ -250,7 +256,9 @@ int main(int argc, char* argv[])
     });
 
     QObject::connect(&mainWindow, &autoapp::ui::MainWindow::CloseAllDialogs, [&settingsWindow, &connectdialog, &updatedialog, &warningdialog]() {
-        settingsWindow.close();
+        if (settingsWindow != nullptr) {
+            settingsWindow->close();
+        }
         connectdialog.close();
         warningdialog.close();
         updatedialog.close();
@@ -0,0 +1,124 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVMediaAckIndicationMessage.pb.h>
+#include <f1x/aasdk/Channel/AV/VideoServiceChannel.hpp>
+#include <f1x/openauto/autoapp/Service/MessagePool.hpp>
+#include <f1x/openauto/autoapp/Service/SendPromisePool.hpp>
+#include <f1x/openauto/replay/AllocationCounter.hpp>
+#include <f1x/openauto/replay/AckBenchmark.hpp>
+#include <f1x/openauto/replay/ReplayMessenger.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+constexpr size_t AckBenchmark::cBatchSize;
+
+AckBenchmark::AckBenchmark(size_t count)
+    : count_(std::max(count, cBatchSize))
+{
+
+}
+
+void AckBenchmark::run(std::ostream& stream)
+{
+    boost::asio::io_service ioService;
+    boost::asio::io_service::strand strand(ioService);
+    ReplayStatistics statistics;
+    auto messenger = std::make_shared<ReplayMessenger>(statistics);
+    auto channel = std::make_shared<aasdk::channel::av::VideoServiceChannel>(strand, messenger);
+
+    // stands in for the service that a pending send keeps alive
+    auto owner = std::make_shared<int>(0);
+
+    this->measure(stream, "channel", ioService, strand, [&]() {
+        aasdk::proto::messages::AVMediaAckIndication indication;
+        indication.set_session(0);
+        indication.set_value(1);
+
+        auto promise = aasdk::channel::SendPromise::defer(strand);
+        promise->then([]() {}, [owner](const aasdk::error::Error&) {});
+        channel->sendAVMediaAckIndication(indication, std::move(promise));
+    });
+
+    autoapp::service::MessagePool messages(channel->getId(), aasdk::proto::ids::AVChannelMessage::AV_MEDIA_ACK_INDICATION);
+    autoapp::service::SendPromisePool promises;
+    aasdk::proto::messages::AVMediaAckIndication indication;
+    indication.set_session(0);
+    indication.set_value(1);
+    aasdk::common::Data ackIndication;
+    autoapp::service::MessagePool::serialize(indication, ackIndication);
+
+    this->measure(stream, "pooled", ioService, strand, [&]() {
+        auto message = messages.acquire();
+        message->insertPayload(ackIndication);
+
+        auto promise = promises.defer(strand, owner);
+        promise->then([]() {}, [](const aasdk::error::Error&) {});
+        messenger->enqueueSend(std::move(message), std::move(promise));
+    });
+
+    stream << "pooled overflow: messages " << messages.getOverflowCount() << ", promises " << promises.getOverflowCount() << std::endl;
+}
+
+void AckBenchmark::measure(std::ostream& stream, const std::string& name, boost::asio::io_service& ioService, boost::asio::io_service::strand& strand,
+                           const std::function<void()>& send)
+{
+    const auto sendBatch = [&]() {
+        strand.post([&send]() {
+            for(size_t i = 0; i < cBatchSize; ++i)
+            {
+                send();
+            }
+        });
+
+        // returns once every completion has run
+        ioService.run();
+        ioService.reset();
+    };
+
+    sendBatch();
+
+    const auto batches = (count_ + cBatchSize - 1) / cBatchSize;
+    const auto allocationsStart = AllocationCounter::get();
+    const auto start = std::chrono::steady_clock::now();
+
+    for(size_t batch = 0; batch < batches; ++batch)
+    {
+        sendBatch();
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    const auto allocations = AllocationCounter::get() - allocationsStart;
+    const double sent = batches * cBatchSize;
+
+    stream << std::fixed << std::setprecision(2)
+           << name << ": " << elapsed.count() / sent << " ns/ack, " << allocations / sent << " allocations/ack" << std::endl;
+}
+
+}
+}
+}
@@ -0,0 +1,108 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <iomanip>
+#include <f1x/aasdk/Channel/Control/ControlServiceChannel.hpp>
+#include <f1x/openauto/autoapp/Service/AndroidAutoEntity.hpp>
+#include <f1x/openauto/autoapp/Service/MessageArena.hpp>
+#include <f1x/openauto/replay/AllocationCounter.hpp>
+#include <f1x/openauto/replay/DiscoveryBenchmark.hpp>
+#include <f1x/openauto/replay/ReplayMessenger.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+DiscoveryBenchmark::DiscoveryBenchmark(autoapp::configuration::IConfiguration::Pointer configuration, autoapp::service::ServiceList serviceList, size_t count)
+    : configuration_(std::move(configuration))
+    , serviceList_(std::move(serviceList))
+    , count_(count)
+{
+
+}
+
+void DiscoveryBenchmark::run(std::ostream& stream)
+{
+    boost::asio::io_service ioService;
+    boost::asio::io_service::strand strand(ioService);
+    ReplayStatistics statistics;
+    auto messenger = std::make_shared<ReplayMessenger>(statistics);
+    auto channel = std::make_shared<aasdk::channel::control::ControlServiceChannel>(strand, messenger);
+
+    this->measure(stream, "stack", ioService, strand, [&]() {
+        aasdk::proto::messages::ServiceDiscoveryResponse response;
+        autoapp::service::AndroidAutoEntity::fillServiceDiscoveryResponse(*configuration_, serviceList_, response);
+
+        auto promise = aasdk::channel::SendPromise::defer(strand);
+        promise->then([]() {}, [](const aasdk::error::Error&) {});
+        channel->sendServiceDiscoveryResponse(response, std::move(promise));
+    });
+
+    autoapp::service::MessageArena arena(autoapp::service::AndroidAutoEntity::cArenaSize);
+
+    this->measure(stream, "arena", ioService, strand, [&]() {
+        auto& response = *arena.create<aasdk::proto::messages::ServiceDiscoveryResponse>();
+        autoapp::service::AndroidAutoEntity::fillServiceDiscoveryResponse(*configuration_, serviceList_, response);
+
+        auto promise = aasdk::channel::SendPromise::defer(strand);
+        promise->then([]() {}, [](const aasdk::error::Error&) {});
+        channel->sendServiceDiscoveryResponse(response, std::move(promise));
+        arena.reset();
+    });
+
+    stream << "arena overflow: " << arena.getOverflowCount() << std::endl;
+}
+
+void DiscoveryBenchmark::measure(std::ostream& stream, const std::string& name, boost::asio::io_service& ioService, boost::asio::io_service::strand& strand,
+                                 const std::function<void()>& send)
+{
+    const auto sendAll = [&](size_t count) {
+        strand.post([&send, count]() {
+            for(size_t i = 0; i < count; ++i)
+            {
+                send();
+            }
+        });
+
+        // the sends and the completions they queue all finish before the next round is timed
+        ioService.run();
+        ioService.reset();
+    };
+
+    sendAll(1);
+
+    const auto allocationsStart = AllocationCounter::get();
+    const auto start = std::chrono::steady_clock::now();
+
+    sendAll(count_);
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    const auto allocations = AllocationCounter::get() - allocationsStart;
+    const double sent = count_;
+
+    stream << std::fixed << std::setprecision(2)
+           << name << ": " << elapsed.count() / sent / 1000.0 << " us/response, " << allocations / sent << " allocations/response" << std::endl;
+}
+
+}
+}
+}
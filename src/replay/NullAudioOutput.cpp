@@ -0,0 +1,78 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/replay/NullAudioOutput.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+NullAudioOutput::NullAudioOutput(uint32_t channelCount, uint32_t sampleSize, uint32_t sampleRate)
+    : channelCount_(channelCount)
+    , sampleSize_(sampleSize)
+    , sampleRate_(sampleRate)
+{
+
+}
+
+bool NullAudioOutput::open()
+{
+    return true;
+}
+
+void NullAudioOutput::write(aasdk::messenger::Timestamp::ValueType, const aasdk::common::DataConstBuffer&)
+{
+
+}
+
+void NullAudioOutput::start()
+{
+
+}
+
+void NullAudioOutput::stop()
+{
+
+}
+
+void NullAudioOutput::suspend()
+{
+
+}
+
+uint32_t NullAudioOutput::getSampleSize() const
+{
+    return sampleSize_;
+}
+
+uint32_t NullAudioOutput::getChannelCount() const
+{
+    return channelCount_;
+}
+
+uint32_t NullAudioOutput::getSampleRate() const
+{
+    return sampleRate_;
+}
+
+}
+}
+}
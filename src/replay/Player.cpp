@@ -0,0 +1,159 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <limits>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/replay/Player.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+constexpr size_t Player::cQueueWindow;
+constexpr std::chrono::milliseconds Player::cStartDelay;
+constexpr std::chrono::milliseconds Player::cDrainInterval;
+constexpr std::chrono::seconds Player::cIdleTimeout;
+
+Player::Player(boost::asio::io_service& ioService, ReplayMessenger::Pointer messenger, IMessageSource::Pointer source, ReplayStatistics& statistics, bool realtime, double speed)
+    : strand_(ioService)
+    , timer_(ioService)
+    , messenger_(std::move(messenger))
+    , source_(std::move(source))
+    , statistics_(statistics)
+    , realtime_(realtime)
+    , speed_(speed)
+    , hasNext_(false)
+    , waiting_(false)
+    , firstTimestamp_(std::numeric_limits<uint64_t>::max())
+    , deliveredCount_(0)
+{
+
+}
+
+void Player::start(FinishHandler handler)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), handler = std::move(handler)]() mutable {
+        finishHandler_ = std::move(handler);
+
+        if(!realtime_)
+        {
+            messenger_->setDeliveryHandler([this, self = this->shared_from_this()]() {
+                strand_.post([this, self = this->shared_from_this()]() {
+                    if(waiting_)
+                    {
+                        waiting_ = false;
+                        this->pump();
+                    }
+                });
+            });
+        }
+
+        // services arm their channels asynchronously after start()
+        timer_.expires_from_now(cStartDelay);
+        timer_.async_wait(strand_.wrap([this, self = this->shared_from_this()](const boost::system::error_code&) {
+            startTime_ = std::chrono::steady_clock::now();
+            this->pump();
+        }));
+    });
+}
+
+void Player::pump()
+{
+    while(true)
+    {
+        if(!hasNext_)
+        {
+            hasNext_ = source_->next(next_);
+            if(!hasNext_)
+            {
+                break;
+            }
+        }
+
+        const auto channelId = next_.message->getChannelId();
+        if(!messenger_->isReceiving(channelId))
+        {
+            statistics_.addSkipped(channelId);
+            hasNext_ = false;
+            continue;
+        }
+
+        if(realtime_)
+        {
+            firstTimestamp_ = std::min(firstTimestamp_, next_.timestamp);
+            const auto offset = std::chrono::microseconds(static_cast<uint64_t>((next_.timestamp - firstTimestamp_) / speed_));
+            const auto due = startTime_ + offset;
+            if(std::chrono::steady_clock::now() < due)
+            {
+                timer_.expires_at(due);
+                timer_.async_wait(strand_.wrap([this, self = this->shared_from_this()](const boost::system::error_code&) {
+                    this->pump();
+                }));
+                return;
+            }
+        }
+        else if(messenger_->getQueueSize(channelId) >= cQueueWindow)
+        {
+            // picked up again by the delivery handler
+            waiting_ = true;
+            return;
+        }
+
+        messenger_->inject(std::move(next_.message));
+        hasNext_ = false;
+    }
+
+    progressTime_ = std::chrono::steady_clock::now();
+    this->waitForDrain();
+}
+
+void Player::waitForDrain()
+{
+    const auto deliveredCount = messenger_->getDeliveredCount();
+    const auto now = std::chrono::steady_clock::now();
+    if(deliveredCount != deliveredCount_)
+    {
+        deliveredCount_ = deliveredCount;
+        progressTime_ = now;
+    }
+
+    const auto queueSize = messenger_->getQueueSize();
+    if(queueSize == 0 || now - progressTime_ >= cIdleTimeout)
+    {
+        if(queueSize > 0)
+        {
+            OPENAUTO_LOG(warning) << "[Player] " << queueSize << " messages left undelivered, services stopped receiving.";
+        }
+
+        messenger_->setDeliveryHandler(nullptr);
+        finishHandler_();
+        return;
+    }
+
+    timer_.expires_from_now(cDrainInterval);
+    timer_.async_wait(strand_.wrap([this, self = this->shared_from_this()](const boost::system::error_code&) {
+        this->waitForDrain();
+    }));
+}
+
+}
+}
+}
@@ -0,0 +1,169 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/aasdk/Error/Error.hpp>
+#include <f1x/openauto/replay/ReplayMessenger.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+ReplayMessenger::ReplayMessenger(ReplayStatistics& statistics)
+    : statistics_(statistics)
+    , deliveredCount_(0)
+    , stopped_(false)
+{
+
+}
+
+void ReplayMessenger::enqueueReceive(aasdk::messenger::ChannelId channelId, ReceivePromise::Pointer promise)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if(stopped_)
+    {
+        lock.unlock();
+        promise->reject(aasdk::error::Error(aasdk::error::ErrorCode::OPERATION_ABORTED));
+        return;
+    }
+
+    auto& channel = channels_[channelId];
+    if(channel.handling)
+    {
+        channel.handling = false;
+        statistics_.addLatency(channelId, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - channel.deliveredAt));
+    }
+
+    if(channel.queue.empty())
+    {
+        channel.promise = std::move(promise);
+        return;
+    }
+
+    auto message = std::move(channel.queue.front());
+    channel.queue.pop_front();
+    this->deliver(channel, std::move(promise), std::move(message), lock);
+}
+
+void ReplayMessenger::enqueueSend(aasdk::messenger::Message::Pointer message, SendPromise::Pointer promise)
+{
+    statistics_.addOutbound(message->getChannelId(), message->getPayload().size());
+    promise->resolve();
+}
+
+void ReplayMessenger::stop()
+{
+    std::map<aasdk::messenger::ChannelId, Channel> channels;
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        stopped_ = true;
+        channels.swap(channels_);
+    }
+
+    for(auto& channel : channels)
+    {
+        if(channel.second.promise != nullptr)
+        {
+            channel.second.promise->reject(aasdk::error::Error(aasdk::error::ErrorCode::OPERATION_ABORTED));
+        }
+    }
+}
+
+void ReplayMessenger::inject(aasdk::messenger::Message::Pointer message)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if(stopped_)
+    {
+        return;
+    }
+
+    auto& channel = channels_[message->getChannelId()];
+    if(channel.promise == nullptr)
+    {
+        channel.queue.push_back(std::move(message));
+        return;
+    }
+
+    auto promise = std::move(channel.promise);
+    channel.promise.reset();
+    this->deliver(channel, std::move(promise), std::move(message), lock);
+}
+
+void ReplayMessenger::deliver(Channel& channel, ReceivePromise::Pointer promise, aasdk::messenger::Message::Pointer message, std::unique_lock<std::mutex>& lock)
+{
+    channel.handling = true;
+    channel.deliveredAt = std::chrono::steady_clock::now();
+    ++deliveredCount_;
+    auto handler = deliveryHandler_;
+
+    // the promise may run the channel handler inline, which calls back into enqueueReceive
+    lock.unlock();
+
+    statistics_.addInbound(message->getChannelId(), message->getPayload().size());
+    promise->resolve(std::move(message));
+
+    if(handler)
+    {
+        handler();
+    }
+}
+
+void ReplayMessenger::setDeliveryHandler(DeliveryHandler handler)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    deliveryHandler_ = std::move(handler);
+}
+
+bool ReplayMessenger::isReceiving(aasdk::messenger::ChannelId channelId) const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return channels_.count(channelId) != 0;
+}
+
+size_t ReplayMessenger::getQueueSize(aasdk::messenger::ChannelId channelId) const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    auto channel = channels_.find(channelId);
+    return channel == channels_.end() ? 0 : channel->second.queue.size();
+}
+
+size_t ReplayMessenger::getQueueSize() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    size_t size = 0;
+    for(const auto& channel : channels_)
+    {
+        size += channel.second.queue.size();
+    }
+    return size;
+}
+
+uint64_t ReplayMessenger::getDeliveredCount() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return deliveredCount_;
+}
+
+}
+}
+}
@@ -0,0 +1,147 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iomanip>
+#include <f1x/openauto/replay/ReplayStatistics.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+constexpr size_t ReplayStatistics::cHistogramBuckets;
+
+ReplayStatistics::ReplayStatistics()
+{
+
+}
+
+void ReplayStatistics::addInbound(aasdk::messenger::ChannelId channelId, size_t size)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    auto& channel = channels_[channelId];
+    ++channel.inboundMessages;
+    channel.inboundBytes += size;
+}
+
+void ReplayStatistics::addOutbound(aasdk::messenger::ChannelId channelId, size_t size)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    auto& channel = channels_[channelId];
+    ++channel.outboundMessages;
+    channel.outboundBytes += size;
+}
+
+void ReplayStatistics::addSkipped(aasdk::messenger::ChannelId channelId)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    ++channels_[channelId].skippedMessages;
+}
+
+void ReplayStatistics::addLatency(aasdk::messenger::ChannelId channelId, std::chrono::microseconds latency)
+{
+    const uint64_t value = latency.count();
+
+    size_t bucket = 0;
+    while(bucket < cHistogramBuckets - 1 && value >= (uint64_t(1) << bucket))
+    {
+        ++bucket;
+    }
+
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    auto& channel = channels_[channelId];
+    ++channel.latency[bucket];
+    channel.maxLatency = std::max(channel.maxLatency, value);
+}
+
+uint64_t ReplayStatistics::percentile(const Histogram& histogram, double fraction)
+{
+    uint64_t total = 0;
+    for(const auto& count : histogram)
+    {
+        total += count;
+    }
+
+    uint64_t seen = 0;
+    for(size_t bucket = 0; bucket < histogram.size(); ++bucket)
+    {
+        seen += histogram[bucket];
+        if(total > 0 && seen >= total * fraction)
+        {
+            return uint64_t(1) << bucket;
+        }
+    }
+
+    return 0;
+}
+
+void ReplayStatistics::report(std::ostream& stream, const Usage& usage) const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    const double seconds = std::max<double>(usage.wall.count(), 1) / 1000000.0;
+
+    stream << std::fixed << std::setprecision(2);
+    stream << "wall " << seconds << " s, cpu user " << usage.user.count() / 1000000.0 << " s, system " << usage.system.count() / 1000000.0
+           << " s (" << 100.0 * (usage.user.count() + usage.system.count()) / 1000000.0 / seconds << "% of one core)" << std::endl;
+
+    uint64_t inboundMessages = 0;
+    for(const auto& channel : channels_)
+    {
+        inboundMessages += channel.second.inboundMessages;
+    }
+    stream << "heap allocations " << usage.allocations << ", " << usage.allocations / std::max<double>(inboundMessages, 1)
+           << " per inbound msg" << std::endl;
+
+    for(const auto& channel : channels_)
+    {
+        const auto& statistics = channel.second;
+
+        stream << std::endl << aasdk::messenger::channelIdToString(channel.first) << std::endl;
+        stream << "  in  " << statistics.inboundMessages << " msgs, " << statistics.inboundBytes / 1024.0 / 1024.0 << " MiB, "
+               << statistics.inboundMessages / seconds << " msg/s, " << statistics.inboundBytes / seconds / 1024.0 / 1024.0 << " MiB/s" << std::endl;
+        stream << "  out " << statistics.outboundMessages << " msgs, " << statistics.outboundBytes / 1024.0 / 1024.0 << " MiB" << std::endl;
+
+        if(statistics.skippedMessages > 0)
+        {
+            stream << "  skipped " << statistics.skippedMessages << " msgs without a receiving service" << std::endl;
+        }
+
+        if(statistics.inboundMessages > 0)
+        {
+            stream << "  handler latency p50 < " << percentile(statistics.latency, 0.5) << " us, p99 < " << percentile(statistics.latency, 0.99)
+                   << " us, max " << statistics.maxLatency << " us" << std::endl;
+
+            stream << "  histogram";
+            for(size_t bucket = 0; bucket < statistics.latency.size(); ++bucket)
+            {
+                if(statistics.latency[bucket] > 0)
+                {
+                    stream << " <" << (uint64_t(1) << bucket) << "us:" << statistics.latency[bucket];
+                }
+            }
+            stream << std::endl;
+        }
+    }
+}
+
+}
+}
+}
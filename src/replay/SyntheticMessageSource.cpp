@@ -0,0 +1,219 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <limits>
+#include <QFile>
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
+#include <aasdk_proto/InputChannelMessageIdsEnum.pb.h>
+#include <aasdk_proto/ChannelOpenRequestMessage.pb.h>
+#include <aasdk_proto/AVChannelSetupRequestMessage.pb.h>
+#include <aasdk_proto/AVChannelStartIndicationMessage.pb.h>
+#include <aasdk_proto/BindingRequestMessage.pb.h>
+#include <f1x/aasdk/Messenger/MessageId.hpp>
+#include <f1x/aasdk/Messenger/Timestamp.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/replay/SyntheticMessageSource.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+constexpr uint64_t SyntheticMessageSource::cAudioChunkDuration;
+
+SyntheticMessageSource::SyntheticMessageSource(const Options& options)
+    : options_(options)
+    , videoFrames_(loadVideoSample())
+    , pcm_(createPCM(cAudioChunkDuration))
+    , frameIndex_(0)
+    , videoTimestamp_(videoFrames_.empty() ? std::numeric_limits<uint64_t>::max() : 0)
+    , audioTimestamp_(options.audio ? 0 : std::numeric_limits<uint64_t>::max())
+{
+    this->addChannelOpenRequest(aasdk::messenger::ChannelId::VIDEO);
+    this->addAVChannelSetup(aasdk::messenger::ChannelId::VIDEO);
+
+    if(options_.audio)
+    {
+        this->addChannelOpenRequest(aasdk::messenger::ChannelId::MEDIA_AUDIO);
+        this->addAVChannelSetup(aasdk::messenger::ChannelId::MEDIA_AUDIO);
+    }
+
+    if(options_.input)
+    {
+        this->addChannelOpenRequest(aasdk::messenger::ChannelId::INPUT);
+        this->addBindingRequest();
+    }
+}
+
+bool SyntheticMessageSource::next(ReplayMessage& message)
+{
+    if(!setup_.empty())
+    {
+        message.timestamp = 0;
+        message.message = std::move(setup_.front());
+        setup_.pop_front();
+        return true;
+    }
+
+    if(videoTimestamp_ > options_.duration && audioTimestamp_ > options_.duration)
+    {
+        return false;
+    }
+
+    if(videoTimestamp_ <= audioTimestamp_)
+    {
+        const auto& frame = videoFrames_[frameIndex_ % videoFrames_.size()];
+        message.timestamp = videoTimestamp_;
+        message.message = this->createMediaMessage(aasdk::messenger::ChannelId::VIDEO, videoTimestamp_, frame);
+
+        ++frameIndex_;
+        videoTimestamp_ = frameIndex_ * 1000000 / options_.videoFPS;
+    }
+    else
+    {
+        message.timestamp = audioTimestamp_;
+        message.message = this->createMediaMessage(aasdk::messenger::ChannelId::MEDIA_AUDIO, audioTimestamp_, pcm_);
+        audioTimestamp_ += cAudioChunkDuration;
+    }
+
+    return true;
+}
+
+void SyntheticMessageSource::addChannelOpenRequest(aasdk::messenger::ChannelId channelId)
+{
+    aasdk::proto::messages::ChannelOpenRequest request;
+    request.set_priority(0);
+    request.set_channel_id(static_cast<uint32_t>(channelId));
+
+    auto message(std::make_shared<aasdk::messenger::Message>(channelId, aasdk::messenger::EncryptionType::ENCRYPTED, aasdk::messenger::MessageType::CONTROL));
+    message->insertPayload(aasdk::messenger::MessageId(aasdk::proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST).getData());
+    message->insertPayload(request);
+    setup_.push_back(std::move(message));
+}
+
+void SyntheticMessageSource::addAVChannelSetup(aasdk::messenger::ChannelId channelId)
+{
+    aasdk::proto::messages::AVChannelSetupRequest request;
+    request.set_config_index(0);
+
+    auto setupMessage(std::make_shared<aasdk::messenger::Message>(channelId, aasdk::messenger::EncryptionType::ENCRYPTED, aasdk::messenger::MessageType::SPECIFIC));
+    setupMessage->insertPayload(aasdk::messenger::MessageId(aasdk::proto::ids::AVChannelMessage::SETUP_REQUEST).getData());
+    setupMessage->insertPayload(request);
+    setup_.push_back(std::move(setupMessage));
+
+    aasdk::proto::messages::AVChannelStartIndication indication;
+    indication.set_session(0);
+    indication.set_config(0);
+
+    auto startMessage(std::make_shared<aasdk::messenger::Message>(channelId, aasdk::messenger::EncryptionType::ENCRYPTED, aasdk::messenger::MessageType::SPECIFIC));
+    startMessage->insertPayload(aasdk::messenger::MessageId(aasdk::proto::ids::AVChannelMessage::START_INDICATION).getData());
+    startMessage->insertPayload(indication);
+    setup_.push_back(std::move(startMessage));
+}
+
+void SyntheticMessageSource::addBindingRequest()
+{
+    aasdk::proto::messages::BindingRequest request;
+
+    auto message(std::make_shared<aasdk::messenger::Message>(aasdk::messenger::ChannelId::INPUT, aasdk::messenger::EncryptionType::ENCRYPTED, aasdk::messenger::MessageType::SPECIFIC));
+    message->insertPayload(aasdk::messenger::MessageId(aasdk::proto::ids::InputChannelMessage::BINDING_REQUEST).getData());
+    message->insertPayload(request);
+    setup_.push_back(std::move(message));
+}
+
+aasdk::messenger::Message::Pointer SyntheticMessageSource::createMediaMessage(aasdk::messenger::ChannelId channelId, uint64_t timestamp, const aasdk::common::Data& data) const
+{
+    auto message(std::make_shared<aasdk::messenger::Message>(channelId, aasdk::messenger::EncryptionType::ENCRYPTED, aasdk::messenger::MessageType::SPECIFIC));
+    message->insertPayload(aasdk::messenger::MessageId(aasdk::proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION).getData());
+    message->insertPayload(aasdk::messenger::Timestamp(timestamp).getData());
+    message->insertPayload(data);
+    return message;
+}
+
+std::vector<aasdk::common::Data> SyntheticMessageSource::loadVideoSample()
+{
+    std::vector<aasdk::common::Data> frames;
+
+    QFile file(":/replay/synthetic.h264");
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        OPENAUTO_LOG(error) << "[SyntheticMessageSource] unable to open the video sample, no video is sent.";
+        return frames;
+    }
+
+    const auto sample = file.readAll();
+    const auto* data = reinterpret_cast<const uint8_t*>(sample.constData());
+    const size_t size = static_cast<size_t>(sample.size());
+
+    // NAL units by the offset of their start code, 00 00 01 or 00 00 00 01
+    std::vector<size_t> units;
+    for(size_t i = 0; i + 3 < size; ++i)
+    {
+        if(data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1)
+        {
+            units.push_back(i > 0 && data[i - 1] == 0 ? i - 1 : i);
+            i += 2;
+        }
+    }
+    units.push_back(size);
+
+    // the phone sends one access unit per message: parameter sets and SEI go out together with
+    // the slice that follows them, and every slice ends a frame (the sample has one per picture)
+    size_t frameStart = units.front();
+    for(size_t i = 0; i + 1 < units.size(); ++i)
+    {
+        const auto header = units[i] + (data[units[i] + 2] == 1 ? 3 : 4);
+        const auto nalType = data[header] & 0x1f;
+
+        if(nalType == 1 || nalType == 5)
+        {
+            frames.emplace_back(data + frameStart, data + units[i + 1]);
+            frameStart = units[i + 1];
+        }
+    }
+
+    OPENAUTO_LOG(info) << "[SyntheticMessageSource] video sample: " << frames.size() << " frames.";
+    return frames;
+}
+
+aasdk::common::Data SyntheticMessageSource::createPCM(uint64_t duration)
+{
+    const size_t frames = 48000 * duration / 1000000;
+    aasdk::common::Data pcm;
+    pcm.reserve(frames * 4);
+
+    for(size_t i = 0; i < frames; ++i)
+    {
+        const auto sample = static_cast<int16_t>(8000 * std::sin(2 * M_PI * 440 * i / 48000));
+        for(size_t channel = 0; channel < 2; ++channel)
+        {
+            pcm.push_back(static_cast<uint8_t>(sample & 0xff));
+            pcm.push_back(static_cast<uint8_t>((sample >> 8) & 0xff));
+        }
+    }
+
+    return pcm;
+}
+
+}
+}
+}
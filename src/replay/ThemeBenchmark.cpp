@@ -0,0 +1,100 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+#include <QAbstractButton>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <f1x/openauto/autoapp/UI/MainWindow.hpp>
+#include <f1x/openauto/autoapp/UI/ThemeEngine.hpp>
+#include <f1x/openauto/replay/ThemeBenchmark.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+ThemeBenchmark::ThemeBenchmark(autoapp::configuration::IConfiguration::Pointer configuration, size_t count)
+    : configuration_(std::move(configuration))
+    , count_(std::max<size_t>(count, 2))
+{
+
+}
+
+void ThemeBenchmark::run(std::ostream& stream)
+{
+    autoapp::ui::MainWindow window(configuration_);
+    window.show();
+    QCoreApplication::processEvents();
+
+    auto dayButton = window.findChild<QAbstractButton*>("pushButtonDay");
+    auto nightButton = window.findChild<QAbstractButton*>("pushButtonNight");
+    if(dayButton == nullptr || nightButton == nullptr)
+    {
+        stream << "theme benchmark: day/night buttons not found" << std::endl;
+        return;
+    }
+
+    this->measure(stream, "switch", window, [&](bool night) {
+        (night ? nightButton : dayButton)->click();
+    });
+
+    // two alphas, an identical stylesheet would not be parsed and polished again
+    autoapp::ui::ThemeEngine themeEngine;
+    const int alpha = static_cast<int>(configuration_->getAlphaTrans());
+    const QString dayStyleSheet = themeEngine.getStyleSheet(alpha);
+    const QString nightStyleSheet = themeEngine.getStyleSheet(alpha == 100 ? 99 : alpha + 1);
+
+    this->measure(stream, "restyle", window, [&](bool night) {
+        window.setStyleSheet(night ? nightStyleSheet : dayStyleSheet);
+    });
+}
+
+void ThemeBenchmark::measure(std::ostream& stream, const std::string& name, QWidget& window, const std::function<void(bool)>& apply)
+{
+    std::vector<qint64> durations;
+    durations.reserve(count_);
+
+    for(size_t i = 0; i < count_; ++i)
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        apply(i % 2 == 0);
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::LayoutRequest);
+        window.repaint();
+
+        durations.push_back(timer.nsecsElapsed());
+    }
+
+    std::sort(durations.begin(), durations.end());
+    const auto at = [&durations](double fraction) {
+        return durations[std::min(durations.size() - 1, static_cast<size_t>(fraction * durations.size()))] / 1000.0;
+    };
+
+    stream << std::fixed << std::setprecision(1)
+           << name << ": p50 " << at(0.5) << " us, p99 " << at(0.99) << " us, max " << durations.back() / 1000.0 << " us over " << durations.size() << " switches" << std::endl;
+}
+
+}
+}
+}
@@ -0,0 +1,113 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QApplication>
+#include <QMouseEvent>
+#include <f1x/openauto/replay/TouchGenerator.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+constexpr int TouchGenerator::cSwipeSteps;
+
+TouchGenerator::TouchGenerator(const QRect& geometry, int rate, UinputTouchscreen* touchscreen)
+    : geometry_(geometry)
+    , rate_(rate)
+    , step_(0)
+    , touchscreen_(touchscreen)
+{
+    timer_.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&timer_, &QTimer::timeout, [this]() { this->step(); });
+}
+
+void TouchGenerator::start()
+{
+    step_ = 0;
+    timer_.start(1000 / rate_);
+}
+
+void TouchGenerator::stop()
+{
+    timer_.stop();
+}
+
+QObject* TouchGenerator::getSurface() const
+{
+    // InputDevice listens on the full screen video widget only
+    for(auto widget : QApplication::topLevelWidgets())
+    {
+        if(widget->isVisible())
+        {
+            return widget;
+        }
+    }
+
+    return QApplication::instance();
+}
+
+void TouchGenerator::step()
+{
+    const int x = geometry_.left() + geometry_.width() / 10 + (geometry_.width() * 8 / 10) * step_ / cSwipeSteps;
+    const QPoint position(x, geometry_.center().y());
+
+    if(touchscreen_ != nullptr)
+    {
+        if(step_ == 0)
+        {
+            touchscreen_->press(position.x(), position.y());
+        }
+        else if(step_ == cSwipeSteps)
+        {
+            touchscreen_->release();
+        }
+        else
+        {
+            touchscreen_->move(position.x(), position.y());
+        }
+
+        step_ = (step_ + 1) % (cSwipeSteps + 1);
+        return;
+    }
+
+    QEvent::Type type = QEvent::MouseMove;
+    Qt::MouseButton button = Qt::NoButton;
+    Qt::MouseButtons buttons = Qt::LeftButton;
+
+    if(step_ == 0)
+    {
+        type = QEvent::MouseButtonPress;
+        button = Qt::LeftButton;
+    }
+    else if(step_ == cSwipeSteps)
+    {
+        type = QEvent::MouseButtonRelease;
+        button = Qt::LeftButton;
+        buttons = Qt::NoButton;
+    }
+
+    QCoreApplication::postEvent(this->getSurface(), new QMouseEvent(type, position, button, buttons, Qt::NoModifier));
+    step_ = (step_ + 1) % (cSwipeSteps + 1);
+}
+
+}
+}
+}
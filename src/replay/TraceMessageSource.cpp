@@ -0,0 +1,61 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/replay/TraceMessageSource.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+TraceMessageSource::TraceMessageSource(std::string fileName)
+    : reader_(std::move(fileName))
+{
+
+}
+
+bool TraceMessageSource::open()
+{
+    return reader_.open();
+}
+
+bool TraceMessageSource::next(ReplayMessage& message)
+{
+    while(reader_.read(record_))
+    {
+        if(record_.direction != autoapp::trace::Direction::INBOUND)
+        {
+            continue;
+        }
+
+        message.timestamp = record_.timestamp;
+        message.message = std::make_shared<aasdk::messenger::Message>(static_cast<aasdk::messenger::ChannelId>(record_.channelId),
+                                                                      static_cast<aasdk::messenger::EncryptionType>(record_.encryptionType),
+                                                                      static_cast<aasdk::messenger::MessageType>(record_.messageType));
+        message.message->insertPayload(record_.payload);
+        return true;
+    }
+
+    return false;
+}
+
+}
+}
+}
@@ -0,0 +1,169 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/ioctl.h>
+#include <linux/uinput.h>
+#include <cerrno>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/replay/UinputTouchscreen.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace replay
+{
+
+UinputTouchscreen::UinputTouchscreen()
+    : fd_(-1)
+{
+
+}
+
+UinputTouchscreen::~UinputTouchscreen()
+{
+    if(fd_ >= 0)
+    {
+        ioctl(fd_, UI_DEV_DESTROY);
+        close(fd_);
+    }
+}
+
+bool UinputTouchscreen::create(int width, int height)
+{
+    fd_ = open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+    if(fd_ < 0)
+    {
+        OPENAUTO_LOG(error) << "[UinputTouchscreen] unable to open /dev/uinput: " << strerror(errno);
+        return false;
+    }
+
+    ioctl(fd_, UI_SET_EVBIT, EV_KEY);
+    ioctl(fd_, UI_SET_KEYBIT, BTN_TOUCH);
+    ioctl(fd_, UI_SET_EVBIT, EV_ABS);
+    ioctl(fd_, UI_SET_ABSBIT, ABS_X);
+    ioctl(fd_, UI_SET_ABSBIT, ABS_Y);
+    ioctl(fd_, UI_SET_PROPBIT, INPUT_PROP_DIRECT);
+
+    uinput_abs_setup absX{};
+    absX.code = ABS_X;
+    absX.absinfo.maximum = width - 1;
+    uinput_abs_setup absY{};
+    absY.code = ABS_Y;
+    absY.absinfo.maximum = height - 1;
+
+    uinput_setup setup{};
+    setup.id.bustype = BUS_VIRTUAL;
+    std::strncpy(setup.name, "openauto-replay touchscreen", UINPUT_MAX_NAME_SIZE - 1);
+
+    if(ioctl(fd_, UI_ABS_SETUP, &absX) < 0 || ioctl(fd_, UI_ABS_SETUP, &absY) < 0
+            || ioctl(fd_, UI_DEV_SETUP, &setup) < 0 || ioctl(fd_, UI_DEV_CREATE) < 0)
+    {
+        OPENAUTO_LOG(error) << "[UinputTouchscreen] unable to create the device: " << strerror(errno);
+        return false;
+    }
+
+    // udev creates the node asynchronously
+    for(int attempt = 0; attempt < 50 && devicePath_.empty(); ++attempt)
+    {
+        devicePath_ = this->findDevicePath();
+        if(devicePath_.empty() || access(devicePath_.c_str(), R_OK) != 0)
+        {
+            devicePath_.clear();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+
+    OPENAUTO_LOG(info) << "[UinputTouchscreen] created " << devicePath_;
+    return !devicePath_.empty();
+}
+
+std::string UinputTouchscreen::getDevicePath() const
+{
+    return devicePath_;
+}
+
+void UinputTouchscreen::press(int x, int y)
+{
+    this->write(EV_ABS, ABS_X, x);
+    this->write(EV_ABS, ABS_Y, y);
+    this->write(EV_KEY, BTN_TOUCH, 1);
+    this->write(EV_SYN, SYN_REPORT, 0);
+}
+
+void UinputTouchscreen::move(int x, int y)
+{
+    this->write(EV_ABS, ABS_X, x);
+    this->write(EV_ABS, ABS_Y, y);
+    this->write(EV_SYN, SYN_REPORT, 0);
+}
+
+void UinputTouchscreen::release()
+{
+    this->write(EV_KEY, BTN_TOUCH, 0);
+    this->write(EV_SYN, SYN_REPORT, 0);
+}
+
+void UinputTouchscreen::write(int type, int code, int value)
+{
+    input_event event{};
+    event.type = type;
+    event.code = code;
+    event.value = value;
+
+    if(::write(fd_, &event, sizeof(event)) != sizeof(event))
+    {
+        OPENAUTO_LOG(warning) << "[UinputTouchscreen] write failed: " << strerror(errno);
+    }
+}
+
+std::string UinputTouchscreen::findDevicePath() const
+{
+    char sysName[64] = {};
+    if(ioctl(fd_, UI_GET_SYSNAME(sizeof(sysName)), sysName) < 0)
+    {
+        return std::string();
+    }
+
+    std::string devicePath;
+    const std::string sysPath = std::string("/sys/devices/virtual/input/") + sysName;
+    if(DIR* directory = opendir(sysPath.c_str()))
+    {
+        while(dirent* entry = readdir(directory))
+        {
+            if(std::strncmp(entry->d_name, "event", 5) == 0)
+            {
+                devicePath = std::string("/dev/input/") + entry->d_name;
+                break;
+            }
+        }
+        closedir(directory);
+    }
+
+    return devicePath;
+}
+
+}
+}
+}
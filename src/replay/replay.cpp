@@ -0,0 +1,290 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <sys/resource.h>
+#include <QApplication>
+#include <QScreen>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Configuration/Configuration.hpp>
+#include <f1x/openauto/replay/AckBenchmark.hpp>
+#include <f1x/openauto/replay/AllocationCounter.hpp>
+#include <f1x/openauto/replay/DiscoveryBenchmark.hpp>
+#include <f1x/openauto/replay/ReplayStatistics.hpp>
+#include <f1x/openauto/replay/ReplayMessenger.hpp>
+#include <f1x/openauto/replay/ReplayServiceFactory.hpp>
+#include <f1x/openauto/replay/TraceMessageSource.hpp>
+#include <f1x/openauto/replay/SyntheticMessageSource.hpp>
+#include <f1x/openauto/replay/ThemeBenchmark.hpp>
+#include <f1x/openauto/replay/TouchGenerator.hpp>
+#include <f1x/openauto/replay/UinputTouchscreen.hpp>
+#include <f1x/openauto/replay/Player.hpp>
+
+namespace autoapp = f1x::openauto::autoapp;
+namespace replay = f1x::openauto::replay;
+
+namespace
+{
+
+struct Options
+{
+    std::string traceFile;
+    bool realtime = false;
+    double speed = 1.0;
+    int touchRate = 60;
+    bool uinput = false;
+    size_t ackBenchmark = 0;
+    size_t discoveryBenchmark = 0;
+    size_t themeBenchmark = 0;
+    replay::SyntheticMessageSource::Options synthetic;
+};
+
+void printUsage(const char* name)
+{
+    std::cout << "usage: " << name << " [options]" << std::endl
+              << "  --trace FILE          replay the inbound messages of a session trace" << std::endl
+              << "  --duration SECONDS    length of a synthetic session (default 30)" << std::endl
+              << "  --fps N               synthetic video frame rate (default 30)" << std::endl
+              << "  --no-audio            no synthetic media audio" << std::endl
+              << "  --touch-rate HZ       synthetic touch events per second, 0 disables (default 60)" << std::endl
+              << "  --uinput              send synthetic touches through a uinput device and the evdev backend" << std::endl
+              << "  --realtime            pace messages by their timestamps instead of as fast as possible" << std::endl
+              << "  --speed FACTOR        realtime playback speed (default 1.0)" << std::endl
+              << "  --ack-benchmark N     time N media ACKs through the channel and the pooled path, then exit" << std::endl
+              << "  --discovery-benchmark N" << std::endl
+              << "                        time N service discovery responses built on the stack and on an arena, then exit" << std::endl
+              << "  --theme-benchmark N   time N day/night switches of the main window and N whole window restyles, then exit" << std::endl;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string argument(argv[i]);
+        const bool hasValue = i + 1 < argc;
+
+        if(argument == "--trace" && hasValue)
+        {
+            options.traceFile = argv[++i];
+        }
+        else if(argument == "--duration" && hasValue)
+        {
+            options.synthetic.duration = std::stoull(argv[++i]) * 1000000;
+        }
+        else if(argument == "--fps" && hasValue)
+        {
+            options.synthetic.videoFPS = std::max(1, std::stoi(argv[++i]));
+        }
+        else if(argument == "--no-audio")
+        {
+            options.synthetic.audio = false;
+        }
+        else if(argument == "--touch-rate" && hasValue)
+        {
+            options.touchRate = std::max(0, std::stoi(argv[++i]));
+        }
+        else if(argument == "--uinput")
+        {
+            options.uinput = true;
+        }
+        else if(argument == "--realtime")
+        {
+            options.realtime = true;
+        }
+        else if(argument == "--speed" && hasValue)
+        {
+            options.speed = std::max(0.01, std::stod(argv[++i]));
+        }
+        else if(argument == "--ack-benchmark" && hasValue)
+        {
+            options.ackBenchmark = std::stoull(argv[++i]);
+        }
+        else if(argument == "--discovery-benchmark" && hasValue)
+        {
+            options.discoveryBenchmark = std::stoull(argv[++i]);
+        }
+        else if(argument == "--theme-benchmark" && hasValue)
+        {
+            options.themeBenchmark = std::stoull(argv[++i]);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    options.synthetic.input = options.touchRate > 0;
+    return true;
+}
+
+std::chrono::microseconds toMicroseconds(const timeval& time)
+{
+    return std::chrono::seconds(time.tv_sec) + std::chrono::microseconds(time.tv_usec);
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    try
+    {
+        if(!parseOptions(argc, argv, options))
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    catch(const std::exception&)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if(options.ackBenchmark > 0)
+    {
+        replay::AckBenchmark(options.ackBenchmark).run(std::cout);
+        return 0;
+    }
+
+    // no display is needed, video goes to an offscreen surface
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty())
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication qApplication(argc, argv);
+
+    replay::IMessageSource::Pointer source;
+    if(!options.traceFile.empty())
+    {
+        auto traceSource = std::make_shared<replay::TraceMessageSource>(options.traceFile);
+        if(!traceSource->open())
+        {
+            return 1;
+        }
+        source = std::move(traceSource);
+    }
+    else
+    {
+        source = std::make_shared<replay::SyntheticMessageSource>(options.synthetic);
+    }
+
+    auto configuration = std::make_shared<autoapp::configuration::Configuration>();
+
+    if(options.themeBenchmark > 0)
+    {
+        replay::ThemeBenchmark(configuration, options.themeBenchmark).run(std::cout);
+        return 0;
+    }
+
+    QScreen* screen = QGuiApplication::primaryScreen();
+    const QRect screenGeometry = screen == nullptr ? QRect(0, 0, 800, 480) : screen->geometry();
+
+    replay::UinputTouchscreen touchscreen;
+    if(options.uinput)
+    {
+        if(!touchscreen.create(screenGeometry.width(), screenGeometry.height()))
+        {
+            return 1;
+        }
+
+        configuration->setTouchscreenBackendType(autoapp::configuration::TouchscreenBackendType::EVDEV);
+        configuration->setTouchscreenDevice(touchscreen.getDevicePath());
+    }
+
+    boost::asio::io_service ioService;
+    boost::asio::io_service::work work(ioService);
+    std::vector<std::thread> threadPool;
+    for(size_t i = 0; i < 4; ++i)
+    {
+        threadPool.emplace_back([&ioService]() { ioService.run(); });
+    }
+
+    replay::ReplayStatistics statistics;
+    auto messenger = std::make_shared<replay::ReplayMessenger>(statistics);
+    replay::ReplayServiceFactory serviceFactory(ioService, configuration);
+    autoapp::service::ServiceList serviceList;
+
+    replay::TouchGenerator touchGenerator(screenGeometry, std::max(1, options.touchRate), options.uinput ? &touchscreen : nullptr);
+    if(options.traceFile.empty() && options.touchRate > 0 && options.discoveryBenchmark == 0)
+    {
+        touchGenerator.start();
+    }
+
+    rusage usageStart;
+    getrusage(RUSAGE_SELF, &usageStart);
+    const auto wallStart = std::chrono::steady_clock::now();
+    const auto allocationsStart = replay::AllocationCounter::get();
+
+    // services block on the GUI thread while they are built, so create them from a worker
+    ioService.post([&]() {
+        serviceList = serviceFactory.create(messenger);
+
+        if(options.discoveryBenchmark > 0)
+        {
+            // fillFeatures() needs the services built, not started
+            replay::DiscoveryBenchmark(configuration, serviceList, options.discoveryBenchmark).run(std::cout);
+            QMetaObject::invokeMethod(&qApplication, "quit", Qt::QueuedConnection);
+            return;
+        }
+
+        for(auto& service : serviceList)
+        {
+            service->start();
+        }
+
+        auto player = std::make_shared<replay::Player>(ioService, messenger, source, statistics, options.realtime, options.speed);
+        player->start([&qApplication]() {
+            QMetaObject::invokeMethod(&qApplication, "quit", Qt::QueuedConnection);
+        });
+    });
+
+    qApplication.exec();
+
+    const auto wallEnd = std::chrono::steady_clock::now();
+    const auto allocationsEnd = replay::AllocationCounter::get();
+    rusage usageEnd;
+    getrusage(RUSAGE_SELF, &usageEnd);
+
+    touchGenerator.stop();
+    for(auto& service : serviceList)
+    {
+        service->stop();
+    }
+    messenger->stop();
+
+    ioService.stop();
+    std::for_each(threadPool.begin(), threadPool.end(), std::bind(&std::thread::join, std::placeholders::_1));
+
+    replay::ReplayStatistics::Usage usage;
+    usage.wall = std::chrono::duration_cast<std::chrono::microseconds>(wallEnd - wallStart);
+    usage.user = toMicroseconds(usageEnd.ru_utime) - toMicroseconds(usageStart.ru_utime);
+    usage.system = toMicroseconds(usageEnd.ru_stime) - toMicroseconds(usageStart.ru_stime);
+    usage.allocations = allocationsEnd - allocationsStart;
+
+    if(options.discoveryBenchmark == 0)
+    {
+        statistics.report(std::cout, usage);
+    }
+
+    return 0;
+}